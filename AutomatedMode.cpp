@@ -36,9 +36,9 @@
       Sets the time window (in seconds) between each dome movement.
       R2 pauses for a random duration before executing the next action.
 
-  - `GEAR_RATIO`:
-      Converts dome angle in degrees to motor rotation for gear-driven domes.
-      Adjust this if your dome gearing is different from the default.
+  - `DOME_GEAR_RATIO` / `DOME_ENCODER_CPR` (DomePosition.h):
+      Convert dome degrees into encoder counts. Moves are closed-loop
+      on the encoder, so set these to match your gearing and encoder.
 
   -- MP3 PLAYBACK --
   - `mp3MinIntervalSec` / `mp3MaxIntervalSec`:
@@ -55,10 +55,9 @@
 
   DEBUGGING:
   ────────────────────────────────────────────────────────────────────
-  Serial Monitor will output:
-    - Dome angle, speed, and direction for each movement
-    - Dome "Return to Center" notices
-    - MP3 track, category, and suppression messages
+  Serial Monitor will output (levels in DebugLog.h):
+    - Kill switch and sweep done notices            (LOG_INFO)
+    - Dome angle → target every 250 ms while moving (DOME at LOG_DEBUG)
 
   FILE LOCATION:
   ────────────────────────────────────────────────────────────────────
@@ -70,50 +69,31 @@
 */
 
 #include "AutomatedMode.h"
+#include "ComboHandler.h"
+#include "PWMInputHandler.h"
 #include <Arduino.h>
-#include <Sabertooth.h>
-
-// === FUNCTION DECLARATIONS ===
-static void updateEncoder();
+#include "MotorBus.h"
+#include "DomePosition.h"
+#include "DebugLog.h"
 
 // ==========================
-//     Motor + Encoder Setup
+//     Dome Test Sweep
 // ==========================
-static Sabertooth domeMotor(129, Serial2);
-const int encoderPinA = 19;
-const int encoderPinB = 20;
-
-volatile long encoderTicks = 0;
-static bool lastA = 0;
-static bool lastB = 0;
+static const int sweepAngleDeg = 90;   // Out to here, then back home
+static const int sweepPower    = 30;
 
-unsigned long motorStartTime = 0;
-unsigned long lastMotorSend = 0;
-bool motorRunning = true;
+enum SweepStep { SWEEP_OUT = 0, SWEEP_HOME, SWEEP_DONE };
+static uint8_t sweepStep = SWEEP_DONE;
 
 // ==========================
 //        Setup
 // ==========================
 void setupAutomatedMode() {
-  Serial.begin(115200);
-  Serial.println("🔥🔥 IF YOU SEE THIS, YOU ARE RUNNING THE RIGHT VERSION 🔥🔥");
-
-  pinMode(encoderPinA, INPUT_PULLUP);
-  pinMode(encoderPinB, INPUT_PULLUP);
-  lastA = digitalRead(encoderPinA);
-  lastB = digitalRead(encoderPinB);
-  attachInterrupt(digitalPinToInterrupt(encoderPinA), updateEncoder, CHANGE);
-  attachInterrupt(digitalPinToInterrupt(encoderPinB), updateEncoder, CHANGE);
-
-  encoderTicks = 0;
+  LOG_LINE(MODE, LOG_DEBUG, "[AUTO] Dome test sweep.");
 
-  Serial2.begin(9600);
-  delay(1000);
-  Serial2.write(0xAA);
-  delay(100);
-
-  motorStartTime = millis();
-  motorRunning = true;
+  // Encoder + position loop are owned by setupDomePosition()
+  moveDomeTo(sweepAngleDeg, sweepPower);
+  sweepStep = SWEEP_OUT;
 }
 
 // ==========================
@@ -122,39 +102,31 @@ void setupAutomatedMode() {
 void loopAutomatedMode() {
   unsigned long now = millis();
 
-  if (motorRunning) {
-    if (now - motorStartTime < 2000) {
-      if (now - lastMotorSend > 50) {
-        domeMotor.motor(30);
-        lastMotorSend = now;
-      }
+  // === Kill Switch (Combo Mode 2) ===
+  if (isComboModeActive(2) && sweepStep != SWEEP_DONE) {
+    stopDome();
+    sweepStep = SWEEP_DONE;
+    LOG_LINE(MODE, LOG_INFO, "[KILL SWITCH ACTIVE] Dome stopped.");
+  }
+
+  updateDomePosition();
+
+  if (sweepStep != SWEEP_DONE && !isDomeMoving()) {
+    if (sweepStep == SWEEP_OUT && getDomeFault() == DOME_FAULT_NONE) {
+      moveDomeTo(0, sweepPower);
+      sweepStep = SWEEP_HOME;
     } else {
-      domeMotor.motor(0);
-      motorRunning = false;
-      Serial.println("Motor OFF");
+      sweepStep = SWEEP_DONE;
+      LOG_LINE(DOME, LOG_INFO, "Motor OFF");
     }
   }
 
   static unsigned long lastPrint = 0;
-  if (now - lastPrint > 250) {
+  if (LOG_ENABLED(DOME, LOG_DEBUG) && isDomeMoving() && now - lastPrint > 250) {
     lastPrint = now;
-    Serial.print("Ticks: ");
-    Serial.println(encoderTicks);
+    usbLog.print(F("Dome: "));
+    usbLog.print(getDomeAngle());
+    usbLog.print(F("° → "));
+    usbLog.println(getDomeTargetAngle());
   }
 }
-
-// ==========================
-//        ISR
-// ==========================
-void updateEncoder() {
-  bool currentA = digitalRead(encoderPinA);
-  bool currentB = digitalRead(encoderPinB);
-
-  if (lastA != currentA || lastB != currentB) {
-    if (lastA == currentB) encoderTicks++;
-    else encoderTicks--;
-  }
-
-  lastA = currentA;
-  lastB = currentB;
-}
@@ -14,6 +14,9 @@
   - Dome motion via Controller B joystick (CH1B)
   - Exponential curve shaping for analog feel with boosted torque
   - Increased drive speed (customizable) for terrain resistance
+  - Traction control: backs drive power and ramping off as the 2x32's
+    motor current nears its limit or the battery sags (needs
+    `MOTOR_FEEDBACK_POLL_MS`, MotorBus.h)
   - Kill switch (Combo Mode 4) halts motion immediately
 
   TUNABLE PARAMETERS:
@@ -49,9 +52,32 @@
       Scales dome output to increase responsiveness. Set to 1 for direct control,
       or increase if dome feels slow due to friction.
 
-  - `domeAccelerationRate` / `domeDecelerationRate`:
-      These are not actively used in this mode, but available for optional
-      smoothing logic if you later decide to add ramp behavior.
+  -- Traction Control (2x32 S2 wired to RX2) --
+  Each new current reading from the 2x32 steps a scale on drive + turn
+  output (`driveGovernor`, DriveController.h) and picks how fast the
+  output may ramp up. Without fresh readings it runs exactly as before.
+
+  - `tractionCurrentLimit`:
+      Motor current (0.1 A) to stay under. Above it the scale drops by
+      `tractionBackoffPerAmp` for every amp over. Keep it below the
+      current limit set in DEScribe so the driver never has to step in.
+
+  - `tractionRecoverStep`:
+      Scale regained per reading (~120 ms) while under the limit.
+
+  - `tractionMinScale`:
+      Lowest the scale may go (0.5 = half of `speedLimit`).
+
+  - `tractionMaxSagDv`:
+      Battery drop (0.1 V) below its resting voltage that counts as
+      sagging: no recovery, and the scale backs off one step.
+
+  - `tractionMaxTempC`:
+      Output stage temperature that pins the scale at the minimum.
+
+  - `tractionRampFast` / `tractionRampSlow`:
+      Largest output increase per tick at half the current limit and
+      at the limit. Slowing down is never limited.
 
   -- Safety Timeout --
   - `motorTimeoutMs`:
@@ -60,15 +86,18 @@
 
   DEBUGGING:
   ────────────────────────────────────────────────────────────────────
-  If `DEBUG_MODE` is set to true:
-    - Serial monitor will print:
-        - Raw and final values for drive, turn, and dome motion
-        - Real-time behavior inspection
+  Raw and final values for drive, turn and dome motion stream as
+  binary telemetry (see `Telemetry.h`; decode with
+  Tools/telemetry_decode.py).
+  Kill switch changes also print as text (LOG_LEVEL_DRIVE, DebugLog.h).
+  Battery, motor currents, temperatures and the traction scale / ramp
+  stream as TELEMETRY_DRIVER frames while feedback is on.
 
   FILE LOCATION:
   ────────────────────────────────────────────────────────────────────
   This file: `CarpetMode.cpp`
   Header:    `CarpetMode.h`
+  Pipeline:  `DriveController.cpp` (this file only builds the profile)
 
   May the Force be with you, Builder.
   ╚═══════════════════════════════════════════════════════════════════╝
@@ -76,18 +105,14 @@
 
 
 #include "CarpetMode.h"
-#include "MP3Handler.h"
-#include "ComboHandler.h"
 #include <Arduino.h>
-#include "PWMInputHandler.h"
-#include <Sabertooth.h>
+#include "DriveController.h"
+#include "MotorBus.h"
 
 // ==========================
 //       TUNABLE SETTINGS
 // ==========================
 
-#define DEBUG_MODE false  // Set to true to enable Serial debugging
-
 // --- Drive Behavior ---
 static float expoCurve        = 1.3;   // Shapes input curve (1 = linear, higher = smoother feel)
 static int   speedLimit       = 50;    // Max drive/turn speed (0–127)
@@ -98,12 +123,10 @@ static int   taperFallRate    = 45;    // How quickly turn speed fades when joys
 
 // --- Dome Control ---
 static int   domeDeadZone          = 0;     // Ignores minor dome input noise near center
-static int   domeAccelerationRate  = 2;     // Placeholder for dome acceleration ramping (not used)
-static int   domeDecelerationRate  = 3;     // Placeholder for dome deceleration ramping (not used)
 static int   fineControlMultiplier = 2;     // Boosts dome speed when joystick input is strong
 static int   domeSpeedLimit        = 100;   // Max allowed dome speed (0–100)
-static float domeLeftGain          = 1.00;  // Adjusts dome speed to the left (compensation)
-static float domeRightGain         = 1.00;  // Adjusts dome speed to the right (compensation)
+static q8_8_t domeLeftGain         = Q8_8(1.00);  // Adjusts dome speed to the left (compensation)
+static q8_8_t domeRightGain        = Q8_8(1.00);  // Adjusts dome speed to the right (compensation)
 
 // --- Flick Sensitivity ---
 static const unsigned long domeFlickMinDuration = 40;  // Minimum flick time in ms to count as valid
@@ -113,187 +136,94 @@ static const int maxFlickSpeed = 20;                   // Max dome speed allowed
 // --- Safety Timeout ---
 static const unsigned long motorTimeoutMs = 50;        // Stop motors if no input for this duration (ms)
 
+// --- Traction Control (MOTOR_FEEDBACK_POLL_MS > 0) ---
+static const int    tractionCurrentLimit  = 250;          // 0.1 A: back off above 25.0 A per motor
+static const q8_8_t tractionBackoffPerAmp = Q8_8(0.02);   // Scale lost per amp over the limit
+static const q8_8_t tractionRecoverStep   = Q8_8(0.04);   // Scale regained per reading under it
+static const q8_8_t tractionMinScale      = Q8_8(0.50);   // Never below half of speedLimit
+static const int    tractionMaxSagDv      = 15;           // 0.1 V under resting = sagging
+static const int    tractionRestCurrent   = 20;           // 0.1 A: battery reads "resting" below this
+static const int    tractionMaxTempC      = 70;           // Hotter = minimum scale
+static const int    tractionRampFast      = 10;           // Output step per tick, current at half the limit...
+static const int    tractionRampSlow      = 1;            // ...and at the limit
 
-// ==========================
-//       INTERNAL STATE
-// ==========================
-static int domeInput = 0;
-static int currentDomeSpeed = 0;
-static int lastSentDomeSpeed = 0;
-
-static int lastDrive = 0;
-static int lastTurn  = 0;
-static int savedTurnSpeed = 0;
-
-static unsigned long previousDomeMillis = 0;
-static unsigned long lastDriveCommandTime = 0;
-static unsigned long lastTurnCommandTime  = 0;
-
-static unsigned long domeStartTime = 0;
-static bool domeFlickActive = false;
-
-static bool wasTurnInputActive = false;
-static bool lastKillState = false;
 
 // ==========================
-//     Sabertooth Setup
+//       DRIVE PROFILE
 // ==========================
-static Sabertooth ST(128, Serial2);
-static Sabertooth domeMotor(129, Serial2);
+// Built once at boot; `tune` (TuningStore.cpp) rebuilds them live
+static ResponseCurve driveCurve(expoCurve, speedLimit);      // Drive + turn
+static ResponseCurve domeCurve(expoCurve, domeSpeedLimit);
+
+// Not static: TuningStore.cpp saves and loads it
+DriveProfile carpetProfile = {
+  "Carpet",
+  &driveCurve, deadZone,
+  40, 100,                                       // |drive| > 40 caps turn at ±100
+  false, taperFallRate, fxMapRange(0, speedLimit, 5, taperFallRate),
+  motorTimeoutMs,
+  1,                                             // Kill switch combo
+  &domeCurve, domeDeadZone, fineControlMultiplier, domeLeftGain, domeRightGain,
+  domeFlickMinDuration, domeFlickThreshold, maxFlickSpeed
+};
+
+// Current → ramp step, built once
+static const FxMap tractionRampMap = fxMapRange(tractionCurrentLimit / 2, tractionCurrentLimit,
+                                                tractionRampFast, tractionRampSlow);
 
 // ==========================
-//    HELPER DECLARATIONS
+//     TRACTION CONTROL
 // ==========================
-static int applyExpoCurve(int input, float curve, int limit = speedLimit);
-static int taperToZero(int value);
+static q8_8_t   tractionScale = Q8_8_ONE;
+static uint16_t lastCurrentSample = 0;
+static int      restingBatteryDv = 0;
+
+// One step per new current reading; the governor holds the result between them
+static void updateTractionControl() {
+  if (MOTOR_FEEDBACK_POLL_MS == 0) return;
+
+  if (!isDriveCurrentFresh()) {               // No feedback: plain Carpet Mode
+    tractionScale = Q8_8_ONE;
+    setDriveGovernor(Q8_8_ONE, 0);
+    return;
+  }
+  if (driveFeedback.currentSamples == lastCurrentSample) return;
+  lastCurrentSample = driveFeedback.currentSamples;
+
+  int current = driveCurrentPeak();
+  int battery = driveFeedback.batteryDv;
+  if (battery && current < tractionRestCurrent) restingBatteryDv = battery;
+  bool sagging = battery && restingBatteryDv && restingBatteryDv - battery > tractionMaxSagDv;
+
+  int scale = tractionScale;
+  if (current > tractionCurrentLimit) {
+    scale -= (long)(current - tractionCurrentLimit) * tractionBackoffPerAmp / 10;
+  } else if (sagging) {
+    scale -= tractionRecoverStep;
+  } else {
+    scale += tractionRecoverStep;
+  }
+  int hottest = max(driveFeedback.temperatureC[0], driveFeedback.temperatureC[1]);
+  if (hottest >= tractionMaxTempC) scale = tractionMinScale;
+  tractionScale = constrain(scale, tractionMinScale, Q8_8_ONE);
+
+  setDriveGovernor(tractionScale, fxMap(tractionRampMap, current));
+}
 
 // ==========================
 //           SETUP
 // ==========================
 void setupCarpetMode() {
-  if (DEBUG_MODE) {
-    Serial.begin(115115);
-    Serial.println("=== Carpet Mode Initialized ===");
-  }
-
-  setupPWMInputs();
-  Serial2.begin(9600);
-  delay(100);
-  Serial2.write(0xAA);
-  delay(10);
+  selectDriveProfile(&carpetProfile);  // Serial2, inputs and curves are already up
+  tractionScale = Q8_8_ONE;            // The swap turned the governor off
+  lastCurrentSample = driveFeedback.currentSamples;
 }
 
 // ==========================
 //         MAIN LOOP
 // ==========================
 void loopCarpetMode() {
-  static unsigned long lastFrameMicros = 0;
-  const unsigned long frameIntervalMicros = 5000;
-
-  unsigned long nowMicros = micros();
-  if (nowMicros - lastFrameMicros < frameIntervalMicros) return;
-  lastFrameMicros = nowMicros;
-
-  unsigned long now = millis();
-
-  // === Read Inputs ===
-  int rawTurn  = getPWMValue_CH1A();
-  int rawDrive = getPWMValue_CH2A();
-  int rawDome  = getPWMValue_CH1B();
-
-  int mappedTurn  = map(constrain(rawTurn,  1000, 2000), 1000, 2000, -127, 127);
-  int mappedDrive = map(constrain(rawDrive, 1000, 2000), 1000, 2000, -127, 127);
-
-  int constrainedDome = constrain(rawDome, 1000, 2000);
-  if (constrainedDome >= 1500) {
-    domeInput = map(constrainedDome, 1500, 2000, 0, 100) * domeRightGain;
-  } else {
-    domeInput = map(constrainedDome, 1000, 1500, -100, 0) * domeLeftGain;
-  }
-
-  // === Apply Deadzones ===
-  if (abs(mappedDrive) <= deadZone) mappedDrive = 0;
-  if (abs(mappedTurn)  <= deadZone) mappedTurn  = 0;
-
-  if (abs(mappedDrive) > 40) mappedTurn = constrain(mappedTurn, -100, 100);
-  if (mappedDrive == 0 && mappedTurn != 0) lastTurn = constrain(lastTurn, -40, 40);
-
-  // === Exponential Curve ===
-  int rawCurvedDome = applyExpoCurve(domeInput, expoCurve, domeSpeedLimit);
-  int curvedDome = domeFlickActive ? rawCurvedDome : rawCurvedDome * fineControlMultiplier;
-
-  int curvedDrive = applyExpoCurve(mappedDrive, expoCurve);
-  int curvedTurn  = applyExpoCurve(mappedTurn,  expoCurve);
-
-  // === Drive / Turn Logic ===
-  lastDrive = curvedDrive;
-  lastDriveCommandTime = now;
-
-  if (mappedTurn == 0 && wasTurnInputActive) lastTurn = 0;
-  else if (mappedTurn == 0) lastTurn = 0;
-  else {
-    savedTurnSpeed = curvedTurn;
-    lastTurn = curvedTurn;
-    lastTurnCommandTime = now;
-  }
-
-  wasTurnInputActive = (mappedTurn != 0);
-
-  // === Kill Switch (Combo 1) ===
-  bool killActive = isComboModeActive(1);
-
-  if (killActive != lastKillState) {
-    if (killActive && DEBUG_MODE) Serial.println("[KILL SWITCH ACTIVE]");
-    else if (DEBUG_MODE)          Serial.println("[KILL SWITCH RELEASED]");
-    lastKillState = killActive;
-  }
-
-  if (killActive) {
-    lastDrive = 0;
-    lastTurn = 0;
-    curvedDome = 0;
-  }
-
-  // === Dome Logic (with Flick Control) ===
-  if (abs(domeInput) < domeDeadZone) {
-    currentDomeSpeed = 0;
-    if (domeFlickActive && (now - domeStartTime < domeFlickMinDuration)) {
-      int limitedFlick = constrain(lastSentDomeSpeed, -maxFlickSpeed, maxFlickSpeed);
-      currentDomeSpeed = limitedFlick;
-    } else {
-      domeFlickActive = false;
-    }
-  } else {
-    currentDomeSpeed = curvedDome;
-    if (abs(curvedDome) >= domeFlickThreshold) {
-      domeStartTime = now;
-      domeFlickActive = true;
-    }
-  }
-
-  // === Safety Timeout ===
-  if (now - lastDriveCommandTime > motorTimeoutMs) lastDrive = 0;
-  if (now - lastTurnCommandTime  > motorTimeoutMs) lastTurn  = 0;
-
-  // === Motor Outputs ===
-  ST.drive(lastDrive);
-  ST.turn(lastTurn);
-
-  if (currentDomeSpeed != lastSentDomeSpeed) {
-    domeMotor.motor(currentDomeSpeed);
-    previousDomeMillis = now;
-    lastSentDomeSpeed = currentDomeSpeed;
-  }
-
-  // === Debug Output ===
-  if (DEBUG_MODE) {
-    Serial.print("DriveRaw: "); Serial.print(mappedDrive);
-    Serial.print(" | DriveOut: "); Serial.print(lastDrive);
-    Serial.print(" || TurnRaw: "); Serial.print(mappedTurn);
-    Serial.print(" | TurnOut: "); Serial.print(lastTurn);
-    Serial.print(" || DomeRaw: "); Serial.print(domeInput);
-    Serial.print(" | DomeOut: "); Serial.println(currentDomeSpeed);
-  }
+  // Runs once per scheduler control tick (CONTROL_TICK_US)
+  updateTractionControl();  // Scale + ramp from the 2x32's newest current reading
+  updateDriveController();
 }
-
-// ==========================
-//     HELPER FUNCTIONS
-// ==========================
-
-static int applyExpoCurve(int input, float curve, int limit) {
-  float normalized = abs(input) / 127.0;
-  float curved = pow(normalized, curve) * limit;
-  return (input >= 0) ? (int)curved : -(int)curved;
-}
-
-static int taperToZero(int value) {
-  int taperRate = map(abs(value), 0, speedLimit, 5, taperFallRate);
-  if (value > 0) {
-    value -= taperRate;
-    if (value < 0) value = 0;
-  } else if (value < 0) {
-    value += taperRate;
-    if (value > 0) value = 0;
-  }
-  return value;
-}
\ No newline at end of file
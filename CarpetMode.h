@@ -16,7 +16,11 @@
 #ifndef CARPET_MODE_H
 #define CARPET_MODE_H
 
+#include "DriveController.h"
+
 void setupCarpetMode();
 void loopCarpetMode();
 
+extern DriveProfile carpetProfile;   // Live-tuned by `tune` (TuningStore.cpp)
+
 #endif
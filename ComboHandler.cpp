@@ -41,13 +41,26 @@
   - Combo-based kill switch support for each mode (1–4)
   - Combo timing is optimized for short PWM signal pulses (~1988 µs)
 
+  COMBO TABLE:
+  ─────────────────────────────────────────────────────────────────────
+  - Every combo is one row of `comboTable` (flash, PROGMEM): button,
+    stick zone, toggle / momentary, the modes it works in, and its
+    action: mode change, MarcDuino string (optionally turning the
+    button MP3s off / on), random track from an MP3 bank, or none.
+  - Each pass reads the eight buttons once into three bit masks
+    (flipped, pressed, released). If any bit is set, all 32 rows are
+    checked against them; a button event fires the first row whose
+    stick zone is held. Nothing else is looped over.
+  - State is one bit per button and one per momentary row, whatever
+    the table holds: adding a combo is filling in its row.
+  - The kill switch is a held stick zone, not a button edge: one
+    zone mask per mode in `killZones`.
+
   DEBUGGING:
   ─────────────────────────────────────────────────────────────────────
-  Serial monitor will show:
-    - Active combo number (1–32)
-    - Mode transitions via combo
-    - Combo kill switch activation per mode
-    - Edge detection feedback for combo timing issues
+  Serial monitor will show (LOG_LEVEL_COMBO, DebugLog.h):
+    - MarcDuino sequences and MP3 combos fired      (LOG_INFO)
+    - Active combo number (1–32) and mode changes   (LOG_DEBUG)
 
   ⚠️  WARNING: DO NOT EDIT UNLESS YOU KNOW WHAT YOU ARE DOING  ⚠️
   ─────────────────────────────────────────────────────────────────────
@@ -59,7 +72,7 @@
      • Lock you into the wrong operational mode
 
   Only edit this file if:
-     • You are adding new combo features AND
+     • You are adding or changing rows in `comboTable` OR
      • You fully understand the PWM reading system and combo mapping
 
   FILE LOCATION:
@@ -73,6 +86,11 @@
 */
 
 #include "ComboHandler.h"
+#include "LatencyTrace.h"
+#include "SerialTx.h"
+#include "DebugLog.h"
+#include "MP3Handler.h"     // playMP3Bank()
+#include "ReceiverHandler.h" // RC_SERIAL_PORT_NUMBER
 
 // --- External functions from MP3Handler ---
 void disableMP3Triggers();
@@ -82,17 +100,24 @@ void enableMP3Triggers();
 #define MARCDUINO_SETUP 2
 #define MARCDUINO_ENABLED     (MARCDUINO_SETUP > 0)
 #define MARCDUINO_USE_SERIAL3 (MARCDUINO_SETUP == 2)
+#define MARCDUINO_BAUD        9600
+#define MARCDUINO_TX_PORT     (MARCDUINO_USE_SERIAL3 ? TX_PORT_SERIAL3 : TX_PORT_SERIAL1)
+
+#if MARCDUINO_USE_SERIAL3 && RC_SERIAL_PORT_NUMBER == 3 && \
+    (RC_INPUT_BACKEND == RC_INPUT_IBUS || RC_INPUT_BACKEND == RC_INPUT_SBUS)
+#error "iBUS / SBUS owns Serial3's baud rate: set MARCDUINO_SETUP 1 (Serial1) or 0"
+#endif
 
 // ---------- Controller A ----------
-#define RECEIVER_A_CH1_PIN  2
-#define RECEIVER_A_CH2_PIN  3
+#define RECEIVER_A_CH1_PIN  CH1_PIN      // InputPins.h
+#define RECEIVER_A_CH2_PIN  CH2_PIN
 #define CH3_PIN             22
 #define CH4_PIN             24
 #define CH5_PIN             26
 #define CH6_PIN             28
 
 // ---------- Controller B ----------
-#define RECEIVER_B_CH1_PIN  21
+#define RECEIVER_B_CH1_PIN  CH1B_PIN
 #define CH2B_PIN            23
 #define RECEIVER_B_CH3_PIN  25
 #define RECEIVER_B_CH4_PIN  27
@@ -102,6 +127,7 @@ void enableMP3Triggers();
 // ---------- Thresholds ----------
 const int HIGH_THRESHOLD    = 1700;
 const int LOW_THRESHOLD     = 1300;
+const int MOMENTARY_PRESS   = 1900;
 const int COMBO_DOWN_MIN    = 900;
 const int COMBO_DOWN_MAX    = 1300;
 const int COMBO_UP_MIN      = 1700;
@@ -109,35 +135,123 @@ const int COMBO_UP_MAX      = 2100;
 const int COMBO_LEFT_MAX    = 1300;
 const int COMBO_RIGHT_MIN   = 1700;
 
-// ---------- State Tracking ----------
-int last_CH3 = -1, last_CH4 = -1, last_CH5 = -1;
-int last_CH3B = -1, last_CH4B = -1, last_CH5B = -1;
-
-bool hasTriggered_CH6_A_DOWN = false, hasTriggered_CH6_A_UP = false, hasTriggered_CH6_A_LEFT = false, hasTriggered_CH6_A_RIGHT = false;
-bool hasTriggered_CH6_B_DOWN = false, hasTriggered_CH6_B_UP = false, hasTriggered_CH6_B_LEFT = false, hasTriggered_CH6_B_RIGHT = false;
+// ---------- MarcDuino Strings (flash) ----------
+static const char cmdMidAwake[]   PROGMEM = ":SE01\r";
+static const char cmdFullAwake[]  PROGMEM = ":SE02\r";
+static const char cmdAwakePlus[]  PROGMEM = ":SE03\r";
+static const char cmdQuiet[]      PROGMEM = ":SE00\r";
+static const char cmdLeia[]       PROGMEM = ":SE10\r";
+static const char cmdScream[]     PROGMEM = ":SE06\r";
+
+static const char lblMidAwake[]   PROGMEM = "Mid Awake";
+static const char lblFullAwake[]  PROGMEM = "Full Awake";
+static const char lblAwakePlus[]  PROGMEM = "Awake+";
+static const char lblQuiet[]      PROGMEM = "Quiet";
+static const char lblLeia[]       PROGMEM = "Leia Message";
+static const char lblScream[]     PROGMEM = "Scream";
+
+// ---------- Combo Table ----------
+// Row N is combo N. A toggle row fires when its switch flips with the
+// stick zone held; a momentary row once per press. To add a combo, fill
+// in its row: no new state, no new code.
+#define ALL_MODES        COMBO_IN_ALL
+#define HYBRID_AUTO      (COMBO_IN_HYBRID | COMBO_IN_AUTOMATED)
+#define AUTO_ONLY        COMBO_IN_AUTOMATED
+
+static const ComboEntry comboTable[COMBO_COUNT] PROGMEM = {
+  // button    stick        type             modes        action                  arg             command        label
+  // --- Joystick down / up + Controller A buttons ---
+  { PWM_CH3A, STICK_DOWN,  COMBO_TOGGLE,    ALL_MODES,   COMBO_ACTION_MODE,      1,              NULL,          NULL },          //  1 Manual
+  { PWM_CH4A, STICK_DOWN,  COMBO_TOGGLE,    ALL_MODES,   COMBO_ACTION_MODE,      2,              NULL,          NULL },          //  2 Automated
+  { PWM_CH5A, STICK_DOWN,  COMBO_TOGGLE,    ALL_MODES,   COMBO_ACTION_MODE,      3,              NULL,          NULL },          //  3 Hybrid
+  { PWM_CH6A, STICK_DOWN,  COMBO_MOMENTARY, ALL_MODES,   COMBO_ACTION_MODE,      4,              NULL,          NULL },          //  4 Carpet
+  { PWM_CH3A, STICK_UP,    COMBO_TOGGLE,    ALL_MODES,   COMBO_ACTION_MARCDUINO, COMBO_MP3_OFF,  cmdAwakePlus,  lblAwakePlus },  //  5
+  { PWM_CH4A, STICK_UP,    COMBO_TOGGLE,    ALL_MODES,   COMBO_ACTION_MARCDUINO, COMBO_MP3_ON,   cmdQuiet,      lblQuiet },      //  6
+  { PWM_CH5A, STICK_UP,    COMBO_TOGGLE,    ALL_MODES,   COMBO_ACTION_MARCDUINO, COMBO_MP3_OFF,  cmdFullAwake,  lblFullAwake },  //  7
+  { PWM_CH6A, STICK_UP,    COMBO_MOMENTARY, ALL_MODES,   COMBO_ACTION_MARCDUINO, COMBO_MP3_OFF,  cmdMidAwake,   lblMidAwake },   //  8
+  // --- Joystick left / right + Controller A buttons ---
+  { PWM_CH3A, STICK_LEFT,  COMBO_TOGGLE,    HYBRID_AUTO, COMBO_ACTION_MARCDUINO, COMBO_MP3_KEEP, cmdLeia,       lblLeia },       //  9
+  { PWM_CH4A, STICK_LEFT,  COMBO_TOGGLE,    HYBRID_AUTO, COMBO_ACTION_MARCDUINO, COMBO_MP3_KEEP, cmdScream,     lblScream },     // 10
+  { PWM_CH5A, STICK_LEFT,  COMBO_TOGGLE,    HYBRID_AUTO, COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 11
+  { PWM_CH6A, STICK_LEFT,  COMBO_MOMENTARY, HYBRID_AUTO, COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 12
+  { PWM_CH3A, STICK_RIGHT, COMBO_TOGGLE,    HYBRID_AUTO, COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 13
+  { PWM_CH4A, STICK_RIGHT, COMBO_TOGGLE,    HYBRID_AUTO, COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 14
+  { PWM_CH5A, STICK_RIGHT, COMBO_TOGGLE,    HYBRID_AUTO, COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 15
+  { PWM_CH6A, STICK_RIGHT, COMBO_MOMENTARY, HYBRID_AUTO, COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 16
+  // --- Joystick down / up + Controller B buttons ---
+  { PWM_CH3B, STICK_DOWN,  COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 17
+  { PWM_CH4B, STICK_DOWN,  COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 18
+  { PWM_CH5B, STICK_DOWN,  COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 19
+  { PWM_CH6B, STICK_DOWN,  COMBO_MOMENTARY, AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 20
+  { PWM_CH3B, STICK_UP,    COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 21
+  { PWM_CH4B, STICK_UP,    COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 22
+  { PWM_CH5B, STICK_UP,    COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 23
+  { PWM_CH6B, STICK_UP,    COMBO_MOMENTARY, AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 24
+  // --- Joystick left / right + Controller B buttons ---
+  { PWM_CH3B, STICK_LEFT,  COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 25
+  { PWM_CH4B, STICK_LEFT,  COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 26
+  { PWM_CH5B, STICK_LEFT,  COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 27
+  { PWM_CH6B, STICK_LEFT,  COMBO_MOMENTARY, AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 28
+  { PWM_CH3B, STICK_RIGHT, COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 29
+  { PWM_CH4B, STICK_RIGHT, COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 30
+  { PWM_CH5B, STICK_RIGHT, COMBO_TOGGLE,    AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 31
+  { PWM_CH6B, STICK_RIGHT, COMBO_MOMENTARY, AUTO_ONLY,   COMBO_ACTION_NONE,      0,              NULL,          NULL },          // 32
+};
+
+// Kill switch: stick zones that hold the motors in each mode (index = mode)
+static const uint8_t killZones[5] PROGMEM = {
+  0,
+  STICK_B(STICK_DOWN | STICK_UP),                                   // 1 Manual
+  0xFF,                                                             // 2 Automated: either stick, any way
+  STICK_B(STICK_DOWN | STICK_UP),                                   // 3 Hybrid: B left / right steers the dome
+  STICK_B(STICK_DOWN | STICK_LEFT | STICK_RIGHT),                   // 4 Carpet
+};
+
+// The eight buttons, one bit each (bit = PWMChannel)
+static const uint8_t comboButtons[] = {
+  PWM_CH3A, PWM_CH4A, PWM_CH5A, PWM_CH6A, PWM_CH3B, PWM_CH4B, PWM_CH5B, PWM_CH6B
+};
+
+// ---------- Combo State ----------
+// Fixed size whatever the table holds: bit masks, not a flag per combo
+static uint16_t toggleHigh   = 0;     // Last switch position per button
+static uint16_t toggleSeen   = 0;     // ...read at least once
+static uint32_t comboLatched = 0;     // Momentary rows that fired and wait for a release
 
-// ---------- Combo Tracking ----------
 int currentCombo = 0;
 int currentMode = 1;
-int lastCombo = 0;
 int lastMode = 0;
 unsigned long comboTimestamp = 0;
 const unsigned long comboResetDelay = 1000;
+static uint8_t comboChannel = PWM_CHANNEL_COUNT;  // Button that fired currentCombo (latency trace)
 
 // ---------- MarcDuino Trigger ----------
-void triggerMarcDuinoSequence(const char* command, int combo, const char* label) {
+static void triggerMarcDuinoSequence(const char* command, int combo, const char* label) {
 #if MARCDUINO_ENABLED
-  if (MARCDUINO_USE_SERIAL3) Serial3.print(command);
-  else Serial1.print(command);
+  char text[COMBO_COMMAND_MAX + 1];
+  strncpy_P(text, command, sizeof(text) - 1);
+  text[sizeof(text) - 1] = '\0';
+
+  // Queued whole if Serial3 is busy; an unsent repeat is coalesced
+  if (txSend(MARCDUINO_TX_PORT, text, TX_CLASS_SHOW)) {
+    traceOutputLatency(LATENCY_BUTTON_TO_MARCDUINO, comboChannel);
+  }
+#else
+  (void)command;                    // No MarcDuino: only the log line below
 #endif
-  Serial.print(">> MarcDuino Trigger: ");
-  Serial.print(label);
-  Serial.print(" | Combo ");
-  Serial.println(combo);
+  if (LOG_ENABLED(COMBO, LOG_INFO)) {
+    usbLog.print(F(">> MarcDuino Trigger: "));
+    usbLog.print((const __FlashStringHelper*)label);
+    usbLog.print(F(" | Combo "));
+    usbLog.println(combo);
+  }
 }
 
 // ---------- Setup ----------
 void setupComboHandler() {
+#if MARCDUINO_USE_SERIAL3
+  Serial3.begin(MARCDUINO_BAUD);
+#endif
   pinMode(RECEIVER_A_CH1_PIN, INPUT);
   pinMode(RECEIVER_A_CH2_PIN, INPUT);
   pinMode(CH3_PIN, INPUT);
@@ -151,177 +265,136 @@ void setupComboHandler() {
   pinMode(RECEIVER_B_CH4_PIN, INPUT);
   pinMode(RECEIVER_B_CH5_PIN, INPUT);
   pinMode(RECEIVER_B_CH6_PIN, INPUT);
+
+  toggleHigh = toggleSeen = 0;
+  comboLatched = 0;
 }
 
-// ---------- Loop ----------
-void updateComboHandler() {
-  int ch1a_pwm = pulseIn(RECEIVER_A_CH1_PIN, HIGH, 50000);
-  int ch2a_pwm = pulseIn(RECEIVER_A_CH2_PIN, HIGH, 50000);
-  int ch2b_pwm = pulseIn(CH2B_PIN, HIGH, 50000);
-
-  // Disable CH1B (joystick B) combos in non-manual modes
-  int ch1b_pwm = 1500;
-  if (currentMode == 1 || currentMode == 4) {
-    ch1b_pwm = pulseIn(RECEIVER_B_CH1_PIN, HIGH, 50000);
-  }
+// ---------- Stick Zones ----------
+static uint8_t stickZones(int turn, int drive) {
+  uint8_t zones = 0;
+  if (drive >= COMBO_DOWN_MIN && drive <= COMBO_DOWN_MAX) zones |= STICK_DOWN;
+  if (drive >= COMBO_UP_MIN   && drive <= COMBO_UP_MAX)   zones |= STICK_UP;
+  if (turn > 0 && turn <= COMBO_LEFT_MAX)                 zones |= STICK_LEFT;
+  if (turn >= COMBO_RIGHT_MIN)                            zones |= STICK_RIGHT;
+  return zones;
+}
 
-  bool comboDown  = (ch2a_pwm >= COMBO_DOWN_MIN && ch2a_pwm <= COMBO_DOWN_MAX) || (ch2b_pwm >= COMBO_DOWN_MIN && ch2b_pwm <= COMBO_DOWN_MAX);
-  bool comboUp    = (ch2a_pwm >= COMBO_UP_MIN && ch2a_pwm <= COMBO_UP_MAX) || (ch2b_pwm >= COMBO_UP_MIN && ch2b_pwm <= COMBO_UP_MAX);
-  bool comboLeft  = (ch1a_pwm > 0 && ch1a_pwm <= COMBO_LEFT_MAX) || (ch1b_pwm > 0 && ch1b_pwm <= COMBO_LEFT_MAX);
-  bool comboRight = (ch1a_pwm > 0 && ch1a_pwm >= COMBO_RIGHT_MIN) || (ch1b_pwm > 0 && ch1b_pwm >= COMBO_RIGHT_MIN);
-
-  // Joystick B + Controller A buttons
-  detectToggleCombo(CH3_PIN, last_CH3, 1, comboDown, comboUp, comboLeft, comboRight);
-  detectToggleCombo(CH4_PIN, last_CH4, 2, comboDown, comboUp, comboLeft, comboRight);
-  detectToggleCombo(CH5_PIN, last_CH5, 3, comboDown, comboUp, comboLeft, comboRight);
-  detectMomentaryCombo(CH6_PIN, hasTriggered_CH6_A_DOWN, hasTriggered_CH6_A_UP,
-                       hasTriggered_CH6_A_LEFT, hasTriggered_CH6_A_RIGHT,
-                       4, comboDown, comboUp, comboLeft, comboRight);
-
-  // Joystick A + Controller B buttons
-  detectToggleCombo(RECEIVER_B_CH3_PIN, last_CH3B, 17, comboDown, comboUp, comboLeft, comboRight);
-  detectToggleCombo(RECEIVER_B_CH4_PIN, last_CH4B, 18, comboDown, comboUp, comboLeft, comboRight);
-  detectToggleCombo(RECEIVER_B_CH5_PIN, last_CH5B, 19, comboDown, comboUp, comboLeft, comboRight);
-  detectMomentaryCombo(RECEIVER_B_CH6_PIN, hasTriggered_CH6_B_DOWN, hasTriggered_CH6_B_UP,
-                       hasTriggered_CH6_B_LEFT, hasTriggered_CH6_B_RIGHT,
-                       20, comboDown, comboUp, comboLeft, comboRight);
-
-  // Mode Switching
-  if (currentCombo >= 1 && currentCombo <= 4 && currentCombo != currentMode) {
-    currentMode = currentCombo;
-    currentCombo = 0;
+// Stick A in the low nibble, stick B in the high one
+static uint8_t readStickZones() {
+  return stickZones(getFramePulse(PWM_CH1A), getFramePulse(PWM_CH2A)) |
+         STICK_B(stickZones(getFramePulse(PWM_CH1B), getFramePulse(PWM_CH2B)));   // CH1B: every mode (InputPins.h)
+}
+
+// ---------- Actions ----------
+static void runCombo(int combo, const ComboEntry &row) {
+  if (row.action == COMBO_ACTION_MODE) {
+    currentMode = row.arg;          // The master file switches on the next control tick
+    return;
   }
 
-  // Debug Mode Print
-  if (currentMode != lastMode) {
-    switch (currentMode) {
-      case 1: Serial.println(">> currentMode: MANUAL MODE"); break;
-      case 2: Serial.println(">> currentMode: AUTOMATED MODE"); break;
-      case 3: Serial.println(">> currentMode: HYBRID MODE"); break;
-      case 4: Serial.println(">> currentMode: CARPET MODE"); break;
-    }
-    lastMode = currentMode;
+  currentCombo = combo;
+  comboTimestamp = millis();
+  if (LOG_ENABLED(COMBO, LOG_DEBUG)) {
+    usbLog.print(F(">> currentCombo: "));
+    usbLog.println(currentCombo);
   }
 
-  // Handle Combos
-  if (currentCombo != lastCombo && currentCombo > 4) {
-    if ((currentMode == 1 || currentMode == 4) && currentCombo <= 8 ||
-        currentMode == 3 && currentCombo <= 16 ||
-        currentMode == 2) {
-
-      Serial.print(">> currentCombo: ");
-      Serial.println(currentCombo);
-
-      switch (currentCombo) {
-        case 5: triggerMarcDuinoSequence(":SE03\r", 5, "Awake+"); disableMP3Triggers(); break;
-        case 6:
-          #if MARCDUINO_ENABLED
-            if (MARCDUINO_USE_SERIAL3) Serial3.print(":SE00\r");
-            else Serial1.print(":SE00\r");
-          #endif
-          enableMP3Triggers();
-          break;
-        case 7: triggerMarcDuinoSequence(":SE02\r", 7, "Full Awake"); disableMP3Triggers(); break;
-        case 8: triggerMarcDuinoSequence(":SE01\r", 8, "Mid Awake"); disableMP3Triggers(); break;
-        case 9: triggerMarcDuinoSequence(":SE10\r", 9, "Leia Message"); break;
-        case 10: triggerMarcDuinoSequence(":SE06\r", 10, "Scream"); break;
+  switch (row.action) {
+    case COMBO_ACTION_MARCDUINO:
+      triggerMarcDuinoSequence(row.command, combo, row.label);
+      if (row.arg == COMBO_MP3_OFF) disableMP3Triggers();
+      if (row.arg == COMBO_MP3_ON)  enableMP3Triggers();
+      break;
+
+    case COMBO_ACTION_MP3_BANK:
+      if (playMP3Bank(row.arg, MP3_PRIORITY_USER)) traceOutputLatency(LATENCY_BUTTON_TO_MP3, comboChannel);
+      if (LOG_ENABLED(COMBO, LOG_INFO)) {
+        usbLog.print(F(">> MP3 Combo "));
+        usbLog.print(combo);
+        usbLog.print(F(": Track "));
+        usbLog.println(currentMP3);
       }
-
-      comboTimestamp = millis();
-    } else {
-      currentCombo = 0;
-    }
-    lastCombo = currentCombo;
+      break;
   }
+}
 
-  if (currentCombo > 4 && millis() - comboTimestamp > comboResetDelay) {
-    currentCombo = 0;
-    Serial.println(">> currentCombo: 0");
+// ---------- Loop ----------
+void updateComboHandler() {
+  // Either stick in a zone counts, as before the table
+  uint8_t zones = readStickZones();
+  uint8_t held  = (zones | (zones >> 4)) & 0x0F;
+
+  // One pass over the buttons: what each did since the last call
+  uint16_t flipped = 0, pressed = 0, released = 0;
+  for (uint8_t i = 0; i < sizeof(comboButtons); i++) {
+    uint8_t channel = comboButtons[i];
+    int pwm = getFramePulse((PWMChannel)channel);
+    if (pwm <= 0) continue;
+
+    uint16_t bit = 1 << channel;
+    bool high = pwm > HIGH_THRESHOLD;
+    if (!(toggleSeen & bit) || ((toggleHigh & bit) != 0) != high) flipped |= bit;
+    toggleSeen |= bit;
+    if (high) toggleHigh |= bit;
+    else      toggleHigh &= ~bit;
+
+    if (pwm >= MOMENTARY_PRESS) pressed |= bit;
+    if (pwm < LOW_THRESHOLD)    released |= bit;
   }
-}
 
-// ---------- Combo Trigger Handlers ----------
-void detectToggleCombo(int pin, int &lastState, int baseCombo,
-                       bool down, bool up, bool left, bool right) {
-  int pwm = pulseIn(pin, HIGH, 50000);
-  if (pwm > 0) {
-    int state = (pwm > HIGH_THRESHOLD) ? HIGH : LOW;
-    if (state != lastState) {
-      if (down)       currentCombo = baseCombo;
-      else if (up)    currentCombo = baseCombo + 4;
-      else if (left)  currentCombo = baseCombo + 8;
-      else if (right) currentCombo = baseCombo + 12;
-      lastState = state;
+  // Every row against those masks; each button event fires at most one
+  // row, the first one in table order whose stick zone is held
+  uint16_t unused = flipped | pressed;
+  if (flipped | pressed || (released && comboLatched)) {
+    for (uint8_t i = 0; i < COMBO_COUNT; i++) {
+      ComboEntry row;
+      memcpy_P(&row, &comboTable[i], sizeof(row));
+      uint16_t bit  = 1 << row.button;
+      uint32_t slot = 1UL << i;
+
+      if (row.type == COMBO_MOMENTARY) {
+        if (released & bit) comboLatched &= ~slot;
+        if (!(pressed & bit) || (comboLatched & slot)) continue;
+      } else if (!(flipped & bit)) {
+        continue;
+      }
+      if (!(unused & bit) || !(held & row.stick)) continue;
+
+      unused &= ~bit;
+      if (row.type == COMBO_MOMENTARY) comboLatched |= slot;
+      if (!(row.modes & (1 << currentMode))) continue;   // Not in this mode: used up, nothing happens
+
+      comboChannel = row.button;
+      runCombo(i + 1, row);
     }
   }
-}
 
-void detectMomentaryCombo(int pin,
-                          bool &trigDown, bool &trigUp, bool &trigLeft, bool &trigRight,
-                          int baseCombo,
-                          bool down, bool up, bool left, bool right) {
-  int pwm = pulseIn(pin, HIGH, 50000);
-  if (pwm > 0) {
-    if (down && pwm >= 1900 && !trigDown) {
-      currentCombo = baseCombo;
-      trigDown = true;
-    }
-    if (up && pwm >= 1900 && !trigUp) {
-      currentCombo = baseCombo + 4;
-      trigUp = true;
-    }
-    if (left && pwm >= 1900 && !trigLeft) {
-      currentCombo = baseCombo + 8;
-      trigLeft = true;
-    }
-    if (right && pwm >= 1900 && !trigRight) {
-      currentCombo = baseCombo + 12;
-      trigRight = true;
-    }
-    if (pwm < LOW_THRESHOLD) {
-      trigDown = trigUp = trigLeft = trigRight = false;
+  // Debug Mode Print (lastMode belongs to the master file's mode switch)
+  static int printedMode = 0;
+  if (LOG_ENABLED(COMBO, LOG_DEBUG) && currentMode != printedMode) {
+    switch (currentMode) {
+      case 1: usbLog.println(F(">> currentMode: MANUAL MODE")); break;
+      case 2: usbLog.println(F(">> currentMode: AUTOMATED MODE")); break;
+      case 3: usbLog.println(F(">> currentMode: HYBRID MODE")); break;
+      case 4: usbLog.println(F(">> currentMode: CARPET MODE")); break;
     }
+    printedMode = currentMode;
+  }
+
+  if (currentCombo > 4 && millis() - comboTimestamp > comboResetDelay) {
+    currentCombo = 0;
+    LOG_LINE(COMBO, LOG_DEBUG, ">> currentCombo: 0");
   }
 }
 
 // ---------- External Access for Kill Switch ----------
 bool isComboModeActive(int mode) {
-  int ch1a = pulseIn(RECEIVER_A_CH1_PIN, HIGH, 30000);
-  int ch2a = pulseIn(RECEIVER_A_CH2_PIN, HIGH, 30000);
-  int ch1b = pulseIn(RECEIVER_B_CH1_PIN, HIGH, 30000);
-  int ch2b = pulseIn(CH2B_PIN, HIGH, 30000);
-
-  if (mode == 1) {
-    return (ch2b >= COMBO_DOWN_MIN && ch2b <= COMBO_DOWN_MAX) ||
-           (ch2b >= COMBO_UP_MIN   && ch2b <= COMBO_UP_MAX);
-  }
-
-  if (mode == 2) {
-    return
-      (ch2a >= COMBO_DOWN_MIN && ch2a <= COMBO_DOWN_MAX) ||
-      (ch2a >= COMBO_UP_MIN   && ch2a <= COMBO_UP_MAX)   ||
-      (ch1a > 0 && ch1a <= COMBO_LEFT_MAX)              ||
-      (ch1a > 0 && ch1a >= COMBO_RIGHT_MIN)             ||
-      (ch2b >= COMBO_DOWN_MIN && ch2b <= COMBO_DOWN_MAX) ||
-      (ch2b >= COMBO_UP_MIN   && ch2b <= COMBO_UP_MAX)   ||
-      (ch1b > 0 && ch1b <= COMBO_LEFT_MAX)              ||
-      (ch1b > 0 && ch1b >= COMBO_RIGHT_MIN);
-  }
-
-  if (mode == 3) {
-    return
-      (ch2b >= COMBO_DOWN_MIN && ch2b <= COMBO_DOWN_MAX) ||
-      (ch2b >= COMBO_UP_MIN   && ch2b <= COMBO_UP_MAX)   ||
-      (ch1b > 0 && ch1b <= COMBO_LEFT_MAX)              ||
-      (ch1b > 0 && ch1b >= COMBO_RIGHT_MIN);
-  }
-
-  if (mode == 4) {
-    return
-      (ch2b >= COMBO_DOWN_MIN && ch2b <= COMBO_DOWN_MAX) ||
-      (ch1b > 0 && ch1b <= COMBO_LEFT_MAX)              ||
-      (ch1b > 0 && ch1b >= COMBO_RIGHT_MIN);
-  }
+  if (mode < 1 || mode > 4) return false;
+  return readStickZones() & pgm_read_byte(&killZones[mode]);
+}
 
-  return false;
+// Idle governor: someone is halfway through a combo
+bool isComboHeld() {
+  return comboLatched || readStickZones();
 }
@@ -15,27 +15,70 @@
 #define COMBO_HANDLER_H
 
 #include <Arduino.h>
+#include "PWMInputHandler.h"
 
 // ---------- Combo State ----------
 extern int currentCombo;
 extern int currentMode;
 extern int lastMode;
 
+// ---------- Combo Table Format (rows in ComboHandler.cpp) ----------
+#define COMBO_COUNT         32     // Rows = combo numbers 1–32; one bit each in the latch mask
+#define COMBO_COMMAND_MAX   15     // Longest MarcDuino string in the table
+
+// Stick zones: stick A in the low nibble, stick B in the high one
+enum ComboStick {
+  STICK_DOWN  = 0x01,
+  STICK_UP    = 0x02,
+  STICK_LEFT  = 0x04,
+  STICK_RIGHT = 0x08
+};
+#define STICK_B(zones)      ((zones) << 4)
+
+enum ComboType {
+  COMBO_TOGGLE = 0,        // Fires when the switch flips either way (CH3–CH5)
+  COMBO_MOMENTARY          // Fires once per press (CH6), re-armed on release
+};
+
+enum ComboAction {
+  COMBO_ACTION_NONE = 0,   // Only sets `currentCombo`
+  COMBO_ACTION_MODE,       // arg = mode 1–4
+  COMBO_ACTION_MARCDUINO,  // command = string; arg = ComboMP3Change
+  COMBO_ACTION_MP3_BANK    // arg = MP3Bank (MP3Handler.h), random track
+};
+
+enum ComboMP3Change {
+  COMBO_MP3_KEEP = 0,
+  COMBO_MP3_OFF,           // MarcDuino show owns the sound: button MP3s off
+  COMBO_MP3_ON             // Quiet: button MP3s back on
+};
+
+// Modes a row fires in (bit = currentMode)
+#define COMBO_IN_MANUAL     (1 << 1)
+#define COMBO_IN_AUTOMATED  (1 << 2)
+#define COMBO_IN_HYBRID     (1 << 3)
+#define COMBO_IN_CARPET     (1 << 4)
+#define COMBO_IN_ALL        (COMBO_IN_MANUAL | COMBO_IN_AUTOMATED | COMBO_IN_HYBRID | COMBO_IN_CARPET)
+
+// One row, stored in flash (PROGMEM); strings are flash pointers too
+struct ComboEntry {
+  uint8_t     button;      // PWMChannel: PWM_CH3A–CH6A, PWM_CH3B–CH6B
+  uint8_t     stick;       // ComboStick zone held on either stick
+  uint8_t     type;        // ComboType
+  uint8_t     modes;       // COMBO_IN_* bits
+  uint8_t     action;      // ComboAction
+  uint8_t     arg;         // Depends on action
+  const char* command;     // MarcDuino string, or NULL
+  const char* label;       // Debug text, or NULL
+};
+
 // ---------- Setup & Loop ----------
 void setupComboHandler();
 void updateComboHandler();
 
-// ---------- Helper Functions ----------
-void detectToggleCombo(int pin, int &lastState, int baseCombo,
-                       bool down, bool up, bool left, bool right);
-
-void detectMomentaryCombo(int pin,
-                          bool &trigDown, bool &trigUp, bool &trigLeft, bool &trigRight,
-                          int baseCombo,
-                          bool down, bool up, bool left, bool right);
-
 // ---------- Kill Switch Check ----------
 bool isComboModeActive();                // Legacy version
 bool isComboModeActive(int mode);       // Mode-aware version
+bool isComboHeld();                      // A momentary combo held, or a stick in a combo zone
 
 #endif
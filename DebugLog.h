@@ -0,0 +1,65 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                   DebugLog.h - Shadow-RC                   ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Compile-time log levels per subsystem for the debug text   ║
+  ║ on USB. A line above its subsystem's level is not built:   ║
+  ║ no flash, no SRAM, no cycles. The rest live in flash.      ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are adding a subsystem.             ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef DEBUG_LOG_H
+#define DEBUG_LOG_H
+
+#include <Arduino.h>
+#include "SerialTx.h"
+
+// ---------- Levels ----------
+#define LOG_OFF      0
+#define LOG_WARN     1      // Faults: link lost, dome stalled, bus not verified
+#define LOG_INFO     2      // State changes: mode, kill switch, combos, sounds, parking
+#define LOG_DEBUG    3      // Chatter: every automated dome move, combo state
+
+// ---------- Per Subsystem ----------
+// Raise one to LOG_DEBUG to chase a problem, drop the rest to LOG_OFF
+// to win back flash. The host bench can override them with -D.
+#ifndef LOG_LEVEL_MODE
+#define LOG_LEVEL_MODE   LOG_INFO     // Mode switches, Automated / Hybrid mode lines
+#endif
+#ifndef LOG_LEVEL_DRIVE
+#define LOG_LEVEL_DRIVE  LOG_INFO     // DriveController: profile, kill switch, link loss
+#endif
+#ifndef LOG_LEVEL_DOME
+#define LOG_LEVEL_DOME   LOG_INFO     // DomePosition + the automated dome moves
+#endif
+#ifndef LOG_LEVEL_MP3
+#define LOG_LEVEL_MP3    LOG_INFO     // MP3Handler + Hybrid's random sounds
+#endif
+#ifndef LOG_LEVEL_COMBO
+#define LOG_LEVEL_COMBO  LOG_INFO     // ComboHandler
+#endif
+#ifndef LOG_LEVEL_BUS
+#define LOG_LEVEL_BUS    LOG_INFO     // MotorBus
+#endif
+#ifndef LOG_LEVEL_IDLE
+#define LOG_LEVEL_IDLE   LOG_INFO     // IdleGovernor
+#endif
+
+// ---------- Logging ----------
+// Both expand to a constant `if`: a disabled line, its F() string and
+// its arguments are dropped by the compiler. Text goes to `usbLog`
+// (queued, never blocks; SerialTx.h).
+//
+//   LOG_LINE(DOME, LOG_INFO, "[DOME] Home found.");
+//   if (LOG_ENABLED(DOME, LOG_DEBUG)) {
+//     usbLog.print(F("[DOME] Move "));
+//     usbLog.println(moveCount);
+//   }
+#define LOG_ENABLED(subsystem, level)  (LOG_LEVEL_##subsystem >= (level))
+
+#define LOG_LINE(subsystem, level, text) \
+  do { if (LOG_ENABLED(subsystem, level)) usbLog.println(F(text)); } while (0)
+
+#endif
@@ -0,0 +1,432 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                  DomePosition.cpp - Shadow-RC System               ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Drives the dome to an angle and knows when it got there. Timed    ║
+  ║ bursts (ms per degree × speed curve × left / right fudge) drift   ║
+  ║ a little every move, so "return to center" slowly stopped being   ║
+  ║ center over a long session.                                       ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - The quadrature encoder on pins 19 / 20 counts every edge of both
+    channels into `encoderTicks`, in every mode, so the position
+    stays known while the operator drives the dome by hand too.
+  - Both pins sit on port D, so the ISR reads them with one PIND load
+    (no digitalRead() pin-table lookups) and looks the step up in a
+    16-entry table indexed by old state × new state: +1, -1, 0, or
+    illegal. An illegal jump (both pins changed, i.e. an edge was
+    missed) counts into `domeEncoderErrors` instead of guessing a
+    direction. The ISR is ~3 µs, so both channels keep up far past
+    the SyRen's full-power dome speed (a few kHz of edges).
+  - `DOME_TICKS_PER_DEGREE` = counts per motor revolution ×
+    `DOME_GEAR_RATIO` / 360, folded to Q16.16 at compile time.
+  - `moveDomeTo(angle, maxPower)` sets an absolute target (degrees
+    from home) and plans a trapezoid to it: speed up at
+    `DOME_ACCEL_DEG_S2`, cruise at maxPower's share of
+    `DOME_FULL_SPEED_DEG_S`, and start braking once the distance left
+    is what it takes to stop. Every tick the setpoint advances by
+    one step of that speed, in Q16.16 counts.
+  - `updateDomePosition()` runs a PID loop on the setpoint, not the
+    target: P on the distance behind it, D on the counts moved minus
+    the setpoint's, plus the profile speed itself as feed-forward
+    (led by `DOME_MOTOR_LAG_MS`, so it brakes before the dome has to).
+    The I term only runs once the setpoint has arrived, to push
+    through the last degree. Power is capped at the move's `maxPower`;
+    below `DOME_MIN_POWER` it pushes only when the dome has fallen
+    more than `DOME_TOLERANCE_COUNTS` behind, and otherwise coasts.
+  - `DOME_ACCEL_DEG_S2` 0 puts the setpoint on the target at once:
+    the old loop, full power until the error closes.
+  - The move ends after `DOME_SETTLE_TICKS` ticks inside the window.
+    Power with no encoder count for `DOME_STALL_MS`, or no arrival
+    within `DOME_MOVE_TIMEOUT_MS`, stops the dome and sets a fault.
+    Both clocks wait for the motor bus: a move started at boot
+    (Automated Mode) sits still until the drivers are synced.
+  - Home: with `DOME_HOME_PIN` set, the first move seeks the sensor at
+    `DOME_HOME_POWER` and zeroes the count there. Without one, 0° is
+    wherever the dome sat at power-up.
+
+  TUNING:
+  ─────────────────────────────────────────────────────────────────────
+  Time a full turn at power 127 and set DOME_FULL_SPEED_DEG_S to
+  match, so the feed-forward alone nearly tracks; DOME_MOTOR_LAG_MS is
+  how long a step of power takes to reach ~2/3 of its speed. Overshoots the
+  target → lower DOME_ACCEL_DEG_S2 (brakes earlier) or raise DOME_KD.
+  Lags the setpoint → raise DOME_KP. Stops short → raise
+  DOME_MIN_POWER. Set DOME_ENCODER_CPR to 4 × your encoder's pulses
+  per revolution. `stats` shows the last move's time and overshoot.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `DomePosition.cpp`
+  Header:    `DomePosition.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "DomePosition.h"
+#include "MotorBus.h"
+#include "DebugLog.h"
+#include "Scheduler.h"     // CONTROL_TICK_US: the profile advances once per tick
+#include <Arduino.h>
+
+// Keeps the I term within what it takes to get the dome moving
+#define DOME_INTEGRAL_LIMIT  ((long)DOME_MIN_POWER * Q8_8_ONE / DOME_KI)
+
+// Profile units: Q16.16 encoder counts, per control tick (and tick²)
+#define COUNTS_PER_DEGREE    (DOME_ENCODER_CPR * DOME_GEAR_RATIO / 360.0)
+#define TICK_SECONDS         (CONTROL_TICK_US / 1000000.0)
+#define PROFILE_FULL_SPEED   ((long)(DOME_FULL_SPEED_DEG_S * COUNTS_PER_DEGREE * TICK_SECONDS * 65536.0 + 0.5))
+#define PROFILE_ACCEL        ((long)(DOME_ACCEL_DEG_S2 * COUNTS_PER_DEGREE * TICK_SECONDS * TICK_SECONDS * 65536.0 + 0.5))
+#define PROFILE_LAG_TICKS    ((DOME_MOTOR_LAG_MS * 1000L + CONTROL_TICK_US / 2) / CONTROL_TICK_US)
+
+enum DomeState { DOME_IDLE = 0, DOME_HOMING, DOME_MOVING };
+
+volatile long encoderTicks = 0;
+
+volatile unsigned long domeEncoderErrors = 0;
+
+static volatile uint8_t* encoderPortReg;
+static uint8_t encoderMaskA;
+static uint8_t encoderMaskB;
+static uint8_t encoderState = 0;               // (A << 1) | B at the last edge
+
+// [old state × 4 + new state] → count step. States in forward order:
+// 00 → 10 → 11 → 01 → 00. ENC_BAD = both pins changed (edge missed).
+#define ENC_BAD  2
+static const int8_t encoderSteps[16] = {
+  //  new: 00       01       10       11
+          0,      -1,      +1,  ENC_BAD,   // old 00
+         +1,       0,  ENC_BAD,      -1,   // old 01
+         -1,  ENC_BAD,       0,      +1,   // old 10
+    ENC_BAD,      +1,      -1,       0     // old 11
+};
+
+static uint8_t       domeState = DOME_IDLE;
+static uint8_t       domeFault = DOME_FAULT_NONE;
+static bool          homed = false;
+static long          homeCounts = 0;        // Raw count at 0°
+static long          targetCounts = 0;      // Relative to home
+static int           targetAngle = 0;
+static int           movePower = 0;
+static long          lastCounts = 0;
+static long          integral = 0;
+static uint8_t       settledTicks = 0;
+static unsigned long moveStartMs = 0;
+static unsigned long lastCountMs = 0;
+
+// Setpoint the loop follows: runs from the start position to targetCounts
+static long          profileRef = 0;        // Q16.16 counts from home
+static long          profileSpeed = 0;      // Q16.16 counts per tick, toward profileDir
+static long          profileStep = 0;       // Speed change this tick: + speeding up, - braking
+static long          profileCruise = 0;
+static int8_t        profileDir = 0;        // 0 = setpoint is at the target
+static long          lastRefCounts = 0;
+static int8_t        moveSign = 0;          // Direction of the whole move
+static long          overshootCounts = 0;   // Furthest past the target this move
+
+DomeStats domeStats;
+
+static void updateEncoder();
+
+// ==========================
+//        SETUP
+// ==========================
+void setupDomePosition() {
+  pinMode(DOME_ENCODER_PIN_A, INPUT_PULLUP);
+  pinMode(DOME_ENCODER_PIN_B, INPUT_PULLUP);
+
+  if (digitalPinToPort(DOME_ENCODER_PIN_A) != digitalPinToPort(DOME_ENCODER_PIN_B)) {
+    LOG_LINE(DOME, LOG_WARN, "[DOME] Encoder pins must share a port; encoder disabled.");
+  } else {
+    encoderPortReg = portInputRegister(digitalPinToPort(DOME_ENCODER_PIN_A));
+    encoderMaskA = digitalPinToBitMask(DOME_ENCODER_PIN_A);
+    encoderMaskB = digitalPinToBitMask(DOME_ENCODER_PIN_B);
+    uint8_t port = *encoderPortReg;
+    encoderState = ((port & encoderMaskA) ? 2 : 0) | ((port & encoderMaskB) ? 1 : 0);
+    attachInterrupt(digitalPinToInterrupt(DOME_ENCODER_PIN_A), updateEncoder, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(DOME_ENCODER_PIN_B), updateEncoder, CHANGE);
+  }
+
+  if (DOME_HOME_PIN >= 0) pinMode(DOME_HOME_PIN, INPUT_PULLUP);
+
+  encoderTicks = 0;
+  homeCounts = 0;
+  homed = (DOME_HOME_PIN < 0);
+  domeState = DOME_IDLE;
+  resetDomeStats();
+}
+
+// ==========================
+//        POSITION
+// ==========================
+long readDomeTicks() {
+  long ticks;
+  do {
+    ticks = encoderTicks;
+  } while (ticks != encoderTicks);   // ISR updated it mid-copy — read again
+  return ticks;
+}
+
+unsigned long readDomeEncoderErrors() {
+  unsigned long errors;
+  do {
+    errors = domeEncoderErrors;
+  } while (errors != domeEncoderErrors);
+  return errors;
+}
+
+// Raw count in the "+ = right" direction
+static long readDomeCounts() {
+  long ticks = readDomeTicks();
+  return DOME_ENCODER_REVERSED ? -ticks : ticks;
+}
+
+static long angleToCounts(int angleDeg) {
+  return fxMulInt(angleDeg, DOME_TICKS_PER_DEGREE);
+}
+
+// Rounded to the nearest degree
+static int countsToAngle(long counts) {
+  long scaled  = counts * 256;
+  long divisor = DOME_TICKS_PER_DEGREE >> 8;
+  return (int)((scaled + (scaled >= 0 ? divisor / 2 : -divisor / 2)) / divisor);
+}
+
+int getDomeAngle() {
+  return countsToAngle(readDomeCounts() - homeCounts);
+}
+
+int getDomeTargetAngle() {
+  return targetAngle;
+}
+
+// ==========================
+//      MOTION PROFILE
+// ==========================
+// From where the dome is now, at rest, toward targetCounts
+static void startProfile(long fromCounts) {
+  long distance = targetCounts - fromCounts;
+  profileRef    = fromCounts * Q16_16_ONE;
+  lastRefCounts = fromCounts;
+  profileSpeed  = 0;
+  profileStep   = 0;
+  // 3/4 of maxPower's speed: the rest is left for the PID to catch up
+  profileCruise = max(PROFILE_FULL_SPEED * movePower / 127 * 3 / 4, PROFILE_ACCEL);
+  profileDir    = (distance > 0) - (distance < 0);
+  moveSign      = profileDir;
+  overshootCounts = 0;
+  if (PROFILE_ACCEL == 0) profileDir = 0;            // No profile: loop straight at the target
+  if (profileDir == 0) profileRef = targetCounts * Q16_16_ONE;
+}
+
+// One control tick: brake if the rest of the way is what it takes to
+// stop (v + (v - a) + … ≈ v² / 2a), else speed up to the cruise speed
+static void advanceProfile() {
+  if (profileDir == 0) return;
+
+  long goal      = targetCounts * Q16_16_ONE;
+  long remaining = (goal - profileRef) * profileDir;
+  long brake     = profileSpeed / 2 * (profileSpeed / PROFILE_ACCEL + 1);
+
+  long before = profileSpeed;
+  if (remaining <= brake) profileSpeed -= PROFILE_ACCEL;
+  else                    profileSpeed += PROFILE_ACCEL;
+  profileSpeed = constrain(profileSpeed, PROFILE_ACCEL, profileCruise);   // Never stop short
+  profileStep  = profileSpeed - before;
+
+  if (profileSpeed >= remaining) {
+    profileRef   = goal;
+    profileSpeed = 0;
+    profileStep  = 0;
+    profileDir   = 0;
+  } else {
+    profileRef += profileDir * profileSpeed;
+  }
+}
+
+static long profileCounts() {
+  return (profileRef + Q16_16_ONE / 2) >> 16;
+}
+
+// ==========================
+//        COMMANDS
+// ==========================
+void moveDomeTo(int angleDeg, int maxPower) {
+  unsigned long now = millis();
+
+  targetAngle  = angleDeg;
+  targetCounts = angleToCounts(angleDeg);
+  movePower    = constrain(abs(maxPower), DOME_MIN_POWER, 127);
+  integral     = 0;
+  settledTicks = 0;
+  domeFault    = DOME_FAULT_NONE;
+  lastCounts   = readDomeCounts();
+  moveStartMs  = now;
+  lastCountMs  = now;
+  domeState    = homed ? DOME_MOVING : DOME_HOMING;
+  if (homed) startProfile(lastCounts - homeCounts);
+}
+
+void stopDome() {
+  setDomePower(0);
+  domeState = DOME_IDLE;
+  targetCounts = readDomeCounts() - homeCounts;
+  targetAngle  = countsToAngle(targetCounts);
+  profileDir   = 0;
+  profileRef   = targetCounts * Q16_16_ONE;
+}
+
+bool isDomeMoving() {
+  return domeState != DOME_IDLE;
+}
+
+uint8_t getDomeFault() {
+  return domeFault;
+}
+
+void resetDomeStats() {
+  memset(&domeStats, 0, sizeof(domeStats));
+  noInterrupts();
+  domeEncoderErrors = 0;             // 4 bytes the encoder ISR also writes
+  interrupts();
+}
+
+static void endMove(uint8_t fault) {
+  setDomePower(0);
+  domeState = DOME_IDLE;
+  domeFault = fault;
+  profileDir = 0;
+
+  if (fault == DOME_FAULT_NONE) {
+    domeStats.moves++;
+    domeStats.lastMoveMs = millis() - moveStartMs;
+    domeStats.lastOvershoot = overshootCounts;
+    if (domeStats.lastOvershoot > domeStats.worstOvershoot) domeStats.worstOvershoot = domeStats.lastOvershoot;
+    return;
+  }
+  if (LOG_ENABLED(DOME, LOG_WARN)) {
+    usbLog.print(F("[DOME] Move stopped: "));
+    usbLog.println(fault == DOME_FAULT_STALL   ? F("no encoder counts (stalled or unplugged).") :
+                   fault == DOME_FAULT_TIMEOUT ? F("target not reached in time.") :
+                                                 F("home sensor not found, keeping power-up zero."));
+  }
+}
+
+// ==========================
+//      CONTROL LOOP
+// ==========================
+static void seekHome(long counts, unsigned long now) {
+  if (digitalRead(DOME_HOME_PIN) == LOW) {
+    homeCounts = counts;
+    homed = true;
+    domeState = DOME_MOVING;
+    moveStartMs = now;
+    startProfile(0);
+    LOG_LINE(DOME, LOG_INFO, "[DOME] Home found.");
+    return;
+  }
+  if (now - moveStartMs > DOME_HOME_TIMEOUT_MS) {
+    homed = true;            // Fall back to the power-up zero
+    endMove(DOME_FAULT_NO_HOME);
+    return;
+  }
+  if (now - lastCountMs > DOME_STALL_MS) {
+    endMove(DOME_FAULT_STALL);
+    return;
+  }
+  setDomePower(DOME_HOME_POWER);
+}
+
+void updateDomePosition() {
+  if (domeState == DOME_IDLE) return;
+
+  unsigned long now = millis();
+  long counts = readDomeCounts();
+  long moved  = counts - lastCounts;
+  lastCounts  = counts;
+  if (moved != 0) lastCountMs = now;
+
+  if (!isMotorBusReady()) {          // Drivers still booting: nothing can move yet
+    lastCountMs = moveStartMs = now;
+    return;
+  }
+
+  if (domeState == DOME_HOMING) {
+    seekHome(counts, now);
+    return;
+  }
+
+  advanceProfile();
+  long position  = counts - homeCounts;
+  long refCounts = profileCounts();
+  long refMoved  = refCounts - lastRefCounts;
+  lastRefCounts  = refCounts;
+  long error     = refCounts - position;     // Behind the setpoint, not the target
+
+  long past = (position - targetCounts) * moveSign;
+  if (past > overshootCounts) overshootCounts = past;
+
+  bool atTarget = (profileDir == 0 && labs(error) <= DOME_TOLERANCE_COUNTS);
+  if (atTarget) {
+    if (++settledTicks >= DOME_SETTLE_TICKS) {
+      endMove(DOME_FAULT_NONE);
+      return;
+    }
+  } else {
+    settledTicks = 0;
+  }
+
+  if (now - moveStartMs > DOME_MOVE_TIMEOUT_MS) {
+    endMove(DOME_FAULT_TIMEOUT);
+    return;
+  }
+
+  // I only near the end of the profile, so following it does not wind it up
+  if (profileDir == 0 && labs(error) < 8 * DOME_TOLERANCE_COUNTS) {
+    integral = constrain(integral + error, -DOME_INTEGRAL_LIMIT, DOME_INTEGRAL_LIMIT);
+  } else {
+    integral = 0;
+  }
+
+  // D on the speed error: the setpoint's counts this tick minus the dome's
+  long output = fxScale32(error, DOME_KP) + fxScale32(integral, DOME_KI) - fxScale32(moved - refMoved, DOME_KD);
+#if DOME_FEEDFORWARD
+  // The speed the dome should have one motor lag from now, as power
+  output += profileDir * (profileSpeed + profileStep * PROFILE_LAG_TICKS) * 127 / PROFILE_FULL_SPEED;
+#endif
+  int power = constrain(output, -movePower, movePower);
+
+  if (atTarget) {
+    power = 0;                                     // Let it coast to a stop inside the window
+  } else if (abs(power) < DOME_MIN_POWER) {
+    // Below what turns the dome: push only when it has fallen behind
+    if (labs(error) > DOME_TOLERANCE_COUNTS) power = (error > 0) ? DOME_MIN_POWER : -DOME_MIN_POWER;
+    else                                     power = 0;
+  }
+
+  if (power == 0) {
+    lastCountMs = now;                             // Not moving on purpose is not a stall
+  } else if (now - lastCountMs > DOME_STALL_MS) {
+    endMove(DOME_FAULT_STALL);
+    return;
+  }
+
+  setDomePower(power);
+}
+
+// ==========================
+//        ISR
+// ==========================
+// One port read for both pins, one table lookup for the step
+void updateEncoder() {
+  uint8_t port  = *encoderPortReg;
+  uint8_t state = ((port & encoderMaskA) ? 2 : 0) | ((port & encoderMaskB) ? 1 : 0);
+  int8_t  step  = encoderSteps[(encoderState << 2) | state];
+  encoderState  = state;
+
+  if (step == ENC_BAD) domeEncoderErrors++;
+  else encoderTicks += step;
+}
@@ -0,0 +1,92 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                 DomePosition.h - Shadow-RC                 ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for closed-loop dome positioning. The quadrature    ║
+  ║ encoder on pins 19 / 20 gives the dome angle; automation   ║
+  ║ asks for an angle and a PID loop follows a trapezoidal     ║
+  ║ speed profile there.                                       ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing dome hardware.         ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef DOME_POSITION_H
+#define DOME_POSITION_H
+
+#include <Arduino.h>
+#include "FixedPoint.h"
+#include "InputPins.h"      // DOME_ENCODER_PIN_A / _B
+
+// ---------- Encoder ----------
+#define DOME_ENCODER_CPR        256    // Quadrature counts per motor revolution (4 × encoder PPR)
+#define DOME_ENCODER_REVERSED   0      // 1 if positive (right) dome power counts down
+#define DOME_GEAR_RATIO         (360.416 / 50.7)   // Motor revolutions per dome revolution
+
+// Encoder counts per degree of dome rotation (Q16.16, folded at compile time)
+#define DOME_TICKS_PER_DEGREE   Q16_16(DOME_ENCODER_CPR * DOME_GEAR_RATIO / 360.0)
+
+// ---------- Home ----------
+// With no home sensor, wherever the dome sits at power-up is 0° (front).
+// A hall sensor / switch to GND at the front lets the first automated
+// move seek it at DOME_HOME_POWER and zero the count there.
+#define DOME_HOME_PIN           -1     // e.g. 38; -1 = power-up position is home
+#define DOME_HOME_POWER         20     // Seek speed (positive = right)
+#define DOME_HOME_TIMEOUT_MS    8000   // Give up and keep the power-up zero
+
+// ---------- Position Loop (every control tick) ----------
+#define DOME_KP                 Q8_8(1.50)   // Power per count of error
+#define DOME_KI                 Q8_8(0.02)   // Power per count of summed error (near target only)
+#define DOME_KD                 Q8_8(6.00)   // Power per count moved per tick
+#define DOME_MIN_POWER          12     // Below this the SyRen cannot turn the dome
+#define DOME_TOLERANCE_COUNTS   3      // "At target" window
+#define DOME_SETTLE_TICKS       10     // Control ticks inside the window before the move ends
+#define DOME_STALL_MS           400    // Powered with no encoder count for this long = fault
+#define DOME_MOVE_TIMEOUT_MS    10000  // Give up on a move that never arrives
+
+// ---------- Motion Profile ----------
+// Each move speeds up, cruises at maxPower's share of full speed and
+// brakes into the target; the loop above follows that moving setpoint
+// instead of jumping at the target with full power.
+#define DOME_FULL_SPEED_DEG_S   300    // Dome speed at power 127 (time a full turn at 127)
+#define DOME_ACCEL_DEG_S2       600    // Speed-up / braking rate; 0 = no profile (PID straight at the target)
+#define DOME_FEEDFORWARD        1      // 1 = profile speed → power directly, PID only corrects
+#define DOME_MOTOR_LAG_MS       60     // SyRen + dome inertia: power step → ~2/3 of the new speed
+
+enum DomeFault {
+  DOME_FAULT_NONE = 0,
+  DOME_FAULT_STALL,        // Power on, encoder silent (jammed dome or encoder unplugged)
+  DOME_FAULT_TIMEOUT,      // Never settled inside the tolerance
+  DOME_FAULT_NO_HOME       // Home sensor never triggered
+};
+
+struct DomeStats {
+  unsigned long moves;          // Moves that settled on their target
+  unsigned long lastMoveMs;     // moveDomeTo() → settled, last move
+  long          worstOvershoot; // Counts past the target, worst move
+  long          lastOvershoot;
+};
+
+extern DomeStats domeStats;
+
+extern volatile long encoderTicks;            // Raw encoder count, written by the ISR
+extern volatile unsigned long domeEncoderErrors;   // Illegal transitions (missed edges)
+
+// ---------- Setup & Loop ----------
+void setupDomePosition();      // Encoder pins + interrupts; once at boot
+void updateDomePosition();     // Control tick, from the mode that owns the dome
+
+// ---------- Commands ----------
+void moveDomeTo(int angleDeg, int maxPower);  // Degrees from home, + = right
+void stopDome();               // Power off, target = where it is now
+bool isDomeMoving();           // A move or the home seek is still running
+uint8_t getDomeFault();        // DomeFault of the last move
+void resetDomeStats();         // Move stats + encoder errors
+
+// ---------- Position ----------
+long readDomeTicks();          // Consistent copy of encoderTicks
+unsigned long readDomeEncoderErrors();   // Consistent copy of domeEncoderErrors
+int  getDomeAngle();           // Degrees from home
+int  getDomeTargetAngle();
+
+#endif
@@ -0,0 +1,341 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                DriveController.cpp - Shadow-RC System              ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ The one stick pipeline behind Manual, Carpet and Hybrid Mode:     ║
+  ║ map → deadzone → expo → taper → kill switch → motor bus.          ║
+  ║ Each mode file keeps its tunables and builds a `DriveProfile`     ║
+  ║ from them; this file does the per-tick work for all of them.     ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - `updateDriveController()` runs once per control tick from the
+    active mode's loop. It reads CH1A (turn), CH2A (drive) and, when
+    the profile has a dome table, CH1B (dome) from the InputFrame.
+  - Everything is integer: a calibrated `FxStickMap` per stick (the
+    profile's Q8.8 dome gains folded into the dome slopes) and the
+    profile's prebuilt `ResponseCurve` tables. `cal` and `tune`
+    (TuningStore.cpp) rebuild them outside the tick.
+  - The dome flick logic (short bursts capped at `maxFlickSpeed`) and
+    the Hybrid-style turn taper are profile switches, not copies.
+  - `driveGovernor` scales the drive and turn outputs and limits how
+    fast they grow, after every other stage. Carpet Mode's traction
+    control drives it; any drop (release, kill, timeout, link loss)
+    still goes out in the same tick.
+  - Failsafe: `motorTimeoutMs` counts from the last accepted pulse on
+    CH2A / CH1A (`inputFrame.fresh`), not from the last tick. When the
+    input stage declares link loss, drive and turn stop in the same
+    tick and every axis waits for its stick to be centred again once
+    the link is back; a silent CH1B stops the dome.
+
+  HOT MODE SWITCHING:
+  ─────────────────────────────────────────────────────────────────────
+  `selectDriveProfile()` swaps the active profile in place: no
+  Serial2 re-sync, no interrupt re-attach, no settle delay. It sends
+  stop packets ahead of everything else and holds each axis (drive,
+  turn, dome) at 0 until its stick has been back inside
+  `DRIVE_REARM_WINDOW` of centre once, so a stick that was pushed in
+  the old mode never jumps straight to the new mode's speed.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `DriveController.cpp`
+  Header:    `DriveController.h`
+  Profiles:  `ManualMode.cpp`, `CarpetMode.cpp`, `HybridMode.cpp`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "DriveController.h"
+#include "PWMInputHandler.h"
+#include "ComboHandler.h"
+#include "MotorBus.h"
+#include "Telemetry.h"
+#include "DebugLog.h"
+#include <Arduino.h>
+
+#define DRIVE_REARM_WINDOW  10   // |mapped stick| that counts as centred after a swap (~40 µs)
+
+// Stick ranges per axis, rebuilt from the calibration (and for the dome
+// the active profile's gains) outside the control tick
+static StickCalibration stickCal[STICK_AXIS_COUNT] = {
+  { STICK_DEFAULT_MIN_US, STICK_DEFAULT_CENTER_US, STICK_DEFAULT_MAX_US },
+  { STICK_DEFAULT_MIN_US, STICK_DEFAULT_CENTER_US, STICK_DEFAULT_MAX_US },
+  { STICK_DEFAULT_MIN_US, STICK_DEFAULT_CENTER_US, STICK_DEFAULT_MAX_US },
+};
+static FxStickMap turnMap  = fxStickMapRange(1000, 1500, 2000, -127, 127);
+static FxStickMap driveMap = fxStickMapRange(1000, 1500, 2000, -127, 127);
+static FxStickMap domeMap  = fxStickMapRange(1000, 1500, 2000, -100, 100);
+
+// ==========================
+//       INTERNAL STATE
+// ==========================
+static const DriveProfile* activeProfile = NULL;
+DriveInputs driveInputs;
+DriveGovernor driveGovernor = { Q8_8_ONE, 0 };
+
+static int domeInput = 0;
+static int currentDomeSpeed = 0;
+static int lastSentDomeSpeed = 0;
+
+static int lastDrive = 0;
+static int lastTurn  = 0;
+static int savedTurnSpeed = 0;
+static int governedDrive = 0;          // Outputs after the governor, last tick
+static int governedTurn  = 0;
+
+static unsigned long lastDriveCommandTime = 0;
+static unsigned long lastTurnCommandTime  = 0;
+
+static unsigned long domeStartTime = 0;
+static bool domeFlickActive = false;
+static bool wasTurnInputActive = false;
+static bool lastKillState = false;
+static bool lastLinkLost = false;
+static bool driveHold = false;
+
+// Cleared by a profile swap, set again once each stick is centred
+static bool driveArmed = false;
+static bool turnArmed  = false;
+static bool domeArmed  = false;
+
+// ==========================
+//       CALIBRATION
+// ==========================
+static FxStickMap buildStickMap(uint8_t axis, int outLow, int outHigh) {
+  const StickCalibration &c = stickCal[axis];
+  return fxStickMapRange(c.minUs, c.centerUs, c.maxUs, outLow, outHigh);
+}
+
+// Dome gains fold into the slopes: one multiply less per frame
+static void buildDomeMap() {
+  q8_8_t left  = activeProfile ? activeProfile->domeLeftGain  : Q8_8_ONE;
+  q8_8_t right = activeProfile ? activeProfile->domeRightGain : Q8_8_ONE;
+  domeMap = buildStickMap(STICK_DOME, -fxScale(100, left), fxScale(100, right));
+}
+
+void setStickCalibration(uint8_t axis, const StickCalibration &cal) {
+  if (axis >= STICK_AXIS_COUNT) return;
+  stickCal[axis] = cal;
+  if (axis == STICK_TURN)  turnMap  = buildStickMap(STICK_TURN, -127, 127);
+  if (axis == STICK_DRIVE) driveMap = buildStickMap(STICK_DRIVE, -127, 127);
+  if (axis == STICK_DOME)  buildDomeMap();
+}
+
+const StickCalibration& getStickCalibration(uint8_t axis) {
+  return stickCal[axis < STICK_AXIS_COUNT ? axis : 0];
+}
+
+void setDriveHold(bool hold) {
+  driveHold = hold;
+  driveArmed = turnArmed = domeArmed = false;   // Sticks go back to centre before they drive
+}
+
+// ==========================
+//       LIVE TUNING
+// ==========================
+void readProfileTuning(const DriveProfile &p, ProfileTuning &t) {
+  t.expoCurve      = p.driveCurve->curve;
+  t.speedLimit     = p.driveCurve->limit;
+  t.deadZone       = p.deadZone;
+  t.taperFallRate  = p.taperFallRate;
+  t.domeSpeedLimit = p.domeCurve ? p.domeCurve->limit : 0;
+  t.domeDeadZone   = p.domeDeadZone;
+  t.domeLeftGain   = p.domeLeftGain;
+  t.domeRightGain  = p.domeRightGain;
+}
+
+void writeProfileTuning(DriveProfile &p, const ProfileTuning &t) {
+  p.deadZone      = t.deadZone;
+  p.taperFallRate = t.taperFallRate;
+  p.taperMap      = fxMapRange(0, t.speedLimit, 5, t.taperFallRate);
+  p.domeDeadZone  = t.domeDeadZone;
+  p.domeLeftGain  = t.domeLeftGain;
+  p.domeRightGain = t.domeRightGain;
+  if (&p == activeProfile) buildDomeMap();
+}
+
+// ==========================
+//     PROFILE SELECTION
+// ==========================
+void selectDriveProfile(const DriveProfile* profile) {
+  activeProfile = profile;
+  buildDomeMap();
+
+  lastDrive = lastTurn = savedTurnSpeed = 0;
+  governedDrive = governedTurn = 0;
+  driveGovernor.scale = Q8_8_ONE;
+  driveGovernor.maxStep = 0;
+  domeInput = currentDomeSpeed = lastSentDomeSpeed = 0;
+  domeFlickActive = false;
+  driveInputs.drive = driveInputs.turn = driveInputs.dome = 0;
+  wasTurnInputActive = false;
+  lastKillState = false;
+  lastLinkLost = inputFrame.linkLost;
+  lastDriveCommandTime = lastTurnCommandTime = millis();
+
+  driveArmed = turnArmed = domeArmed = false;
+  stopAllMotors();  // Stop packets go out ahead of anything queued by the old mode
+
+  if (profile && LOG_ENABLED(DRIVE, LOG_INFO)) {
+    usbLog.print(F("[DRIVE] Profile: "));
+    usbLog.println(profile->name);
+  }
+}
+
+const DriveProfile* activeDriveProfile() {
+  return activeProfile;
+}
+
+void setDriveGovernor(q8_8_t scale, uint8_t maxStep) {
+  driveGovernor.scale = scale;
+  driveGovernor.maxStep = maxStep;
+}
+
+bool isDriveKillActive() {
+  return activeProfile && (lastKillState || driveHold);
+}
+
+// ==========================
+//         HELPERS
+// ==========================
+static int taperToZero(const DriveProfile* p, int value) {
+  return fxTaperToZero(value, fxMap(p->taperMap, abs(value)));
+}
+
+// Scale, then let |output| grow by at most maxStep; shrinking is immediate
+static int governOutput(int target, int previous) {
+  if (driveGovernor.scale != Q8_8_ONE) target = fxScale(target, driveGovernor.scale);
+  int step = driveGovernor.maxStep;
+  if (!step) return target;
+  if (target > 0 && target > previous) return min(target, max(previous, 0) + step);
+  if (target < 0 && target < previous) return max(target, min(previous, 0) - step);
+  return target;
+}
+
+// Holds an axis at 0 until its input has been centred once
+static bool rearm(bool &armed, int input) {
+  if (!armed && abs(input) <= DRIVE_REARM_WINDOW) armed = true;
+  return armed;
+}
+
+// ==========================
+//        CONTROL TICK
+// ==========================
+void updateDriveController() {
+  const DriveProfile* p = activeProfile;
+  if (!p) return;
+
+  unsigned long now = millis();
+
+  // === Read + Map (calibrated) ===
+  int mappedTurn  = fxStickMap(turnMap,  inputFrame.width[PWM_CH1A]);
+  int mappedDrive = fxStickMap(driveMap, inputFrame.width[PWM_CH2A]);
+
+  // === Deadzones + Turn Cap ===
+  if (abs(mappedDrive) <= p->deadZone) mappedDrive = 0;
+  if (abs(mappedTurn)  <= p->deadZone) mappedTurn  = 0;
+  if (abs(mappedDrive) > p->turnCapDrive) mappedTurn = constrain(mappedTurn, -p->turnCap, p->turnCap);
+
+  // === Response Curve ===
+  int curvedDrive = applyResponseCurve(*p->driveCurve, mappedDrive);
+  int curvedTurn  = applyResponseCurve(*p->driveCurve, mappedTurn);
+
+  // === Drive / Turn Logic ===
+  lastDrive = curvedDrive;
+  if (inputFrame.fresh[PWM_CH2A]) lastDriveCommandTime = now;
+
+  if (mappedTurn == 0 && wasTurnInputActive && p->taperTurn) {
+    lastTurn = taperToZero(p, lastTurn != 0 ? lastTurn : savedTurnSpeed);
+  } else if (mappedTurn == 0) {
+    lastTurn = 0;
+  } else {
+    savedTurnSpeed = curvedTurn;
+    lastTurn = curvedTurn;
+    if (inputFrame.fresh[PWM_CH1A]) lastTurnCommandTime = now;
+  }
+
+  wasTurnInputActive = (mappedTurn != 0);
+
+  // === Kill Switch ===
+  bool killActive = isComboModeActive(p->killCombo);
+  if (killActive != lastKillState) {
+    if (LOG_ENABLED(DRIVE, LOG_INFO)) usbLog.println(killActive ? F("[KILL SWITCH ACTIVE]") : F("[KILL SWITCH RELEASED]"));
+    logTelemetryEvent(TELEMETRY_EVENT_KILL, killActive);
+    lastKillState = killActive;
+  }
+
+  if (killActive || driveHold) {
+    lastDrive = 0;
+    lastTurn = 0;
+  }
+
+  // === Dome Logic (with Flick Control) ===
+  if (p->domeCurve) {
+    domeInput = fxStickMap(domeMap, inputFrame.width[PWM_CH1B]);   // Gains are in the slopes
+
+    int rawCurvedDome = applyResponseCurve(*p->domeCurve, domeInput);
+    int curvedDome = domeFlickActive ? rawCurvedDome : rawCurvedDome * p->fineControlMultiplier;
+    if (killActive || driveHold) curvedDome = 0;
+
+    if (abs(domeInput) < p->domeDeadZone) {
+      currentDomeSpeed = 0;
+      if (domeFlickActive && (now - domeStartTime < p->domeFlickMinDuration)) {
+        currentDomeSpeed = constrain(lastSentDomeSpeed, -p->maxFlickSpeed, p->maxFlickSpeed);
+      } else {
+        domeFlickActive = false;
+      }
+    } else {
+      currentDomeSpeed = curvedDome;
+      if (abs(curvedDome) >= p->domeFlickThreshold) {
+        domeStartTime = now;
+        domeFlickActive = true;
+      }
+    }
+
+    if (!rearm(domeArmed, domeInput)) currentDomeSpeed = 0;
+  }
+
+  // === Held Until Centred After a Profile Swap ===
+  if (!rearm(driveArmed, mappedDrive)) lastDrive = 0;
+  if (!rearm(turnArmed,  mappedTurn))  lastTurn  = 0;
+
+  // === Safety Timeout ===
+  if (now - lastDriveCommandTime > p->motorTimeoutMs) lastDrive = 0;
+  if (now - lastTurnCommandTime  > p->motorTimeoutMs) lastTurn  = 0;
+
+  // === Link Loss ===
+  if (inputFrame.linkLost != lastLinkLost) {
+    if (LOG_ENABLED(DRIVE, LOG_WARN)) usbLog.println(inputFrame.linkLost ? F("[LINK LOST] Motors stopped.") : F("[LINK RESTORED]"));
+    logTelemetryEvent(TELEMETRY_EVENT_LINK, inputFrame.linkLost);
+    lastLinkLost = inputFrame.linkLost;
+  }
+  if (inputFrame.linkLost) {
+    lastDrive = lastTurn = savedTurnSpeed = 0;
+    wasTurnInputActive = false;
+    driveArmed = turnArmed = domeArmed = false;   // Centre the sticks once it is back
+  }
+  if (p->domeCurve && !inputFrame.valid[PWM_CH1B]) {
+    currentDomeSpeed = 0;
+    domeFlickActive = false;
+    domeArmed = false;
+  }
+
+  // === Motor Outputs ===
+  governedDrive = governOutput(lastDrive, governedDrive);
+  governedTurn  = governOutput(lastTurn,  governedTurn);
+  setDrivePower(governedDrive);
+  setTurnPower(governedTurn);
+
+  if (p->domeCurve && currentDomeSpeed != lastSentDomeSpeed) {
+    setDomePower(currentDomeSpeed);
+    lastSentDomeSpeed = currentDomeSpeed;
+  }
+
+  // === Telemetry (the old per-frame debug line) ===
+  driveInputs.drive = mappedDrive;
+  driveInputs.turn  = mappedTurn;
+  driveInputs.dome  = p->domeCurve ? domeInput : 0;
+}
@@ -0,0 +1,119 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║               DriveController.h - Shadow-RC                ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the shared drive + dome stick pipeline.         ║
+  ║ Manual, Carpet and Hybrid Mode each hand it a profile;     ║
+  ║ switching modes just swaps the active profile.             ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing how sticks are shaped. ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef DRIVE_CONTROLLER_H
+#define DRIVE_CONTROLLER_H
+
+#include <Arduino.h>
+#include "ResponseCurve.h"
+#include "FixedPoint.h"
+
+// Everything a mode tunes; built once at boot by each mode file
+struct DriveProfile {
+  const char*          name;
+
+  // --- Drive + Turn ---
+  ResponseCurve*       driveCurve;     // expoCurve + speedLimit table (drive and turn)
+  int                  deadZone;       // |stick| at or below this reads 0
+  int                  turnCapDrive;   // While |drive| is above this...
+  int                  turnCap;        // ...|turn| is capped to this
+  bool                 taperTurn;      // true = turn tapers off on release, false = stops at once
+  int                  taperFallRate;  // Taper step at full speed...
+  FxMap                taperMap;       // ...as |turn| → taper step per tick
+  unsigned long        motorTimeoutMs; // Drive/turn stop if no command for this long
+  int                  killCombo;      // isComboModeActive(killCombo) zeroes every output
+
+  // --- Dome (CH1B stick); domeCurve NULL = the mode drives the dome itself ---
+  ResponseCurve*       domeCurve;      // expoCurve + domeSpeedLimit table
+  int                  domeDeadZone;
+  int                  fineControlMultiplier;
+  q8_8_t               domeLeftGain;
+  q8_8_t               domeRightGain;
+  unsigned long        domeFlickMinDuration;
+  int                  domeFlickThreshold;
+  int                  maxFlickSpeed;
+};
+
+// Last tick's sticks after map + deadzone (outputs are on the motor bus)
+struct DriveInputs {
+  int drive;
+  int turn;
+  int dome;                            // 0 when the profile has no dome table
+};
+
+extern DriveInputs driveInputs;
+
+// Scales drive + turn after the response curve and caps how fast either
+// output may grow. Carpet Mode's traction control sets it from the
+// 2x32's motor current; a profile swap turns it off again.
+struct DriveGovernor {
+  q8_8_t  scale;                       // Q8_8_ONE = the profile's own speed limit
+  uint8_t maxStep;                     // Largest |output| increase per tick, 0 = no limit
+};
+
+extern DriveGovernor driveGovernor;
+
+// ---------- Profile Selection ----------
+// Takes effect on the next updateDriveController(). Stops every motor and
+// holds each axis at 0 until its stick has been back at neutral once.
+// NULL = no drive profile (Automated Mode).
+void selectDriveProfile(const DriveProfile* profile);
+const DriveProfile* activeDriveProfile();
+
+// ---------- Control Tick ----------
+void updateDriveController();   // Stick → shape → setDrivePower/TurnPower/DomePower
+bool isDriveKillActive();       // Kill combo seen by the last update, or a drive hold
+void setDriveGovernor(q8_8_t scale, uint8_t maxStep);   // From the next update; slowing down is never limited
+
+// ---------- Stick Calibration ----------
+// Measured by `cal` (TuningStore.cpp). Each axis maps its own min /
+// centre / max to full stick / 0, built into integer slopes once.
+#define STICK_DEFAULT_MIN_US     1000
+#define STICK_DEFAULT_CENTER_US  1500
+#define STICK_DEFAULT_MAX_US     2000
+
+enum StickAxis {
+  STICK_TURN = 0,          // CH1A
+  STICK_DRIVE,             // CH2A
+  STICK_DOME,              // CH1B
+  STICK_AXIS_COUNT
+};
+
+struct StickCalibration {
+  int16_t minUs;
+  int16_t centerUs;
+  int16_t maxUs;
+};
+
+void setStickCalibration(uint8_t axis, const StickCalibration &cal);   // Rebuilds that axis' map
+const StickCalibration& getStickCalibration(uint8_t axis);
+void setDriveHold(bool hold);   // true = every output 0, sticks re-centred after (calibration sweep)
+
+// ---------- Live Tuning ----------
+// What `tune` changes on a profile (TuningStore.cpp keeps it in EEPROM)
+struct ProfileTuning {
+  float   expoCurve;
+  int16_t speedLimit;
+  int16_t deadZone;
+  int16_t taperFallRate;
+  int16_t domeSpeedLimit;    // Profiles with a dome table only
+  int16_t domeDeadZone;
+  q8_8_t  domeLeftGain;
+  q8_8_t  domeRightGain;
+};
+
+void readProfileTuning(const DriveProfile &p, ProfileTuning &t);
+// Everything but the curve tables: TuningStore rebuilds those in the
+// background and swaps them in whole
+void writeProfileTuning(DriveProfile &p, const ProfileTuning &t);
+
+#endif
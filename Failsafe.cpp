@@ -0,0 +1,218 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                    Failsafe.cpp - Shadow-RC System                 ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Bounds the time from a frozen loop() to stopped motors. A stuck    ║
+  ║ call (a blocking print, a library delay) used to leave the last    ║
+  ║ drive command latched in the Sabertooth until its own 500 ms       ║
+  ║ serial timeout, and the droid never came back without a reset.     ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - `armFailsafe()` (end of setup) starts the AVR watchdog in
+    interrupt + reset mode at `FAILSAFE_WATCHDOG_TIMEOUT`. Only
+    `feedFailsafe()` at the end of the control tick resets it, so a
+    background task or ISR that keeps the tick from running trips it
+    just the same as a stuck tick.
+  - Missed feed: the watchdog interrupt stamps a marker in .noinit RAM
+    (it survives the reset) and shortens the watchdog to 16 ms. If the
+    tick comes back inside those 16 ms it re-arms and counts a "late
+    feed"; otherwise the Mega resets.
+  - Boot: MCUSR is copied and cleared in .init3, before the C runtime,
+    and the watchdog is turned off there (after a watchdog reset it
+    stays on at 16 ms). `setupFailsafe()` runs first in setup(): for
+    anything but a power-on the drivers kept power and may still hold
+    the old command, so stop packets for drive, turn and dome go out
+    before anything else is set up.
+  - The cause is counted in EEPROM at `FAILSAFE_EEPROM_ADDRESS`. Some
+    bootloaders clear MCUSR before the sketch runs; the .noinit marker
+    still tells a watchdog reset apart, but a power-on then reads as
+    "external".
+  - The drivers' own serial timeout (`MOTOR_BUS_TIMEOUT_MS`, 200 ms)
+    is the backstop if the Mega never comes back: it must stay above
+    two keepalives and above the watchdog path below.
+
+  STALL → MOTORS STOPPED (defaults, 9600 baud bus):
+  ─────────────────────────────────────────────────────────────────────
+    watchdog interrupt   128 ms nominal, allow +10 %   ≤ 141 ms
+    reset                16 ms watchdog after the ISR  ≤  18 ms
+    bootloader + init    straight to the sketch on a
+                         watchdog reset                ≈   1 ms
+    stop packets         drive, turn, dome (4.2 each)  ≤  13 ms
+    ────────────────────────────────────────────────────────────
+    worst case                                         ≈ 173 ms
+  A bootloader that waits for an upload after every reset adds its
+  wait; the driver timeout then stops the motors, ≤ 200 ms after the
+  stall. `make check` in Tools/HostSim measures the watchdog path.
+
+  READ BACK:
+  ─────────────────────────────────────────────────────────────────────
+  `stats` shows the reset counts per cause, this boot's cause, the
+  worst gap between two feeds and the late feeds. `reset` clears the
+  gap counters; `reset resets` zeroes the EEPROM counts as well.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `Failsafe.cpp`
+  Header:    `Failsafe.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "Failsafe.h"
+#include "MotorBus.h"
+#include <Arduino.h>
+#include <EEPROM.h>
+
+#if MOTOR_BUS_TIMEOUT_MS < 2 * MOTOR_BUS_KEEPALIVE_MS
+#error "MOTOR_BUS_TIMEOUT_MS must cover two keepalives or the drivers stop on a healthy bus"
+#endif
+#if MOTOR_BUS_TIMEOUT_MS < FAILSAFE_WATCHDOG_MS * 11 / 10 + 32
+#error "MOTOR_BUS_TIMEOUT_MS must outlast the watchdog path (see Failsafe.cpp)"
+#endif
+
+#define RESET_COUNTERS_MAGIC  0x5253      // "RS"
+#define WATCHDOG_BITE_MARKER  0xB17E
+
+struct ResetCounters {
+  uint16_t magic;
+  uint16_t counts[RESET_CAUSE_COUNT];
+};
+
+FailsafeStats failsafeStats;
+
+// Left alone by the C runtime, so both survive a reset
+static uint8_t           resetFlags  __attribute__((section(".noinit")));
+static volatile uint16_t biteMarker  __attribute__((section(".noinit")));
+
+static bool          armed = false;
+static unsigned long lastFeedUs = 0;
+
+static const char causePowerOn[]  PROGMEM = "power-on";
+static const char causeExternal[] PROGMEM = "external";
+static const char causeBrownOut[] PROGMEM = "brown-out";
+static const char causeWatchdog[] PROGMEM = "watchdog";
+
+static const char* const causeNames[RESET_CAUSE_COUNT] PROGMEM = {
+  causePowerOn, causeExternal, causeBrownOut, causeWatchdog
+};
+
+// ==========================
+//        EARLY BOOT
+// ==========================
+#if defined(__AVR__)
+// Before .data / .bss are set up: a watchdog reset leaves the watchdog
+// running at 16 ms, too short to reach setup()
+void failsafeEarlyBoot() __attribute__((naked, used, section(".init3")));
+void failsafeEarlyBoot() {
+  resetFlags = MCUSR;
+  MCUSR = 0;
+  wdt_disable();
+}
+#endif
+
+static uint8_t classifyReset(uint8_t flags) {
+  if (flags & _BV(PORF)) return RESET_POWER_ON;
+  if (flags & _BV(BORF)) return RESET_BROWN_OUT;
+  if ((flags & _BV(WDRF)) || biteMarker == WATCHDOG_BITE_MARKER) return RESET_WATCHDOG;
+  return RESET_EXTERNAL;
+}
+
+// ==========================
+//        SETUP
+// ==========================
+void setupFailsafe() {
+#if !defined(__AVR__)
+  resetFlags = MCUSR;                // Host build: no .init3
+  MCUSR = 0;
+  wdt_disable();
+#endif
+  uint8_t cause = classifyReset(resetFlags);
+  biteMarker = 0;
+
+  // The drivers did not restart with us: stop them before anything else
+  if (cause != RESET_POWER_ON) sendBootStop();
+
+  ResetCounters counters;
+  EEPROM.get(FAILSAFE_EEPROM_ADDRESS, counters);
+  if (counters.magic != RESET_COUNTERS_MAGIC) memset(&counters, 0, sizeof(counters));
+  counters.magic = RESET_COUNTERS_MAGIC;
+  if (counters.counts[cause] < 0xFFFF) counters.counts[cause]++;
+  EEPROM.put(FAILSAFE_EEPROM_ADDRESS, counters);
+
+  memset(&failsafeStats, 0, sizeof(failsafeStats));
+  failsafeStats.resetCause = cause;
+  memcpy(failsafeStats.resets, counters.counts, sizeof(failsafeStats.resets));
+
+  Serial.print(F("[FAILSAFE] Reset: "));
+  Serial.print(resetCauseName(cause));
+  if (cause != RESET_POWER_ON) Serial.print(F(" (motors stopped)"));
+  Serial.print(F(" | watchdog resets: "));
+  Serial.println(counters.counts[RESET_WATCHDOG]);
+}
+
+void armFailsafe() {
+  noInterrupts();
+  wdt_reset();
+  wdt_enable(FAILSAFE_WATCHDOG_TIMEOUT);
+  WDTCSR |= _BV(WDIE);               // Interrupt first, reset on the next timeout
+  interrupts();
+  lastFeedUs = micros();
+  armed = true;
+}
+
+// ==========================
+//        CONTROL TICK
+// ==========================
+void feedFailsafe() {
+  if (!armed) return;
+  wdt_reset();
+
+  unsigned long now = micros();
+  unsigned long gap = now - lastFeedUs;
+  lastFeedUs = now;
+  if (gap > failsafeStats.worstFeedGapUs) failsafeStats.worstFeedGapUs = gap;
+
+  // The ISR ran and left 16 ms on the clock: back to the full timeout
+  if (!(WDTCSR & _BV(WDIE))) {
+    noInterrupts();
+    wdt_enable(FAILSAFE_WATCHDOG_TIMEOUT);
+    WDTCSR |= _BV(WDIE);
+    biteMarker = 0;
+    interrupts();
+    failsafeStats.lateFeeds++;
+  }
+}
+
+// ==========================
+//        ISR
+// ==========================
+// The tick missed the whole timeout. Mark it for the next boot and
+// shorten the grace: the reset comes 16 ms from now unless it is fed.
+ISR(WDT_vect) {
+  biteMarker = WATCHDOG_BITE_MARKER;
+  wdt_enable(WDTO_15MS);
+}
+
+// ==========================
+//        STATISTICS
+// ==========================
+const __FlashStringHelper* resetCauseName(uint8_t cause) {
+  if (cause >= RESET_CAUSE_COUNT) return F("?");
+  return (const __FlashStringHelper*)pgm_read_ptr(&causeNames[cause]);
+}
+
+void resetFailsafeStats() {
+  failsafeStats.worstFeedGapUs = 0;
+  failsafeStats.lateFeeds = 0;
+}
+
+void clearResetCounters() {
+  ResetCounters counters;
+  memset(&counters, 0, sizeof(counters));
+  counters.magic = RESET_COUNTERS_MAGIC;
+  EEPROM.put(FAILSAFE_EEPROM_ADDRESS, counters);
+  memset(failsafeStats.resets, 0, sizeof(failsafeStats.resets));
+}
@@ -0,0 +1,56 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                  Failsafe.h - Shadow-RC                    ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the watchdog failsafe. Only the control tick    ║
+  ║ feeds the AVR watchdog; a stalled loop resets the Mega,    ║
+  ║ and the first thing a reset boot does is stop the motors.  ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing stop timing.           ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef FAILSAFE_H
+#define FAILSAFE_H
+
+#include <Arduino.h>
+#include <avr/wdt.h>
+
+// ---------- Watchdog ----------
+// Control tick silent this long → watchdog interrupt, then a reset 16 ms later.
+// Longest normal gap between ticks is a blocked USB print (~15 ms).
+#define FAILSAFE_WATCHDOG_TIMEOUT   WDTO_120MS
+#define FAILSAFE_WATCHDOG_MS        (16UL << FAILSAFE_WATCHDOG_TIMEOUT)   // Nominal: 128 ms
+
+// ---------- Reset Counters ----------
+// Kept in EEPROM so they survive a battery swap (bytes 0–9)
+#define FAILSAFE_EEPROM_ADDRESS     0
+
+enum ResetCause {
+  RESET_POWER_ON = 0,      // Power switch / battery; the drivers restarted too
+  RESET_EXTERNAL,          // Reset button, USB upload, or a bootloader that cleared MCUSR
+  RESET_BROWN_OUT,         // Supply sagged below the brown-out level
+  RESET_WATCHDOG,          // Control tick stalled
+  RESET_CAUSE_COUNT
+};
+
+struct FailsafeStats {
+  uint8_t       resetCause;                  // ResetCause of this boot
+  uint16_t      resets[RESET_CAUSE_COUNT];   // Boots per cause since `reset resets`
+  unsigned long worstFeedGapUs;              // Longest time between two control ticks
+  unsigned long lateFeeds;                   // Watchdog interrupt fired, tick came back before the reset
+};
+
+extern FailsafeStats failsafeStats;
+
+// ---------- Setup & Loop ----------
+void setupFailsafe();          // First in setup(): stop packets after a reset, count the cause
+void armFailsafe();            // Last in setup(): watchdog on
+void feedFailsafe();           // End of every control tick, nowhere else
+
+// ---------- Statistics ----------
+const __FlashStringHelper* resetCauseName(uint8_t cause);
+void resetFailsafeStats();     // Feed-gap counters (not the reset counts)
+void clearResetCounters();     // Zero the EEPROM reset counts
+
+#endif
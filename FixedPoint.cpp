@@ -0,0 +1,125 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                  FixedPoint.cpp - Shadow-RC System                 ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Integer replacements for the float math every mode used to run    ║
+  ║ each control tick. The Mega has no FPU: every float multiply,     ║
+  ║ divide or float → int conversion is a soft-float library call.   ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - Stick shaping: `FxMap` holds a `constrain()` + `map()` pair with
+    its slope precomputed in Q16.16, so each frame is one 32-bit
+    multiply and a shift instead of `map()`'s 32-bit division.
+  - Dome gains and trims are Q8.8 (`Q8_8(1.06)` = 271/256).
+  - Hybrid Mode's dome timing (`pow(speedRatio, 1.4)` per move) is a
+    Q16.16 ms-per-degree table built when the mode starts.
+  - The only floats left are the tunables the response tables and the
+    dome timing table are built from, outside the control tick.
+
+  ROUNDING:
+  ─────────────────────────────────────────────────────────────────────
+  `fxMap()` and `fxScale()` round to nearest. `map()` truncated, which
+  made 1499 µs read as -1 but 1501 µs as 0; now both sides of centre
+  read 0. Full stick still maps to exactly ±127.
+
+  BENCHMARK:
+  ─────────────────────────────────────────────────────────────────────
+  Set `FIXED_POINT_BENCHMARK` to 1 in `FixedPoint.h` and the boot log
+  shows the cycle cost of one shaping pass (drive, turn, dome, one
+  dome timing step) on the old float path and on this one.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `FixedPoint.cpp`
+  Header:    `FixedPoint.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "FixedPoint.h"
+#include "ResponseCurve.h"
+#include <Arduino.h>
+
+// ==========================
+//        BENCHMARK
+// ==========================
+#define BENCHMARK_PASSES  200
+
+// Volatile so the compiler cannot fold the work away
+static volatile int   benchInput = 1730;
+static volatile int   benchSink  = 0;
+static volatile float benchCurve = 1.3;
+static volatile float benchGain  = 1.00;
+static volatile int   benchSpeed = 27;
+
+// The per-frame math as it was: map() + float gain + pow() curves + dome timing
+static void floatShapingPass() {
+  int raw   = benchInput;
+  float curve = benchCurve;
+
+  int drive = map(constrain(raw, 1000, 2000), 1000, 2000, -127, 127);
+  int turn  = map(constrain(3000 - raw, 1000, 2000), 1000, 2000, -127, 127);
+  int dome  = map(constrain(raw, 1500, 2000), 1500, 2000, 0, 100) * benchGain;
+
+  int out = 0;
+  int in[3] = { drive, turn, dome };
+  for (uint8_t i = 0; i < 3; i++) {
+    float normalized = abs(in[i]) / 127.0;
+    int shaped = pow(normalized, curve) * 60;
+    out += (in[i] < 0) ? -shaped : shaped;
+  }
+
+  float msPerDegree = (1700.0 / 90.0) * pow(30 / (float)benchSpeed, 1.4) * 1.06;
+  unsigned long duration = (unsigned long)(45 * msPerDegree);
+  out += (int)((float)duration / msPerDegree);
+
+  benchSink = out;
+}
+
+static const FxMap benchStick = fxMapRange(1000, 2000, -127, 127);
+static const FxMap benchDome  = fxMapRange(1500, 2000, 0, 100);
+static const q8_8_t benchGainQ = Q8_8(1.00);
+static ResponseCurve benchTable(1.3, 60);
+static q16_16_t benchMsPerDegree = Q16_16(1700.0 / 90.0);
+
+static void fixedShapingPass() {
+  int raw = benchInput;
+
+  int drive = fxMap(benchStick, raw);
+  int turn  = fxMap(benchStick, 3000 - raw);
+  int dome  = fxScale(fxMap(benchDome, raw), benchGainQ);
+
+  int out = applyResponseCurve(benchTable, drive)
+          + applyResponseCurve(benchTable, turn)
+          + applyResponseCurve(benchTable, dome);
+
+  q16_16_t msPerDegree = fxScale32(benchMsPerDegree, Q8_8(1.06));
+  unsigned long duration = fxMulInt(45, msPerDegree);
+  out += (int)((duration << 16) / msPerDegree);
+
+  benchSink = out;
+}
+
+static unsigned long cyclesPerPass(void (*pass)()) {
+  unsigned long start = micros();
+  for (int i = 0; i < BENCHMARK_PASSES; i++) pass();
+  unsigned long elapsed = micros() - start;
+  return elapsed * (F_CPU / 1000000UL) / BENCHMARK_PASSES;
+}
+
+void benchmarkFixedPoint() {
+  unsigned long floatCycles = cyclesPerPass(floatShapingPass);
+  unsigned long fixedCycles = cyclesPerPass(fixedShapingPass);
+
+  Serial.println(F("=== Shaping pass (cycles, 16 cycles = 1 us) ==="));
+  Serial.print(F("Float path: "));
+  Serial.print(floatCycles);
+  Serial.print(F(" | Fixed path: "));
+  Serial.print(fixedCycles);
+  Serial.print(F(" | Saved per tick: "));
+  Serial.print((long)(floatCycles - fixedCycles) / 16);
+  Serial.println(F(" us"));
+}
@@ -0,0 +1,117 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                  FixedPoint.h - Shadow-RC                  ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Q8.8 / Q16.16 integer math for the control tick.           ║
+  ║ map / constrain / gain / taper helpers that never touch    ║
+  ║ the AVR soft-float library.                                ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing the shaping math.      ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <Arduino.h>
+
+// ---------- Benchmark ----------
+#define FIXED_POINT_BENCHMARK  0   // 1 = print float vs fixed-point cycle counts at boot
+
+// ---------- Types ----------
+typedef int16_t q8_8_t;     // 8 integer bits . 8 fraction bits   (gains, trims)
+typedef int32_t q16_16_t;   // 16 integer bits . 16 fraction bits (slopes, ms per degree)
+
+#define Q8_8_ONE     256
+#define Q16_16_ONE   65536L
+
+// Constants only: the float is folded by the compiler, nothing runs at runtime
+#define Q8_8(x)      ((q8_8_t)((x) * 256.0 + 0.5))
+#define Q16_16(x)    ((q16_16_t)((x) * 65536.0 + 0.5))
+
+// A constrain() + map() pair with the division done once, up front
+struct FxMap {
+  int      inMin;
+  int      inMax;
+  int      outMin;
+  q16_16_t slope;           // (outMax - outMin) / (inMax - inMin)
+};
+
+// A calibrated stick: its own centre reads 0, each side has its own slope
+struct FxStickMap {
+  int      inMin;
+  int      center;
+  int      inMax;
+  q16_16_t slopeLow;        // |outLow| / (center - inMin)
+  q16_16_t slopeHigh;       // outHigh / (inMax - center)
+};
+
+// ---------- Building (one 32-bit division; at boot or when tuning changes) ----------
+static inline FxMap fxMapRange(int inMin, int inMax, int outMin, int outMax) {
+  FxMap m;
+  long inSpan = (long)inMax - inMin;
+  m.inMin  = inMin;
+  m.inMax  = inMax;
+  m.outMin = outMin;
+  m.slope  = inSpan ? (((long)outMax - outMin) * Q16_16_ONE + inSpan / 2) / inSpan : 0;
+  return m;
+}
+
+// outLow <= 0 <= outHigh; gains and trims fold into them here, not per frame
+static inline FxStickMap fxStickMapRange(int inMin, int center, int inMax, int outLow, int outHigh) {
+  FxStickMap m;
+  long lowSpan = (long)center - inMin, highSpan = (long)inMax - center;
+  m.inMin     = inMin;
+  m.center    = center;
+  m.inMax     = inMax;
+  m.slopeLow  = lowSpan  > 0 ? ((long)-outLow * Q16_16_ONE + lowSpan / 2) / lowSpan : 0;
+  m.slopeHigh = highSpan > 0 ? ((long)outHigh * Q16_16_ONE + highSpan / 2) / highSpan : 0;
+  return m;
+}
+
+// ---------- Per-frame helpers (multiply + shift only) ----------
+// constrain(x, inMin, inMax) then map() to the output range. Rounds to
+// nearest instead of truncating, so a stick at centre maps to exactly 0
+// from either side.
+static inline int fxMap(const FxMap &m, int x) {
+  if (x < m.inMin) x = m.inMin;
+  if (x > m.inMax) x = m.inMax;
+  return m.outMin + (int)(((long)(x - m.inMin) * m.slope + Q16_16_ONE / 2) >> 16);
+}
+
+// One side of centre, one clamp: cheaper than fxMap() and exactly 0 at
+// the calibrated centre; rounds half away from it on both sides
+static inline int fxStickMap(const FxStickMap &m, int x) {
+  if (x < m.center) {
+    if (x < m.inMin) x = m.inMin;
+    return -(int)(((long)(m.center - x) * m.slopeLow + Q16_16_ONE / 2) >> 16);
+  }
+  if (x > m.inMax) x = m.inMax;
+  return (int)(((long)(x - m.center) * m.slopeHigh + Q16_16_ONE / 2) >> 16);
+}
+
+// value * gain, rounded to nearest (|value| * gain must fit in 31 bits)
+static inline int fxScale(int value, q8_8_t gain) {
+  return (int)(((long)value * gain + Q8_8_ONE / 2) >> 8);
+}
+
+static inline long fxScale32(long value, q8_8_t gain) {
+  return (value * gain + Q8_8_ONE / 2) >> 8;
+}
+
+// Whole units * Q16.16, truncated (|value| * q must fit in 31 bits)
+static inline long fxMulInt(long value, q16_16_t q) {
+  return (value * q) >> 16;
+}
+
+// Steps value toward zero by rate without crossing it
+static inline int fxTaperToZero(int value, int rate) {
+  if (value > 0) return (value > rate) ? value - rate : 0;
+  if (value < 0) return (value < -rate) ? value + rate : 0;
+  return 0;
+}
+
+// ---------- Benchmark ----------
+void benchmarkFixedPoint();  // Prints cycles per shaping pass, float vs fixed
+
+#endif
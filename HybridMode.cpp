@@ -14,6 +14,8 @@
        - CH2A = Forward/back
        - CH1A = Turn left/right
   - Dome automation with randomized angles, timing, and speed
+  - Controller B dome stick (CH1B) takes the dome over at any time;
+    automation resumes `domeOverrideHoldMs` after the stick is released
   - Optional random MP3 playback using sound banks
   - Kill switch (Combo Mode 3) disables all automation + sounds
   - Expo curve for natural joystick feel and smoother steering
@@ -52,9 +54,17 @@
       The dome will pick a random rotation angle within this range.
       Movement alternates left/right and returns to center when done.
 
-  - `domeMinSpeedPercent` / `domeMaxSpeedPercent`:
-      Sets the PWM speed range for dome motion (0–100%).
-      Higher speeds create sharper, snappier dome moves.
+  - `domeSequenceMinSpeed` / `domeSequenceMaxSpeed`:
+      Each sequence picks its power cap (0–127) from this range.
+      Higher caps create sharper, snappier dome moves.
+
+  - Each move is an absolute angle from home, driven there on the
+    dome encoder (`DomePosition.cpp`), so "return to center" lands
+    on center after any number of moves.
+
+  - `domeOverrideDeadband` / `domeOverrideSpeed`:
+      How far (µs) the dome stick must leave center to take over, and
+      the dome power at full stick while it does.
 
   -- MP3 PLAYBACK (OPTIONAL) --
   - `DISABLE_MP3`:
@@ -69,17 +79,24 @@
       Prevents random sound triggers when MarcDuino is active (e.g. Full Awake Mode).
       Ensures no interference between manual and scripted sequences.
 
+  - `MP3_PRIORITY_AMBIENT` (MP3Handler.h):
+      Random sounds only start into silence; one that would cut a button
+      sound or a Dance / Singing track short is skipped.
+
   DEBUGGING:
   ────────────────────────────────────────────────────────────────────
-  Real-time debug output prints the following to Serial Monitor:
-     - Drive and turn joystick input and output values
-     - Dome PWM signal
-     - MP3 triggers (category and track) if enabled
+  Drive and turn joystick input and output values, plus the dome
+  command, stream as binary telemetry (see `Telemetry.h`).
+  Serial Monitor text shows (levels in DebugLog.h):
+     - Kill switch, dome stick override / resume  (MODE, LOG_INFO)
+     - Random sounds (category and track)         (MP3, LOG_INFO)
+     - Dome moves (angle, speed, from + target)   (DOME, LOG_DEBUG)
 
   FILE LOCATION:
   ────────────────────────────────────────────────────────────────────
   This file: `HybridMode.cpp`
   Header:    `HybridMode.h`
+  Pipeline:  `DriveController.cpp` (this file only builds the profile)
 
   May the Force be with you, Builder.
   ╚═══════════════════════════════════════════════════════════════════╝
@@ -90,7 +107,10 @@
 #include "ComboHandler.h"
 #include "PWMInputHandler.h"
 #include <Arduino.h>
-#include <Sabertooth.h>
+#include "MotorBus.h"
+#include "DriveController.h"
+#include "DomePosition.h"
+#include "DebugLog.h"
 
 // #define DISABLE_MP3  // ✅ Leave this line commented out to ENABLE MP3s
 
@@ -101,17 +121,9 @@
 // Forward Declarations
 // ─────────────────────────────────────────────────────────────────────────────
 void automationMode();
-static int applyExpoCurve(int input, float curve);
-static int taperToZero(int value);
 void runDomeAutomation();    
+bool runDomeOverride(unsigned long now);
 void runAutoMP3();           
-void playMP3Track(int track);         
-
-// ─────────────────────────────────────────────────────────────────────────────
-// Sabertooth Motor Controller Setup
-// ─────────────────────────────────────────────────────────────────────────────
-static Sabertooth ST(128, Serial2);  // Drive motor controller (address 128)
-static Sabertooth domeMotor(129, Serial2);  // SyRen at address 129
 
 // ─────────────────────────────────────────────────────────────────────────────
 // TUNABLE PARAMETERS — DRIVE & INPUT
@@ -123,21 +135,40 @@ static int taperFallRate = 60;                  // Turn deceleration rate (highe
 static int fineControlMultiplier = 2;           // Boosts dome speed during flicks
 static const unsigned long motorTimeoutMs = 150; // Time in ms before motors stop if no input
 
+// Drive + turn response table: built once at boot, `tune` (TuningStore.cpp) rebuilds it live
+static ResponseCurve driveCurve(expoCurve, speedLimit);
+
+// Dome is automated here, so the profile has no dome table
+// Not static: TuningStore.cpp saves and loads it
+DriveProfile hybridProfile = {
+  "Hybrid",
+  &driveCurve, deadZone,
+  80, 40,                                        // |drive| > 80 caps turn at ±40
+  true, taperFallRate, fxMapRange(0, speedLimit, 5, taperFallRate),
+  motorTimeoutMs,
+  3,                                             // Kill switch combo
+  NULL, 0, fineControlMultiplier, Q8_8(1.00), Q8_8(1.00),
+  0, 0, 0
+};
+
 // ─────────────────────────────────────────────────────────────────────────────
 // TUNABLE PARAMETERS — AUTOMATED DOME
 // ─────────────────────────────────────────────────────────────────────────────
-static float minMoveIntervalSec = 10.0;          // Minimum time between automated dome moves
-static float maxMoveIntervalSec = 30.0;          // Maximum time between automated dome moves
+static int minMoveIntervalSec = 10;              // Minimum time between automated dome moves
+static int maxMoveIntervalSec = 30;              // Maximum time between automated dome moves
 static int domeMinAngleDeg = 10;                 // Minimum angle to turn dome (degrees)
 static int domeMaxAngleDeg = 90;                 // Maximum angle to turn dome (degrees)
-static int domeMinSpeedPercent = 10;             // Minimum speed for dome moves (percent)
-static int domeMaxSpeedPercent = 50;             // Maximum speed for dome moves (percent)
 
+// Power cap for every move in a sequence; the encoder loop decides how
+// long each move takes (see DomePosition.h for gearing and PID tuning)
+static const int domeSequenceMinSpeed = 25;
+static const int domeSequenceMaxSpeed = 32;
 
-// === Dome Gear Ratio ===
-// This converts dome angle degrees into total motor rotation angle
-// Needed to generate realistic dome motor movement
-static const float GEAR_RATIO = 360.416 / 50.7;
+// Manual dome override from the Controller B stick
+static const int domeOverrideDeadband = 60;              // µs off center before the stick takes over
+static const int domeOverrideSpeed = 40;                 // Dome power at full stick
+static const unsigned long domeOverrideHoldMs = 3000;    // Automation waits this long after release
+static const FxMap domeOverrideMap = fxMapRange(-500, 500, -domeOverrideSpeed, domeOverrideSpeed);
 
 // ─────────────────────────────────────────────────────────────────────────────
 // TUNABLE PARAMETERS — MP3 BANKS
@@ -149,51 +180,31 @@ static const float GEAR_RATIO = 360.416 / 50.7;
 #define HYBRID_TALK_START    061
 #define HYBRID_TALK_END      076
 
-#ifndef DISABLE_MP3
-static unsigned long lastMP3Time = 0;
-static unsigned long nextMP3Delay = 0; 
-#endif
-
 // ─────────────────────────────────────────────────────────────────────────────
 // INTERNAL STATE
 // ─────────────────────────────────────────────────────────────────────────────
-static int domeInput = 0;
 static int currentDomeSpeed = 0;
 static int lastSentDomeSpeed = 0;
 static unsigned long previousDomeMillis = 0;
 
-static int lastDrive = 0;
-static int lastTurn = 0;
-static int savedTurnSpeed = 0;
-static unsigned long lastDriveCommandTime = 0;
-static unsigned long lastTurnCommandTime = 0;
-
-static bool wasTurnInputActive = false;
 static bool lastKillState = false;
 
 static unsigned long modeEntryTime = 0;
 static const unsigned long modeDelayMillis = 3000;
 
 // ───── Dome Automation State ─────
-enum DomeState { IDLE, MOVE_1, MOVE_2, RETURN_TO_CENTER };
-static DomeState domeState = IDLE;
-static unsigned long domeTimer = 0;
-static unsigned long domeDelay = 0;
-static int domeMovesToMake = 0;
-static int domeMoveCount = 0;
-static float domeAngleTracker = 0;
+static bool domeMoveActive = false;             // A moveDomeTo() from here is running
+static bool domeOverride = false;               // Dome stick has the dome
+static unsigned long domeOverrideMs = 0;        // Last time the stick was off center
 
 // ─────────────────────────────────────────────────────────────────────────────
 // SETUP FUNCTION
 // ─────────────────────────────────────────────────────────────────────────────
 void setupHybridMode() {
-  setupPWMInputs();
+  selectDriveProfile(&hybridProfile);  // Serial2, inputs and curves are already up
+  lastKillState = false;
+  domeOverride = false;
   modeEntryTime = millis();
-
-  Serial2.begin(9600);
-  delay(100);
-  Serial2.write(0xAA);  // Sync byte for Sabertooth/SyRen
-  delay(10);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -202,55 +213,27 @@ void setupHybridMode() {
 void loopHybridMode() {
   unsigned long now = millis();
 
-  int rawTurn  = ch1_value;
-  int rawDrive = ch2_value;
-  int rawDome  = ch1b_value;
+  updateDriveController();  // Drive + turn from Controller A
 
-  int mappedTurn  = map(constrain(rawTurn,  1000, 2000), 1000, 2000, -127, 127);
-  int mappedDrive = map(constrain(rawDrive, 1000, 2000), 1000, 2000, -127, 127);
-
-  bool driveInDeadzone = (abs(mappedDrive) <= deadZone);
-  bool turnInDeadzone  = (abs(mappedTurn) <= deadZone);
-  if (driveInDeadzone) mappedDrive = 0;
-  if (turnInDeadzone) mappedTurn = 0;
-
-  if (abs(mappedDrive) > 80) mappedTurn = constrain(mappedTurn, -40, 40);
-
-  int curvedDrive = applyExpoCurve(mappedDrive, expoCurve);
-  int curvedTurn  = applyExpoCurve(mappedTurn,  expoCurve);
-
-  lastDrive = curvedDrive;
-  lastDriveCommandTime = now;
-
-  if (mappedTurn == 0 && wasTurnInputActive) {
-    lastTurn = taperToZero(lastTurn != 0 ? lastTurn : savedTurnSpeed);
-  } else if (mappedTurn == 0) {
-    lastTurn = 0;
-  } else {
-    savedTurnSpeed = curvedTurn;
-    lastTurn = curvedTurn;
-    lastTurnCommandTime = now;
-  }
-
-  wasTurnInputActive = (mappedTurn != 0);
-
-  bool killActive = isComboModeActive(3);
+  bool killActive = isDriveKillActive();
   if (killActive != lastKillState) {
-    Serial.println(killActive ? "[KILL SWITCH ACTIVE] Automation + MP3s disabled."
-                              : "[KILL SWITCH RELEASED] Automation + MP3s re-enabled.");
+    if (LOG_ENABLED(MODE, LOG_INFO)) {
+      usbLog.println(killActive ? F(">> Automation + MP3s disabled.")
+                                : F(">> Automation + MP3s re-enabled."));
+    }
+    if (killActive) {
+      stopDome();           // Stop a dome move in progress too
+      currentDomeSpeed = 0;
+      domeMoveActive = false;
+    }
     lastKillState = killActive;
   }
 
-  if (killActive) {
-    lastDrive = 0;
-    lastTurn = 0;
-  }
-
-  ST.drive(lastDrive);
-  ST.turn(lastTurn);
-
   if (!killActive) {
-  runDomeAutomation();
+  if (!runDomeOverride(now)) {
+    updateDomePosition();   // Closed loop toward the last moveDomeTo() target
+    runDomeAutomation();
+  }
   runAutoMP3();
   } else {
     analogWrite(46, 0);
@@ -261,18 +244,38 @@ void loopHybridMode() {
     previousDomeMillis = now;
     lastSentDomeSpeed = currentDomeSpeed;
   }
+}
 
-  if (now - lastDriveCommandTime > motorTimeoutMs) lastDrive = 0;
-  if (now - lastTurnCommandTime > motorTimeoutMs) lastTurn = 0;
+// ─────────────────────────────────────────────────────────────
+// Manual Dome Override (Controller B stick)
+// ─────────────────────────────────────────────────────────────
+// True while the stick owns the dome, including the hold after release
+bool runDomeOverride(unsigned long now) {
+  int stick = getFramePulse(PWM_CH1B);
+  int offset = stick ? stick - getStickCalibration(STICK_DOME).centerUs : 0;   // No signal = centered
+
+  if (abs(offset) > domeOverrideDeadband) {
+    if (!domeOverride) {
+      stopDome();                                // Ends the automated move where it is
+      domeMoveActive = false;
+      domeOverride = true;
+      LOG_LINE(MODE, LOG_INFO, ">> Dome stick override.");
+    }
+    int power = fxMap(domeOverrideMap, offset);
+    setDomePower(power);
+    currentDomeSpeed = abs(power);
+    domeOverrideMs = now;
+    return true;
+  }
 
-  Serial.print("DriveRaw: "); Serial.print(mappedDrive);
-  Serial.print(" | DriveOut: "); Serial.print(lastDrive);
-  Serial.print(" || TurnRaw: "); Serial.print(mappedTurn);
-  Serial.print(" | TurnOut: "); Serial.print(lastTurn);
-  Serial.print(" || DomeRaw: "); Serial.print(domeInput);
-  Serial.print(" | DomeOut: "); Serial.println(currentDomeSpeed);
+  if (!domeOverride) return false;
+  setDomePower(0);
+  currentDomeSpeed = 0;
+  if (now - domeOverrideMs < domeOverrideHoldMs) return true;
 
-  delay(20);
+  domeOverride = false;                          // Next automated move starts from here
+  LOG_LINE(MODE, LOG_INFO, ">> Dome automation resumed.");
+  return false;
 }
 
 // ─────────────────────────────────────────────────────────────
@@ -282,92 +285,72 @@ void loopHybridMode() {
 void runDomeAutomation() {
   static unsigned long lastMoveTime = 0;
   static unsigned long nextMoveDelay = 0;
-  static bool domeMoving = false;
-  static int domeOffset = 0;
   static int moveCount = 0;
-  static int domeDirection = 0;
   static int sequenceSpeed = 30;
   static bool sequenceStarted = false;
-  static unsigned long domeEndTime = 0;
 
   unsigned long now = millis();
   if (now - modeEntryTime < 3000) return;
 
-  // === Timing setup
-  const float baseMsPerDegree = 1700.0 / 90.0;
-  const float curveFactor = 1.4;
-  const int baseSpeed = 30;
-  const int minSpeed = 25;
-  const int maxSpeed = 32;
-
-  if (domeMoving) {
-    if (now >= domeEndTime) {
-      domeMotor.motor(1, 0);
-      domeMoving = false;
-      Serial.println("[DOME] Move complete.");
+  if (isDomeMoving()) return;   // updateDomePosition() is steering it
+  if (domeMoveActive) {
+    domeMoveActive = false;
+    currentDomeSpeed = 0;
+    if (LOG_ENABLED(DOME, LOG_DEBUG) && getDomeFault() == DOME_FAULT_NONE) {
+      usbLog.print(F("[DOME] Move complete at "));
+      usbLog.print(getDomeAngle());
+      usbLog.println(F("°."));
     }
-    return;
   }
 
   if (now - lastMoveTime < nextMoveDelay) return;
   lastMoveTime = now;
-  nextMoveDelay = random(minMoveIntervalSec * 1000, maxMoveIntervalSec * 1000);
+  nextMoveDelay = random(minMoveIntervalSec * 1000L, maxMoveIntervalSec * 1000L);
 
   if (!sequenceStarted) {
-    sequenceSpeed = random(minSpeed, maxSpeed + 1);
+    sequenceSpeed = random(domeSequenceMinSpeed, domeSequenceMaxSpeed + 1);
     sequenceStarted = true;
-    Serial.print("=== New Dome Sequence @ Speed: ");
-    Serial.println(sequenceSpeed);
+    if (LOG_ENABLED(DOME, LOG_DEBUG)) {
+      usbLog.print(F("=== New Dome Sequence @ Speed: "));
+      usbLog.println(sequenceSpeed);
+    }
   }
 
-  int direction = 0;
-  float angle = 0;
-  bool isReturnMove = false;
+  int target = 0;
+  int domeOffset = getDomeTargetAngle();
 
-  if (moveCount >= 2 || fabs(domeOffset) > 0.5) {
-    direction = (domeOffset >= 0) ? -1 : 1;
-    angle = fabs(domeOffset);
+  if (moveCount >= 2 || domeOffset != 0) {
+    target = 0;                                  // Home is the encoder zero, not a guess
     moveCount = 0;
     sequenceStarted = false;
-    isReturnMove = true;
-    Serial.print("[DOME] Returning to center:  ");
+    if (LOG_ENABLED(DOME, LOG_DEBUG)) usbLog.print(F("[DOME] Returning to center:  "));
   } else {
-    direction = random(0, 2) == 0 ? -1 : 1;
-    angle = random(domeMinAngleDeg, domeMaxAngleDeg + 1);
+    int direction = random(0, 2) == 0 ? -1 : 1;
+    target = domeOffset + direction * random(domeMinAngleDeg, domeMaxAngleDeg + 1);
     moveCount++;
-    Serial.print("[DOME] Move ");
-    Serial.print(moveCount);
-    Serial.print(":  ");
-    Serial.println(direction > 0 ? "RIGHT" : "LEFT");
+    if (LOG_ENABLED(DOME, LOG_DEBUG)) {
+      usbLog.print(F("[DOME] Move "));
+      usbLog.print(moveCount);
+      usbLog.print(F(":  "));
+      usbLog.println(direction > 0 ? F("RIGHT") : F("LEFT"));
+    }
+  }
+
+  if (LOG_ENABLED(DOME, LOG_DEBUG)) {
+    usbLog.print(F("Angle: "));
+    usbLog.print(abs(target - domeOffset));
+    usbLog.print(F("°   Speed: "));
+    usbLog.print(sequenceSpeed);
+    usbLog.print(F("   From: "));
+    usbLog.print(getDomeAngle());
+    usbLog.print(F("°   Target: "));
+    usbLog.print(target);
+    usbLog.println(F("°"));
   }
 
-  float speedRatio = baseSpeed / (float)sequenceSpeed;
-  float scaleFactor = pow(speedRatio, curveFactor);
-  float adjustedMsPerDegree = baseMsPerDegree * scaleFactor;
-
-  if (!isReturnMove && direction > 0) adjustedMsPerDegree *= 1.06;
-  if (!isReturnMove && direction < 0) adjustedMsPerDegree *= 0.96;
-
-  unsigned long duration = (unsigned long)(angle * adjustedMsPerDegree);
-  float actualAngleMoved = (float)duration / adjustedMsPerDegree;
-  domeOffset += direction * actualAngleMoved;
-
-  Serial.print("Angle: ");
-  Serial.print(angle);
-  Serial.print("°   Actual: ");
-  Serial.print(actualAngleMoved);
-  Serial.print("°   Speed: ");
-  Serial.print(sequenceSpeed);
-  Serial.print("   Duration: ");
-  Serial.print(duration);
-  Serial.print(" ms   Offset: ");
-  Serial.println(domeOffset);
-
-  domeMotor.motor(1, direction * sequenceSpeed);
-  domeEndTime = now + duration;
-  domeDirection = direction;
+  moveDomeTo(target, sequenceSpeed);
   currentDomeSpeed = sequenceSpeed;
-  domeMoving = true;
+  domeMoveActive = true;
 }
 
 
@@ -384,48 +367,26 @@ void runAutoMP3() {
 
     int category = random(0, 3);
     int track = 0;
-    const char* label = "";
+    const __FlashStringHelper* label;
 
     if (category == 0) {
       track = random(HYBRID_HAPPY_START, HYBRID_HAPPY_END + 1);
-      label = "Happy";
+      label = F("Happy");
     } else if (category == 1) {
       track = random(HYBRID_SAD_START, HYBRID_SAD_END + 1);
-      label = "Sad";
+      label = F("Sad");
     } else {
       track = random(HYBRID_TALK_START, HYBRID_TALK_END + 1);
-      label = "Talking";
+      label = F("Talking");
     }
 
-    Serial.print("[MP3] Random ");
-    Serial.print(label);
-    Serial.print(" → Track ");
-    Serial.println(track);
-
-    playMP3Track(track);
+    // Ambient: plays only into silence, never over a button or mode sound
+    if (playMP3(track, MP3_PRIORITY_AMBIENT) && LOG_ENABLED(MP3, LOG_INFO)) {
+      usbLog.print(F("[MP3] Random "));
+      usbLog.print(label);
+      usbLog.print(F(" → Track "));
+      usbLog.println(track);
+    }
     nextMP3Delay = random(5000, 15000);
   }
 }
-
-
-
-// ─────────────────────────────────────────────────────────────────────────────
-// Input Curve + Taper Helpers
-// ─────────────────────────────────────────────────────────────────────────────
-static int applyExpoCurve(int input, float curve) {
-  float normalized = abs(input) / 127.0;
-  float curved = pow(normalized, curve) * speedLimit;
-  return (input >= 0) ? (int)curved : -(int)curved;
-}
-
-static int taperToZero(int value) {
-  int taperRate = map(abs(value), 0, speedLimit, 5, taperFallRate);
-  if (value > 0) {
-    value -= taperRate;
-    if (value < 0) value = 0;
-  } else if (value < 0) {
-    value += taperRate;
-    if (value > 0) value = 0;
-  }
-  return value;
-}
@@ -16,6 +16,7 @@
 
 #include <Arduino.h>
 #include "PWMInputHandler.h"
+#include "DriveController.h"
 
 extern int domeMinAngle;
 extern int domeMaxAngle;
@@ -24,4 +25,6 @@ extern int domeCurrentAngle;
 void setupHybridMode();
 void loopHybridMode();
 
+extern DriveProfile hybridProfile;   // Live-tuned by `tune` (TuningStore.cpp)
+
 #endif
@@ -0,0 +1,228 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                  IdleGovernor.cpp - Shadow-RC System               ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Saves the battery while the droid stands still at a show. Parked  ║
+  ║ in Automated or Hybrid Mode for hours, it used to run 200 control ║
+  ║ ticks a second, keep every motor slot alive and spin loop() flat  ║
+  ║ out between them, for sticks nobody was touching.                 ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - `updateIdleGovernor()` ends every control tick. Every motor slot
+    at 0, no dome move running (`isDomeMoving()`) and no combo held
+    (`isComboHeld()`) for `IDLE_ENTER_MS` = parked:
+      • control tick every `IDLE_TICK_US` instead of `CONTROL_TICK_US`
+      • motor bus skips the TURN keepalive: the DRIVE one already
+        keeps the 2x32's serial timeout from firing (MotorBus.cpp)
+      • `idleSleep()` puts the AVR in idle sleep whenever nothing is
+        due. Timers, UARTs and pin interrupts keep running, so the
+        ISRs still capture every pulse and encoder count.
+  - Any slot leaving 0, a dome move (Hybrid / Automated automation)
+    or a combo unparks it at the end of that tick.
+  - Wake-up: each input ISR hands its new width to `noteIdleInput()`.
+    A pulse more than `IDLE_WAKE_STEP_US` from that channel's last one
+    sets `idleWakePending`; the interrupt has already woken the CPU,
+    and `pollIdleWake()` (top of loop()) restores the full rate and
+    releases the control tick at once. iBUS / SBUS bytes are drained
+    by the 1 ms "tx" task even while parked, so a frame wakes it
+    within ~1 ms and none overflow the RX buffer.
+  - Sleep is entered with interrupts off and the pending flag checked,
+    so a pulse landing right before `sleep_cpu()` still wakes it.
+
+  READ BACK:
+  ─────────────────────────────────────────────────────────────────────
+  `stats` shows, per state: seconds spent, control ticks and motor
+  packets per second, the share of time in idle sleep and the current
+  that implies (`IDLE_AWAKE_MA` / `IDLE_ASLEEP_MA`). The button
+  sampler's own time is taken out of the sleep share; the other ISRs
+  are not, so it is an upper bound ("sleep <=") and the current a
+  lower one. Then the wake-ups from a pulse and the last / worst
+  pulse → full-rate tick done time.
+  `reset` clears them.
+  The sampler keeps running while parked: the sound and combo buttons
+  have no pin interrupt of their own to wake it.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `IdleGovernor.cpp`
+  Header:    `IdleGovernor.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "IdleGovernor.h"
+#include "Scheduler.h"
+#include "MotorBus.h"
+#include "DomePosition.h"
+#include "ComboHandler.h"
+#include "DebugLog.h"
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+GovernorStats governorStats;
+
+volatile bool          governorIdle    = false;
+volatile bool          idleWakePending = false;
+volatile unsigned long idleWakeEdgeUs  = 0;
+volatile uint16_t      idleIsrTicks    = 0;
+
+static unsigned long quietSinceMs   = 0;
+static unsigned long lastAccountUs  = 0;
+static unsigned long lastPackets    = 0;
+static unsigned long stateUs[GOVERNOR_STATE_COUNT];   // Below 1 ms, not yet in .ms
+static unsigned long sleepUs        = 0;              // Below 1 ms, not yet in the idle .sleepMs
+static bool          timingWake     = false;          // Next tick end closes a pulse wake
+static unsigned long wakeEdgeUs     = 0;
+
+// ==========================
+//        ACCOUNTING
+// ==========================
+static unsigned long totalMotorPackets() {
+  return motorBusStats.packets[MOTOR_SLOT_DRIVE] + motorBusStats.packets[MOTOR_SLOT_TURN] +
+         motorBusStats.packets[MOTOR_SLOT_DOME];
+}
+
+// Time, ticks and packets since the last tick go to the state they ran in
+static void accountTick(unsigned long nowUs) {
+  uint8_t state = governorIdle ? GOVERNOR_IDLE : GOVERNOR_ACTIVE;
+  GovernorStateStats &s = governorStats.state[state];
+
+  stateUs[state] += nowUs - lastAccountUs;
+  lastAccountUs = nowUs;
+  s.ms += stateUs[state] / 1000;
+  stateUs[state] %= 1000;
+
+  unsigned long packets = totalMotorPackets();
+  s.packets += packets - lastPackets;
+  lastPackets = packets;
+  s.ticks++;
+}
+
+// ==========================
+//      PARK / UNPARK
+// ==========================
+static void park() {
+  idleWakePending = false;
+  governorIdle = true;
+  setControlTickPeriod(IDLE_TICK_US);
+  setMotorBusIdle(true);
+  governorStats.entries++;
+  LOG_LINE(IDLE, LOG_INFO, "[IDLE] Parked: slow tick, sleeping between interrupts.");
+}
+
+static void unpark() {
+  governorIdle = false;
+  setControlTickPeriod(CONTROL_TICK_US);
+  setMotorBusIdle(false);
+  LOG_LINE(IDLE, LOG_INFO, "[IDLE] Awake.");
+}
+
+static bool isQuiet() {
+  return getMotorPower(MOTOR_SLOT_DRIVE) == 0 && getMotorPower(MOTOR_SLOT_TURN) == 0 &&
+         getMotorPower(MOTOR_SLOT_DOME) == 0 && !isDomeMoving() && !isComboHeld();
+}
+
+void updateIdleGovernor() {
+#if IDLE_ENABLED
+  unsigned long nowUs = micros();
+  accountTick(nowUs);
+
+  if (timingWake) {
+    unsigned long wakeUs = nowUs - wakeEdgeUs;
+    governorStats.lastWakeUs = wakeUs;
+    if (wakeUs > governorStats.worstWakeUs) governorStats.worstWakeUs = wakeUs;
+    timingWake = false;
+  }
+
+  unsigned long now = millis();
+  if (!isQuiet()) {
+    quietSinceMs = now;
+    if (governorIdle) unpark();      // Next release already uses the full rate
+    return;
+  }
+  if (!governorIdle && now - quietSinceMs >= IDLE_ENTER_MS) park();
+#endif
+}
+
+// ==========================
+//         WAKE-UP
+// ==========================
+void pollIdleWake() {
+#if IDLE_ENABLED
+  if (!idleWakePending) return;
+  wakeEdgeUs = idleWakeEdgeUs;       // The ISR leaves it alone while the flag is set
+  idleWakePending = false;
+  if (!governorIdle) return;
+
+  governorStats.edgeWakes++;
+  timingWake = true;
+  quietSinceMs = millis();
+  unpark();
+  releaseControlTick();              // Do not wait out the slow period
+#endif
+}
+
+// ==========================
+//          SLEEP
+// ==========================
+// Until the scheduler has something due, or a pulse moved. Every
+// interrupt wakes the CPU (button sampler, Timer0, UARTs, pulses); each
+// one only costs a micros() check here before the next sleep. The
+// sampler's 20 kHz wake-ups are timed and left out of the sleep time;
+// Timer0, UART and pulse ISRs are not, so it is an upper bound.
+void idleSleep() {
+#if IDLE_ENABLED && IDLE_SLEEP
+  if (!governorIdle) return;
+
+  noInterrupts();
+  idleIsrTicks = 0;
+  interrupts();
+  unsigned long start = micros();
+  unsigned long until = getSchedulerNextDueUs();
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  while ((long)(micros() - until) < 0) {
+    noInterrupts();
+    if (idleWakePending) {
+      interrupts();
+      break;
+    }
+    sleep_enable();
+    interrupts();                    // The instruction after SEI still runs: no lost wake-up
+    sleep_cpu();
+    sleep_disable();
+  }
+  unsigned long windowUs = micros() - start;
+  noInterrupts();
+  unsigned long samplerUs = idleIsrTicks / 2;
+  interrupts();
+  sleepUs += windowUs > samplerUs ? windowUs - samplerUs : 0;
+  governorStats.state[GOVERNOR_IDLE].sleepMs += sleepUs / 1000;
+  sleepUs %= 1000;
+#endif
+}
+
+bool isIdle() {
+  return governorIdle;
+}
+
+// ==========================
+//        STATISTICS
+// ==========================
+int estimateIdleCurrent(uint8_t state) {
+  const GovernorStateStats &s = governorStats.state[state];
+  if (s.ms == 0) return 0;
+  unsigned long asleep = min(s.sleepMs, s.ms);
+  return (int)((IDLE_AWAKE_MA * (s.ms - asleep) + IDLE_ASLEEP_MA * asleep + s.ms / 2) / s.ms);
+}
+
+void resetIdleStats() {
+  memset(&governorStats, 0, sizeof(governorStats));
+  memset(stateUs, 0, sizeof(stateUs));
+  sleepUs = 0;
+  lastAccountUs = micros();
+  lastPackets = totalMotorPackets();
+  timingWake = false;
+}
@@ -0,0 +1,91 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                IdleGovernor.h - Shadow-RC                  ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the idle governor. A parked droid drops to a    ║
+  ║ slow control tick, one keepalive per driver and AVR idle   ║
+  ║ sleep; any receiver pulse that moves brings it right back. ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing idle timing.           ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef IDLE_GOVERNOR_H
+#define IDLE_GOVERNOR_H
+
+#include <Arduino.h>
+
+// ---------- Parking ----------
+// Idle = every motor slot at 0 (sticks centred, no automation moving the
+// dome), no dome move running and no combo held, for IDLE_ENTER_MS.
+#define IDLE_ENABLED            1      // 0 = full rate all the time, never sleeps
+#define IDLE_ENTER_MS           2000   // Quiet this long before parking
+#define IDLE_TICK_US            20000  // Control tick while parked: one 50 Hz receiver frame
+#define IDLE_WAKE_STEP_US       30     // A pulse this far from its channel's last one wakes at once
+#define IDLE_SLEEP              1      // 1 = AVR idle sleep between interrupts while parked
+
+// ---------- Current Estimate ----------
+// What the ATmega2560 draws awake and in idle sleep (datasheet, 16 MHz /
+// 5 V). `stats` weights them by the measured sleep time per state; put a
+// meter on your Mega in each state and use its numbers (the USB chip,
+// regulator and LEDs add a fixed draw on top).
+#define IDLE_AWAKE_MA           20
+#define IDLE_ASLEEP_MA          7
+
+enum GovernorState {
+  GOVERNOR_ACTIVE = 0,     // Full CONTROL_TICK_US rate
+  GOVERNOR_IDLE,           // Parked
+  GOVERNOR_STATE_COUNT
+};
+
+struct GovernorStateStats {
+  unsigned long ms;        // Time spent in this state
+  unsigned long sleepMs;   // ...of which the CPU slept
+  unsigned long ticks;     // Control ticks run
+  unsigned long packets;   // Motor packets sent (Serial2)
+};
+
+struct GovernorStats {
+  GovernorStateStats state[GOVERNOR_STATE_COUNT];
+  unsigned long entries;       // Times parked
+  unsigned long edgeWakes;     // ...woken by a receiver pulse (the rest by a control tick)
+  unsigned long lastWakeUs;    // Pulse → first full-rate tick done, last edge wake
+  unsigned long worstWakeUs;
+};
+
+extern GovernorStats governorStats;
+
+// ---------- ISR Side ----------
+extern volatile bool          governorIdle;       // Parked right now
+extern volatile bool          idleWakePending;    // A pulse moved while parked
+extern volatile unsigned long idleWakeEdgeUs;     // ...at this micros()
+extern volatile uint16_t      idleIsrTicks;       // Timer3 ticks (0.5 µs) the button sampler kept it awake
+
+// Every ISR that stores a pulse width calls this first
+static inline void noteIdleInput(int oldWidth, int newWidth, unsigned long now) {
+#if IDLE_ENABLED
+  if (governorIdle && !idleWakePending && abs(newWidth - oldWidth) > IDLE_WAKE_STEP_US) {
+    idleWakeEdgeUs  = now;
+    idleWakePending = true;
+  }
+#endif
+}
+
+// The button sampler reports its own cost; the other ISRs go unmeasured
+static inline void noteIdleIsrTicks(uint16_t ticks) {
+#if IDLE_ENABLED && IDLE_SLEEP
+  if (governorIdle) idleIsrTicks += ticks;
+#endif
+}
+
+// ---------- Loop Side ----------
+void pollIdleWake();           // loop(), before runScheduler(): pulse while parked → full rate, tick now
+void updateIdleGovernor();     // End of every control tick: park / unpark, per-state accounting
+void idleSleep();              // loop(), when runScheduler() found nothing due
+bool isIdle();
+
+// ---------- Statistics ----------
+int  estimateIdleCurrent(uint8_t state);   // mA, from the sleep time of that state
+void resetIdleStats();
+
+#endif
@@ -0,0 +1,108 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                    InputPins.cpp - Shadow-RC System                ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Checks the input pin table in InputPins.h at boot. The dome stick  ║
+  ║ used to share the external interrupts with the dome encoder, so    ║
+  ║ CH1B was detached outside Manual / Carpet and Hybrid lost its      ║
+  ║ dome stick and Joystick-B combos.                                  ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - Each interrupt-driven input is listed once with the source that
+    serves it: an external interrupt (INTn, `attachInterrupt()`) or a
+    pin-change bank (PCINTn, its own ISR in PWMInputHandler.cpp).
+  - `checkInputPins()` looks each pin up in the core's pin tables
+    (`digitalPinToInterrupt()`, `digitalPinToPCICRbit()`), so moving
+    a pin to one without that interrupt is caught on the first boot
+    instead of as a dead stick.
+  - A pin listed twice, or two inputs on one pin-change bank, is
+    reported too: the bank ISR assumes it has the port to itself.
+  - The check runs once in setup() and costs nothing afterwards.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `InputPins.cpp`
+  Header:    `InputPins.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "InputPins.h"
+#include "PWMInputHandler.h"   // RC_INPUT_BACKEND
+#include <Arduino.h>
+
+enum InputSource { INPUT_EXT_INT = 0, INPUT_PIN_CHANGE };
+
+struct InputPinUse {
+  PGM_P       name;
+  uint8_t     pin;
+  uint8_t     source;
+};
+
+static const char nameCh1a[]     PROGMEM = "CH1A";
+static const char nameCh2a[]     PROGMEM = "CH2A";
+static const char nameCh1b[]     PROGMEM = "CH1B";
+static const char nameCppmA[]    PROGMEM = "CPPM A";
+static const char nameCppmB[]    PROGMEM = "CPPM B";
+static const char nameEncoderA[] PROGMEM = "Encoder A";
+static const char nameEncoderB[] PROGMEM = "Encoder B";
+
+static const InputPinUse inputPins[] PROGMEM = {
+#if RC_INPUT_BACKEND == RC_INPUT_PWM
+  { nameCh1a,     CH1_PIN,            INPUT_EXT_INT },
+  { nameCh2a,     CH2_PIN,            INPUT_EXT_INT },
+  { nameCh1b,     CH1B_PIN,           INPUT_PIN_CHANGE },
+#elif RC_INPUT_BACKEND == RC_INPUT_CPPM
+  { nameCppmA,    CH1_PIN,            INPUT_EXT_INT },
+  { nameCppmB,    CPPM_B_PIN,         INPUT_EXT_INT },
+#endif
+  { nameEncoderA, DOME_ENCODER_PIN_A, INPUT_EXT_INT },
+  { nameEncoderB, DOME_ENCODER_PIN_B, INPUT_EXT_INT },
+};
+
+static const uint8_t INPUT_PIN_COUNT = sizeof(inputPins) / sizeof(inputPins[0]);
+
+static void reportPin(const InputPinUse &use, const __FlashStringHelper* problem) {
+  Serial.print(F("[PINS] "));
+  Serial.print((const __FlashStringHelper*)use.name);
+  Serial.print(F(" (pin "));
+  Serial.print(use.pin);
+  Serial.print(F("): "));
+  Serial.println(problem);
+}
+
+bool checkInputPins() {
+  bool ok = true;
+
+  for (uint8_t i = 0; i < INPUT_PIN_COUNT; i++) {
+    InputPinUse use;
+    memcpy_P(&use, &inputPins[i], sizeof(use));
+
+    if (use.source == INPUT_EXT_INT && digitalPinToInterrupt(use.pin) == NOT_AN_INTERRUPT) {
+      reportPin(use, F("no external interrupt on this pin."));
+      ok = false;
+    }
+    if (use.source == INPUT_PIN_CHANGE &&
+        (digitalPinToPCICR(use.pin) == 0 || digitalPinToPCICRbit(use.pin) != PCIE2)) {
+      reportPin(use, F("not on port K (A8-A15), the PCINT2 bank."));
+      ok = false;
+    }
+
+    for (uint8_t j = 0; j < i; j++) {
+      InputPinUse other;
+      memcpy_P(&other, &inputPins[j], sizeof(other));
+      if (other.pin == use.pin) {
+        reportPin(use, F("pin already used by another input."));
+        ok = false;
+      } else if (use.source == INPUT_PIN_CHANGE && other.source == INPUT_PIN_CHANGE &&
+                 digitalPinToPCICRbit(use.pin) == digitalPinToPCICRbit(other.pin)) {
+        reportPin(use, F("pin-change bank already used by another input."));
+        ok = false;
+      }
+    }
+  }
+  return ok;
+}
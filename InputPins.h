@@ -0,0 +1,42 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                   InputPins.h - Shadow-RC                  ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Every input pin and the interrupt that serves it, in one   ║
+  ║ table. The Mega has six external interrupts (INT0–INT5);   ║
+  ║ the dome encoder needs two, the drive sticks two, so the   ║
+  ║ dome stick (CH1B) runs on a pin-change bank instead.       ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are rewiring the receivers or the   ║
+  ║ dome encoder. `checkInputPins()` reports a bad change.     ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef INPUT_PINS_H
+#define INPUT_PINS_H
+
+#include <Arduino.h>
+
+// ---------- External Interrupts (one vector per pin) ----------
+#define CH1_PIN                 2    // INT4  Turn  (Controller A)
+#define CH2_PIN                 3    // INT5  Drive (Controller A)
+#define DOME_ENCODER_PIN_A      19   // INT2  (same port as B: one PIND read per edge)
+#define DOME_ENCODER_PIN_B      20   // INT1
+#define CPPM_B_PIN              21   // INT0  Receiver B PPM (RC_INPUT_CPPM only; A uses CH1_PIN)
+// Pin 18 (INT3) is TX1 to the MP3 Trigger
+
+// ---------- Pin-Change Bank (PCINT2 = port K, A8–A15) ----------
+// The bank's only user, so its ISR knows which pin moved without
+// comparing the whole port. Keep CH1B on port K or the vector
+// in PWMInputHandler.cpp will not fire.
+#define CH1B_PIN                A8   // PCINT16  Dome (Controller B)
+
+// ---------- Sampled by the Timer3 button sampler ----------
+// CH3A–CH6A → 22, 24, 26, 28   CH2B–CH6B → 23, 25, 27, 29, 31
+// (port A + PC6, see PWMInputHandler.cpp; no interrupt per pin)
+
+// Boot check: every pin above has the interrupt it is listed under
+// and no two inputs share a pin. Prints what is wrong; false = fix wiring.
+bool checkInputPins();
+
+#endif
@@ -0,0 +1,146 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                   InputTrace.cpp - Shadow-RC System                ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Records what the operator actually did during a real driving      ║
+  ║ session, so curve, combo and scheduler changes can be benchmarked ║
+  ║ against the exact same stick inputs on the desktop instead of     ║
+  ║ synthetic step scripts.                                           ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - `trace on` in the Serial Monitor starts recording, `trace off`
+    stops it. The first ticks list all 12 channels so a replay
+    starts from the right state.
+  - Every control tick, `recordInputTrace()` compares the InputFrame
+    with what was last recorded. A channel is listed when its width
+    moved by more than `INPUT_TRACE_DEADBAND_US` or its signal came
+    or went, with the age of its last falling edge, so the replay
+    knows the edge time to the µs and not just the tick.
+  - The dome encoder count is sent as a delta since the last frame.
+  - Frames go through the telemetry ring (`TELEMETRY_INPUT`), so
+    recording never blocks either. If the ring is full, nothing is
+    marked as recorded and the next tick sends the newest values.
+  - A stick held still costs nothing; a busy walk-around with both
+    sticks moving is ~2–3 kB/s over USB.
+
+  WHY NOT EEPROM / RAM:
+  ─────────────────────────────────────────────────────────────────────
+  The Mega's 4 KB EEPROM holds a few seconds of driving and wears out
+  with constant writes; free SRAM holds less than a second. USB to a
+  laptop (or a phone with an OTG cable) records a whole convention.
+
+  RECORDING + REPLAY:
+  ─────────────────────────────────────────────────────────────────────
+    python3 Tools/telemetry_decode.py /dev/ttyACM0 --trace walk.trace
+    (type `trace on` / `trace off` in another terminal, or use the
+     Serial Monitor before starting the decoder)
+    cd Tools/HostSim && ./host_bench --replay ../../walk.trace
+
+  The bench feeds the trace through `storePWMChannel()`, the same
+  entry point the receiver backends use, and repeats each width every
+  20 ms like a receiver until the trace changes it.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `InputTrace.cpp`
+  Header:    `InputTrace.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "InputTrace.h"
+#include "PWMInputHandler.h"
+#include "DomePosition.h"
+#include "Telemetry.h"
+#include <Arduino.h>
+
+#define INPUT_TRACE_MAX_AGE_US  65535UL
+
+InputTraceStats inputTraceStats;
+
+static bool tracing = false;
+static int  recordedWidth[PWM_CHANNEL_COUNT];   // -1 = not recorded yet
+static long recordedEncoder = 0;
+
+// ==========================
+//         CONTROL
+// ==========================
+void startInputTrace() {
+  for (uint8_t ch = 0; ch < PWM_CHANNEL_COUNT; ch++) recordedWidth[ch] = -1;
+  recordedEncoder = readDomeTicks();
+  memset(&inputTraceStats, 0, sizeof(inputTraceStats));
+  tracing = true;
+  Serial.println(F("[TRACE] Recording inputs. `trace off` stops."));
+}
+
+void stopInputTrace() {
+  if (!tracing) return;
+  tracing = false;
+  Serial.print(F("[TRACE] Stopped: "));
+  Serial.print(inputTraceStats.frames);
+  Serial.print(F(" frames, "));
+  Serial.print(inputTraceStats.deferred);
+  Serial.println(F(" deferred."));
+}
+
+bool isInputTraceActive() {
+  return tracing;
+}
+
+// ==========================
+//        RECORDING
+// ==========================
+static inline void putU16(uint8_t* p, uint16_t v) {
+  p[0] = v; p[1] = v >> 8;
+}
+
+static bool widthChanged(int width, int recorded) {
+  if (width == 0 || recorded <= 0) return width != recorded;   // Signal came, went or never recorded
+  return abs(width - recorded) > INPUT_TRACE_DEADBAND_US;
+}
+
+void recordInputTrace() {
+  if (!tracing) return;
+
+  uint8_t p[INPUT_TRACE_HEADER_BYTES + INPUT_TRACE_MAX_ENTRIES * INPUT_TRACE_ENTRY_BYTES];
+  uint8_t listed[INPUT_TRACE_MAX_ENTRIES];
+  int     width[INPUT_TRACE_MAX_ENTRIES];
+  uint8_t count = 0;
+
+  for (uint8_t ch = 0; ch < PWM_CHANNEL_COUNT && count < INPUT_TRACE_MAX_ENTRIES; ch++) {
+    int w = inputFrame.valid[ch] ? inputFrame.width[ch] : 0;
+    if (!widthChanged(w, recordedWidth[ch])) continue;   // Channels past a full frame wait a tick
+
+    unsigned long age = inputFrame.age[ch];
+    if (inputFrame.lastEdge[ch] == 0 || age > INPUT_TRACE_MAX_AGE_US) age = INPUT_TRACE_MAX_AGE_US;
+
+    uint8_t* e = p + INPUT_TRACE_HEADER_BYTES + count * INPUT_TRACE_ENTRY_BYTES;
+    e[0] = ch;
+    putU16(e + 1, w);
+    putU16(e + 3, age);
+    listed[count] = ch;
+    width[count]  = w;
+    count++;
+  }
+
+  long delta = readDomeTicks() - recordedEncoder;
+  delta = constrain(delta, -32768L, 32767L);   // A bigger jump goes out over several frames
+  if (count == 0 && delta == 0) return;
+
+  unsigned long t = inputFrame.timestamp;
+  p[0] = t; p[1] = t >> 8; p[2] = t >> 16; p[3] = t >> 24;
+  putU16(p + 4, (uint16_t)(int16_t)delta);
+  p[6] = count;
+
+  if (!pushTelemetryFrame(TELEMETRY_INPUT, p, INPUT_TRACE_HEADER_BYTES + count * INPUT_TRACE_ENTRY_BYTES)) {
+    inputTraceStats.deferred++;   // Still differs from recordedWidth[], so it goes out next tick
+    return;
+  }
+
+  for (uint8_t i = 0; i < count; i++) recordedWidth[listed[i]] = width[i];
+  recordedEncoder += delta;
+  inputTraceStats.frames++;
+}
@@ -0,0 +1,45 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                  InputTrace.h - Shadow-RC                  ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for raw input recording. Every receiver channel     ║
+  ║ change plus the dome encoder count streams over USB as     ║
+  ║ telemetry frames, ready to replay in Tools/HostSim.        ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you also update                         ║
+  ║ Tools/telemetry_decode.py to match.                        ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <Arduino.h>
+
+// ---------- Trace Settings ----------
+#define INPUT_TRACE_DEADBAND_US  4     // Width changes this small are capture jitter, not input
+
+// ---------- Frame Format (TELEMETRY_INPUT) ----------
+// uint32 timeUs | int16 encoderDelta | uint8 count | count × entry
+// entry: uint8 channel | uint16 widthUs (0 = signal lost) | uint16 ageUs
+// The channel's falling edge was at timeUs - ageUs. Only channels that
+// changed are listed; the first ticks after `trace on` list all 12
+// (the last two go out a tick later, a frame holds 10 at most).
+#define INPUT_TRACE_HEADER_BYTES  7
+#define INPUT_TRACE_ENTRY_BYTES   5
+#define INPUT_TRACE_MAX_ENTRIES   10   // Keeps a frame within TELEMETRY_MAX_PAYLOAD
+
+struct InputTraceStats {
+  unsigned long frames;          // Frames queued on the telemetry ring
+  unsigned long deferred;        // Ticks whose changes waited for ring room
+};
+
+extern InputTraceStats inputTraceStats;
+
+// ---------- Setup & Loop ----------
+void startInputTrace();
+void stopInputTrace();
+bool isInputTraceActive();
+void recordInputTrace();         // Control tick, right after updateInputFrame()
+
+#endif
@@ -0,0 +1,222 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                  LatencyTrace.cpp - Shadow-RC System               ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Measures what the operator actually feels: the time from a        ║
+  ║ receiver edge to the byte that makes R2 move, light up or speak.  ║
+  ║ The loop probes (Profiler.cpp) only show where CPU time goes.     ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - The tag is the capture timestamp the ISRs already store
+    (`pwmFallMicros[]`, set in `ch2_fall()` etc.), which
+    `updateInputFrame()` copies into `inputFrame.lastEdge[]`.
+  - Sticks: the control tick compares each motor slot before and
+    after the mode loop. A slot that changed on a fresh stick frame
+    is tagged with that stick's edge (CH2A → drive, CH1A → turn,
+    CH1B → dome). A value coalesced on the bus keeps its oldest tag.
+    When MotorBus queues the slot's packet, the sample is
+    edge → its last stop bit on the wire, computed from the bytes in
+    the Serial2 TX buffer at the current baud rate.
+  - Buttons: the combo / MP3 code calls `traceOutputLatency()` right
+    after its Serial1 / Serial3 write, with the CH3–CH6 channel whose
+    edge fired it. That edge is the falling edge of the pulse the
+    decision was taken on (sampled by the Timer3 button sampler).
+  - Each path keeps the newest LATENCY_SAMPLES samples; `latency`
+    prints p50 / p90 / p99 over that window plus the worst since
+    `reset`.
+
+  SCOPE CHECK:
+  ─────────────────────────────────────────────────────────────────────
+  Set LATENCY_GPIO_IN_PIN / LATENCY_GPIO_OUT_PIN and pick a channel
+  with LATENCY_GPIO_CHANNEL. Probe the receiver wire, both pins and
+  TX2 (pin 16) or TX1 (pin 18): IN shows ISR latency, OUT shows the
+  write into the TX buffer and TX shows the bytes leaving.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `LatencyTrace.cpp`
+  Header:    `LatencyTrace.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "LatencyTrace.h"
+
+#if LATENCY_TRACE
+
+#include "MotorBus.h"
+#include <Arduino.h>
+
+#define LATENCY_TAG_MAX_US  65535UL   // Samples are uint16_t; older tags are dropped
+
+LatencyStats latencyStats[LATENCY_PATH_COUNT];
+volatile uint8_t* latencyInPinReg;
+uint8_t latencyInPinMask;
+
+static volatile uint8_t* latencyOutPinReg;
+static uint8_t latencyOutPinMask;
+
+// Stick channel behind each motor slot
+static const uint8_t slotChannel[MOTOR_SLOT_COUNT] = { PWM_CH2A, PWM_CH1A, PWM_CH1B };
+
+static int           slotBefore[MOTOR_SLOT_COUNT];
+static bool          slotTagged[MOTOR_SLOT_COUNT];
+static unsigned long slotTagUs[MOTOR_SLOT_COUNT];
+
+static const char pathNames[LATENCY_PATH_COUNT][17] PROGMEM = {
+  "stick>motor", "button>marcduino", "button>mp3"
+};
+
+// ==========================
+//          SETUP
+// ==========================
+void setupLatencyTrace() {
+  if (LATENCY_GPIO_IN_PIN >= 0) {
+    pinMode(LATENCY_GPIO_IN_PIN, OUTPUT);
+    latencyInPinReg  = portInputRegister(digitalPinToPort(LATENCY_GPIO_IN_PIN));   // Writing PINx toggles
+    latencyInPinMask = digitalPinToBitMask(LATENCY_GPIO_IN_PIN);
+  }
+  if (LATENCY_GPIO_OUT_PIN >= 0) {
+    pinMode(LATENCY_GPIO_OUT_PIN, OUTPUT);
+    latencyOutPinReg  = portInputRegister(digitalPinToPort(LATENCY_GPIO_OUT_PIN));
+    latencyOutPinMask = digitalPinToBitMask(LATENCY_GPIO_OUT_PIN);
+  }
+  resetLatencyStats();
+}
+
+// ==========================
+//         SAMPLES
+// ==========================
+static void addSample(uint8_t path, uint8_t channel, unsigned long edgeUs, unsigned long doneUs) {
+  LatencyStats &s = latencyStats[path];
+  unsigned long us = doneUs - edgeUs;
+  if (us > LATENCY_TAG_MAX_US) {
+    s.expired++;
+    return;
+  }
+
+  s.samples[s.next] = us;
+  s.next = (s.next + 1) % LATENCY_SAMPLES;
+  s.count++;
+  if (us > s.maxUs) s.maxUs = us;
+
+  if (LATENCY_GPIO_OUT_PIN >= 0 && channel == LATENCY_GPIO_CHANNEL) *latencyOutPinReg = latencyOutPinMask;
+}
+
+// ==========================
+//   STICK → MOTOR PACKET
+// ==========================
+void beginMotorLatency() {
+  for (uint8_t i = 0; i < MOTOR_SLOT_COUNT; i++) slotBefore[i] = getMotorPower((MotorSlot)i);
+}
+
+void tagMotorLatency() {
+  for (uint8_t i = 0; i < MOTOR_SLOT_COUNT; i++) {
+    uint8_t ch = slotChannel[i];
+    if (slotTagged[i] || !inputFrame.fresh[ch]) continue;
+    if (getMotorPower((MotorSlot)i) == slotBefore[i]) continue;
+    slotTagged[i] = true;
+    slotTagUs[i]  = inputFrame.lastEdge[ch];
+  }
+}
+
+void traceMotorPacket(uint8_t slot, bool changed) {
+  if (!slotTagged[slot]) return;
+  slotTagged[slot] = false;
+
+  // A keepalive means the tagged value was coalesced back before it went out
+  if (!changed) {
+    latencyStats[LATENCY_STICK_TO_MOTOR].expired++;
+    return;
+  }
+
+  // Everything still in the TX buffer (this packet included) at 10 bits per byte (8N1)
+  long inBuffer = (SERIAL_TX_BUFFER_SIZE - 1) - MOTOR_BUS_PORT.availableForWrite();
+  unsigned long wireUs = (unsigned long)inBuffer * 10000000UL / motorBusStats.baudRate;
+  addSample(LATENCY_STICK_TO_MOTOR, slotChannel[slot], slotTagUs[slot], micros() + wireUs);
+}
+
+// ==========================
+//   BUTTON → SERIAL1 / 3
+// ==========================
+void traceOutputLatency(uint8_t path, uint8_t channel) {
+  if (channel >= PWM_CHANNEL_COUNT || inputFrame.lastEdge[channel] == 0) return;
+  addSample(path, channel, inputFrame.lastEdge[channel], micros());
+}
+
+// ==========================
+//   REPORT (row at a time)
+// ==========================
+#define REPORT_IDLE  0xFF
+
+static uint8_t reportRow = REPORT_IDLE;
+
+void startLatencyReport() {
+  reportRow = 0;
+}
+
+// Nearest-rank percentile of an ascending list
+static uint16_t percentile(const uint16_t* sorted, uint8_t n, uint8_t pct) {
+  uint8_t rank = ((uint16_t)n * pct + 99) / 100;
+  return sorted[rank ? rank - 1 : 0];
+}
+
+// Two rows per path, each shorter than the 63 bytes the TX buffer takes at once
+static void printPathRow(uint8_t path, bool percentiles) {
+  const LatencyStats &s = latencyStats[path];
+
+  if (!percentiles) {
+    Serial.print((const __FlashStringHelper*)pathNames[path]);
+    Serial.print(F(": n="));
+    Serial.print(s.count);
+    Serial.print(F(" max="));
+    Serial.print(s.maxUs);
+    Serial.print(F(" lost="));
+    Serial.println(s.expired);
+    return;
+  }
+
+  uint8_t n = s.count < LATENCY_SAMPLES ? s.count : LATENCY_SAMPLES;
+  if (n == 0) {
+    Serial.println(F("  no samples"));
+    return;
+  }
+
+  uint16_t sorted[LATENCY_SAMPLES];
+  for (uint8_t i = 0; i < n; i++) {       // Insertion sort: 64 entries, background task
+    uint16_t v = s.samples[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > v) { sorted[j] = sorted[j - 1]; j--; }
+    sorted[j] = v;
+  }
+
+  Serial.print(F("  p50="));
+  Serial.print(percentile(sorted, n, 50));
+  Serial.print(F(" p90="));
+  Serial.print(percentile(sorted, n, 90));
+  Serial.print(F(" p99="));
+  Serial.println(percentile(sorted, n, 99));
+}
+
+void updateLatencyReport() {
+  if (reportRow == REPORT_IDLE) return;
+  if (Serial.availableForWrite() < SERIAL_TX_BUFFER_SIZE - 1) return;  // Wait for an empty buffer
+
+  if (reportRow == 0) Serial.println(F("=== Input > Output Latency (us) ==="));
+  else if (reportRow <= LATENCY_PATH_COUNT * 2) printPathRow((reportRow - 1) / 2, (reportRow - 1) % 2);
+  else {
+    reportRow = REPORT_IDLE;
+    return;
+  }
+  reportRow++;
+}
+
+void resetLatencyStats() {
+  memset(latencyStats, 0, sizeof(latencyStats));
+  for (uint8_t i = 0; i < MOTOR_SLOT_COUNT; i++) slotTagged[i] = false;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                 LatencyTrace.h - Shadow-RC                 ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for end-to-end input → output latency tracing.      ║
+  ║ Receiver edge timestamps are carried to the Serial1 /      ║
+  ║ Serial2 write; the `latency` command prints percentiles.   ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are adding a traced path.           ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <Arduino.h>
+#include "PWMInputHandler.h"   // PWMChannel for LATENCY_GPIO_CHANNEL
+
+// ---------- Trace Settings ----------
+#define LATENCY_TRACE          0      // 1 = trace (384 bytes SRAM); 0 = hooks compile to nothing
+#define LATENCY_SAMPLES        64     // Newest samples kept per path (percentile window)
+
+// Optional scope / logic-analyzer marks: each pin toggles once per event.
+// IN toggles in the ISR on every falling edge of LATENCY_GPIO_CHANNEL,
+// OUT toggles when an output traced back to that channel is written.
+#define LATENCY_GPIO_IN_PIN    -1     // e.g. 40; -1 = off
+#define LATENCY_GPIO_OUT_PIN   -1     // e.g. 41; -1 = off
+#define LATENCY_GPIO_CHANNEL   PWM_CH2A
+
+enum LatencyPath {
+  LATENCY_STICK_TO_MOTOR = 0,   // CH1A / CH2A / CH1B edge → Sabertooth / SyRen packet done on Serial2
+  LATENCY_BUTTON_TO_MARCDUINO,  // CH3–CH6 edge → triggerMarcDuinoSequence() write
+  LATENCY_BUTTON_TO_MP3,        // CH3–CH6 edge → playMP3Track() write
+  LATENCY_PATH_COUNT
+};
+
+struct LatencyStats {
+  unsigned long count;                    // Samples since reset
+  unsigned long expired;                  // Tags dropped (input never reached the wire)
+  uint16_t      maxUs;                    // Worst since reset
+  uint16_t      samples[LATENCY_SAMPLES]; // Ring of the newest samples in µs
+  uint8_t       next;
+};
+
+#if LATENCY_TRACE
+extern LatencyStats latencyStats[LATENCY_PATH_COUNT];
+extern volatile uint8_t* latencyInPinReg;
+extern uint8_t latencyInPinMask;
+
+// ISR side: toggle the IN pin (one write to PINx, ~0.1 µs)
+static inline void markLatencyInput(uint8_t channel) {
+  if (LATENCY_GPIO_IN_PIN >= 0 && channel == LATENCY_GPIO_CHANNEL) *latencyInPinReg = latencyInPinMask;
+}
+
+// ---------- Hooks ----------
+void setupLatencyTrace();
+void beginMotorLatency();                 // Control tick, before the mode loop
+void tagMotorLatency();                   // Control tick, after the mode loop
+void traceMotorPacket(uint8_t slot, bool changed);  // MotorBus, right after a packet is queued
+void traceOutputLatency(uint8_t path, uint8_t channel);              // Right after a Serial1 / Serial3 write
+
+// ---------- Report ----------
+void startLatencyReport();                // Printed a row at a time
+void updateLatencyReport();
+void resetLatencyStats();
+#else
+static inline void markLatencyInput(uint8_t) {}
+static inline void setupLatencyTrace() {}
+static inline void beginMotorLatency() {}
+static inline void tagMotorLatency() {}
+static inline void traceMotorPacket(uint8_t, bool) {}
+static inline void traceOutputLatency(uint8_t, uint8_t) {}
+static inline void startLatencyReport() {}
+static inline void updateLatencyReport() {}
+static inline void resetLatencyStats() {}
+#endif
+
+#endif
@@ -10,6 +10,7 @@ MP3Trigger::MP3Trigger()
 {
 	mDoLoop = false;
 	mPlaying = false;
+	mCancels = 0;
 }
 
 MP3Trigger::~MP3Trigger()
@@ -48,12 +49,17 @@ void MP3Trigger::setLoopingTrack(byte track)
 	mLoopTrack = track;
 }
 
+// Reads every reply waiting, never blocks.
+// 'X' = track finished, 'x' = track cancelled, 'E' = file not found.
 void MP3Trigger::update()
 {
-	if( s->available() )
+	while( s->available() )
 	{
 		int data = s->read();
-		if(char(data) == 'X' || char(data) == 'x')
+		if(char(data) == 'x' && mCancels > 0)
+		{
+			mCancels--;			//the old track; the new one is still playing
+		} else if(char(data) == 'X' || char(data) == 'x')
 		{
 			if(mDoLoop)
 			{	
@@ -69,6 +75,11 @@ void MP3Trigger::update()
 	}
 }
 
+bool MP3Trigger::isPlaying()
+{
+	return mPlaying;
+}
+
 void MP3Trigger::loop()
 {
 	trigger(mLoopTrack);
@@ -114,6 +125,7 @@ void MP3Trigger::trigger(byte track)
 {
 	s->write('t');
 	s->write(track);
+	if(mPlaying && mCancels < 255) mCancels++;
 	mPlaying = true;
 }
 
@@ -121,6 +133,7 @@ void MP3Trigger::play(byte track)
 {
 	s->write('p');
 	s->write(track);
+	if(mPlaying && mCancels < 255) mCancels++;
 	mPlaying = true;
 }
 
@@ -33,11 +33,13 @@ class MP3Trigger{
 	void setLooping(bool doLoop, byte track);		//turn looping on/off
 	void setLoopingTrack(byte track);	//select the track to loop
 	void update();						//make sure to call this during your loop()
+	bool isPlaying();					//false after 'X' (done), 'E' (error) or a stop
 	
 private:
 	bool mDoLoop;
 	byte mLoopTrack;
 	bool mPlaying;
+	byte mCancels;						//'x' replies owed for tracks a trigger cut short
 	void loop();
 	HardwareSerial* s;
 };
@@ -45,18 +45,66 @@ void Sabertooth::autobaud(SabertoothStream& port, boolean dontWait)
   if (!dontWait) { delay(500); }
 }
 
+void Sabertooth::buildPacket(byte* packet, byte command, byte value) const
+{
+  packet[0] = address();
+  packet[1] = command;
+  packet[2] = value;
+  packet[3] = (address() + command + value) & B01111111;
+}
+
 void Sabertooth::command(byte command, byte value) const
 {
-  port().write(address());
-  port().write(command);
-  port().write(value);
-  port().write((address() + command + value) & B01111111);
+  byte packet[SABERTOOTH_PACKET_SIZE];
+  buildPacket(packet, command, value);
+  port().write(packet, SABERTOOTH_PACKET_SIZE);
 }
 
-void Sabertooth::throttleCommand(byte command, int power) const
+boolean Sabertooth::tryCommand(byte command, byte value) const
+{
+#if defined(ARDUINO) && ARDUINO >= 100
+  if (port().availableForWrite() < SABERTOOTH_PACKET_SIZE) { return false; }
+  
+  byte packet[SABERTOOTH_PACKET_SIZE];
+  buildPacket(packet, command, value);
+  port().write(packet, SABERTOOTH_PACKET_SIZE);
+  return true;
+#else
+  return false;
+#endif
+}
+
+boolean Sabertooth::tryGet(byte type, byte targetNumber, byte targetType) const
+{
+#if defined(ARDUINO) && ARDUINO >= 100
+  if (port().availableForWrite() < SABERTOOTH_GET_PACKET_SIZE) { return false; }
+  
+  byte packet[SABERTOOTH_GET_PACKET_SIZE];
+  buildPacket(packet, SABERTOOTH_COMMAND_GET, type);
+  packet[4] = targetType;
+  packet[5] = '0' + targetNumber;
+  packet[6] = (packet[4] + packet[5]) & B01111111;
+  port().write(packet, SABERTOOTH_GET_PACKET_SIZE);
+  return true;
+#else
+  return false;
+#endif
+}
+
+byte Sabertooth::throttleValue(int power)
 {
   power = constrain(power, -126, 126);
-  this->command(command, (byte)abs(power));
+  return (byte)abs(power);
+}
+
+void Sabertooth::throttleCommand(byte command, int power) const
+{
+  this->command(command, throttleValue(power));
+}
+
+boolean Sabertooth::tryThrottleCommand(byte command, int power) const
+{
+  return tryCommand(command, throttleValue(power));
 }
 
 void Sabertooth::motor(int power) const
@@ -86,6 +134,27 @@ void Sabertooth::stop() const
   motor(2, 0);
 }
 
+boolean Sabertooth::tryMotor(int power) const
+{
+  return tryMotor(1, power);
+}
+
+boolean Sabertooth::tryMotor(byte motor, int power) const
+{
+  if (motor < 1 || motor > 2) { return false; }
+  return tryThrottleCommand((motor == 2 ? 4 : 0) + (power < 0 ? 1 : 0), power);
+}
+
+boolean Sabertooth::tryDrive(int power) const
+{
+  return tryThrottleCommand(power < 0 ? 9 : 8, power);
+}
+
+boolean Sabertooth::tryTurn(int power) const
+{
+  return tryThrottleCommand(power < 0 ? 11 : 10, power);
+}
+
 void Sabertooth::setMinVoltage(byte value) const
 {
   command(2, (byte)min(value, 120));
@@ -102,16 +171,7 @@ void Sabertooth::setBaudRate(long baudRate) const
   port().flush();
 #endif
 
-  byte value;
-  switch (baudRate)
-  {
-  case 2400:           value = 1; break;
-  case 9600: default: value = 2; break;
-  case 19200:          value = 3; break;
-  case 38400:          value = 4; break;
-  case 115200:         value = 5; break;
-  }
-  command(15, value);
+  command(15, baudRateValue(baudRate));
   
 #if defined(ARDUINO) && ARDUINO >= 100
   port().flush();
@@ -126,6 +186,18 @@ void Sabertooth::setBaudRate(long baudRate) const
   delay(500);
 }
 
+byte Sabertooth::baudRateValue(long baudRate)
+{
+  switch (baudRate)
+  {
+  case 2400:           return 1;
+  case 9600: default: return 2;
+  case 19200:          return 3;
+  case 38400:          return 4;
+  case 115200:         return 5;
+  }
+}
+
 void Sabertooth::setDeadband(byte value) const
 {
   command(17, (byte)min(value, 127));
@@ -140,3 +212,137 @@ void Sabertooth::setTimeout(int milliseconds) const
 {
   command(14, (byte)((constrain(milliseconds, 0, 12700) + 99) / 100));
 }
+
+SabertoothReplyParser::SabertoothReplyParser()
+{
+  reset();
+}
+
+void SabertoothReplyParser::reset()
+{
+  _length = 0;
+}
+
+boolean SabertoothReplyParser::feed(byte data)
+{
+  // Resynchronize on the address byte: addresses are 128-135, every other byte is 7-bit.
+  if (data & 0x80) { _length = 0; }
+  else if (_length == 0) { return false; }
+  
+  _buffer[_length++] = data;
+  if (_length < SABERTOOTH_REPLY_PACKET_SIZE) { return false; }
+  _length = 0;
+  
+  if (_buffer[1] != SABERTOOTH_COMMAND_REPLY) { return false; }
+  if (((_buffer[0] + _buffer[1] + _buffer[2]) & B01111111) != _buffer[3]) { return false; }
+  if (((_buffer[4] + _buffer[5] + _buffer[6] + _buffer[7]) & B01111111) != _buffer[8]) { return false; }
+  
+  int value = _buffer[4] | ((int)_buffer[5] << 7);
+  
+  _reply.address      = _buffer[0];
+  _reply.type         = _buffer[2] & 0x7E;
+  _reply.targetType   = _buffer[6];
+  _reply.targetNumber = _buffer[7];
+  _reply.value        = (_buffer[2] & 0x01) ? -value : value;
+  return true;
+}
+
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE 64
+#endif
+
+SabertoothBaudChange::SabertoothBaudChange(HardwareSerial& port)
+  : _port(port), _state(SABERTOOTH_BAUD_IDLE), _fromBaud(9600), _toBaud(9600), _baudRate(9600),
+    _addresses(0), _count(0), _sent(0), _verifyAddress(0), _attempts(0), _autobaud(true), _stateMicros(0)
+{
+
+}
+
+void SabertoothBaudChange::enter(SabertoothBaudState state)
+{
+  _state       = state;
+  _stateMicros = micros();
+}
+
+void SabertoothBaudChange::start(long fromBaud, long toBaud, const byte* addresses, byte count,
+                                 byte verifyAddress, boolean sendAutobaud)
+{
+  _fromBaud      = fromBaud;
+  _toBaud        = toBaud;
+  _addresses     = addresses;
+  _count         = count;
+  _sent          = 0;
+  _verifyAddress = verifyAddress;
+  _attempts      = 0;
+  _autobaud      = sendAutobaud;
+  
+  _port.begin(fromBaud);
+  _baudRate = fromBaud;
+  
+  if (fromBaud != toBaud) { enter(SABERTOOTH_BAUD_SENDING); return; }
+  
+  // Nothing to change: just sync any autobauding drivers at this rate.
+  if (_autobaud) { _port.write(0xAA); }
+  enter(SABERTOOTH_BAUD_UNVERIFIED);
+}
+
+SabertoothBaudState SabertoothBaudChange::update()
+{
+  switch (_state)
+  {
+  case SABERTOOTH_BAUD_SENDING:
+    while (_sent < _count)
+    {
+      Sabertooth driver(_addresses[_sent], _port);
+      if (!driver.tryCommand(15, Sabertooth::baudRateValue(_toBaud))) { return _state; }
+      _sent++;
+    }
+    enter(SABERTOOTH_BAUD_DRAINING);
+    break;
+  
+  case SABERTOOTH_BAUD_DRAINING:
+    // Empty buffer still leaves up to two bytes in the UART itself.
+    if (_port.availableForWrite() < SERIAL_TX_BUFFER_SIZE - 1) { _stateMicros = micros(); return _state; }
+    if (micros() - _stateMicros < 20000000UL / _fromBaud) { return _state; }
+    _port.begin(_toBaud);
+    _baudRate = _toBaud;
+    enter(SABERTOOTH_BAUD_RESTARTING);
+    break;
+  
+  case SABERTOOTH_BAUD_RESTARTING:
+    if (micros() - _stateMicros < SABERTOOTH_BAUD_RESTART_MICROS) { return _state; }
+    if (_autobaud) { _port.write(0xAA); _autobaud = false; }  // Older drivers detect the new rate from this
+    if (!_verifyAddress) { enter(SABERTOOTH_BAUD_UNVERIFIED); break; }
+    while (_port.available()) { _port.read(); }
+    _parser.reset();
+    if (!Sabertooth(_verifyAddress, _port).tryGet(SABERTOOTH_GET_BATTERY, 1)) { return _state; }
+    _attempts++;
+    enter(SABERTOOTH_BAUD_VERIFYING);
+    break;
+  
+  case SABERTOOTH_BAUD_VERIFYING:
+    while (_port.available())
+    {
+      if (_parser.feed(_port.read()) && _parser.reply().address == _verifyAddress)
+      {
+        enter(SABERTOOTH_BAUD_DONE);
+        return _state;
+      }
+    }
+    if (micros() - _stateMicros < SABERTOOTH_BAUD_VERIFY_MICROS) { return _state; }
+    if (_attempts < SABERTOOTH_BAUD_VERIFY_TRIES)
+    {
+      if (Sabertooth(_verifyAddress, _port).tryGet(SABERTOOTH_GET_BATTERY, 1)) { _attempts++; _stateMicros = micros(); }
+      return _state;
+    }
+    _port.begin(_fromBaud);
+    _baudRate = _fromBaud;
+    enter(SABERTOOTH_BAUD_FAILED);
+    break;
+  
+  default:
+    break;
+  }
+  
+  return _state;
+}
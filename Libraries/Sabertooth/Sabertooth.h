@@ -34,6 +34,35 @@ typedef Print SabertoothStream;
 #endif
 #define SyRenTXPinSerial SabertoothTXPinSerial
 
+#define SABERTOOTH_PACKET_SIZE        4   //!< Bytes in a standard Packet Serial command.
+#define SABERTOOTH_GET_PACKET_SIZE    7   //!< Bytes in a get request.
+#define SABERTOOTH_REPLY_PACKET_SIZE  9   //!< Bytes in a get reply.
+
+#define SABERTOOTH_BAUD_RESTART_MICROS 250000UL //!< Drivers restart after a baud rate change and take about 200 ms to respond again.
+#define SABERTOOTH_BAUD_VERIFY_MICROS  100000UL //!< Wait for a get reply at the new baud rate, per try.
+#define SABERTOOTH_BAUD_VERIFY_TRIES   3        //!< Get requests sent at the new baud rate before giving up.
+
+#define SABERTOOTH_COMMAND_GET        41  //!< Get request (Sabertooth 2x32 and other V2 drivers with replies).
+#define SABERTOOTH_COMMAND_REPLY      73  //!< Reply to a get request.
+
+#define SABERTOOTH_GET_VALUE          0x00 //!< Get type: the current motor command.
+#define SABERTOOTH_GET_BATTERY        0x10 //!< Get type: battery voltage, in tenths of a volt.
+#define SABERTOOTH_GET_CURRENT        0x20 //!< Get type: motor current, in tenths of an amp.
+#define SABERTOOTH_GET_TEMPERATURE    0x40 //!< Get type: temperature, in degrees Celsius.
+
+/*!
+\struct SabertoothReply
+\brief A decoded reply to a get request.
+*/
+struct SabertoothReply
+{
+  byte address;      //!< The driver that replied.
+  byte type;         //!< The get type (SABERTOOTH_GET_*).
+  byte targetType;   //!< 'M' for motor, 'P' for power output.
+  byte targetNumber; //!< '1' or '2'.
+  int  value;        //!< The value. Units depend on the get type.
+};
+
 /*!
 \class Sabertooth
 \brief Controls a %Sabertooth or %SyRen motor driver running in Packet Serial mode.
@@ -89,6 +118,26 @@ public:
   */
   void command(byte command, byte value) const;
   
+  /*!
+  Sends a packet serial command to the motor driver, but only if it fits in the port's transmit buffer.
+  The whole packet is written at once, so it is never split by a full buffer.
+  Ports that do not report availableForWrite() (it returns 0) always report "would block".
+  \param command The number of the command.
+  \param value   The command's value.
+  \return true if the packet was queued, false if sending it now would block.
+  */
+  boolean tryCommand(byte command, byte value) const;
+  
+  /*!
+  Requests a value from the motor driver without blocking. The reply (if the driver sends one)
+  arrives on the driver's S2 line and can be decoded with SabertoothReplyParser.
+  \param type         The get type (SABERTOOTH_GET_*).
+  \param targetNumber The motor number, 1 or 2.
+  \param targetType   'M' for motor (default), 'P' for power output.
+  \return true if the request was queued, false if sending it now would block.
+  */
+  boolean tryGet(byte type, byte targetNumber, byte targetType = 'M') const;
+  
 public:
   /*!
   Sets the power of motor 1.
@@ -120,6 +169,30 @@ public:
   */
   void stop() const;
   
+  /*!
+  Non-blocking version of motor(int).
+  \return true if the packet was queued, false if sending it now would block.
+  */
+  boolean tryMotor(int power) const;
+  
+  /*!
+  Non-blocking version of motor(byte, int).
+  \return true if the packet was queued, false if sending it now would block.
+  */
+  boolean tryMotor(byte motor, int power) const;
+  
+  /*!
+  Non-blocking version of drive().
+  \return true if the packet was queued, false if sending it now would block.
+  */
+  boolean tryDrive(int power) const;
+  
+  /*!
+  Non-blocking version of turn().
+  \return true if the packet was queued, false if sending it now would block.
+  */
+  boolean tryTurn(int power) const;
+  
 public:
   /*!
   Sets the minimum voltage.
@@ -168,12 +241,142 @@ public:
   */
   void setTimeout(int milliseconds) const;
   
+  /*!
+  Gets the Packet Serial value for a baud rate.
+  \param baudRate The baud rate. This can be 2400, 9600, 19200, 38400, or on some drivers 115200.
+  \return The value sent with the set baud rate command.
+  */
+  static byte baudRateValue(long baudRate);
+  
 private:
   void throttleCommand(byte command, int power) const;
+  boolean tryThrottleCommand(byte command, int power) const;
+  void buildPacket(byte* packet, byte command, byte value) const;
+  static byte throttleValue(int power);
   
 private:
   const byte        _address;
   SabertoothStream& _port; 
 };
 
+/*!
+\class SabertoothReplyParser
+\brief Decodes get replies one byte at a time, for use from a non-blocking loop.
+*/
+class SabertoothReplyParser
+{
+public:
+  /*!
+  Initializes a new instance of the SabertoothReplyParser class.
+  */
+  SabertoothReplyParser();
+  
+  /*!
+  Feeds one received byte to the parser.
+  \param data The byte.
+  \return true if the byte completed a reply with valid checksums. Read it with reply().
+  */
+  boolean feed(byte data);
+  
+  /*!
+  Gets the last complete reply.
+  \return The reply.
+  */
+  inline const SabertoothReply& reply() const { return _reply; }
+  
+  /*!
+  Discards a partially received reply.
+  */
+  void reset();
+  
+private:
+  byte            _buffer[SABERTOOTH_REPLY_PACKET_SIZE];
+  byte            _length;
+  SabertoothReply _reply;
+};
+
+/*!
+\enum SabertoothBaudState
+\brief Progress of a SabertoothBaudChange.
+*/
+enum SabertoothBaudState
+{
+  SABERTOOTH_BAUD_IDLE = 0,   //!< Not started.
+  SABERTOOTH_BAUD_SENDING,    //!< Sending the set baud rate command at the old baud rate.
+  SABERTOOTH_BAUD_DRAINING,   //!< Waiting for the command to leave the transmit buffer.
+  SABERTOOTH_BAUD_RESTARTING, //!< Drivers restart after a baud rate change.
+  SABERTOOTH_BAUD_VERIFYING,  //!< Waiting for a get reply at the new baud rate.
+  SABERTOOTH_BAUD_DONE,       //!< Running at the new baud rate; a driver replied at it.
+  SABERTOOTH_BAUD_UNVERIFIED, //!< Running at the new baud rate; nothing could reply to confirm.
+  SABERTOOTH_BAUD_FAILED      //!< No reply at the new baud rate; the port is back at the old one.
+};
+
+/*!
+\class SabertoothBaudChange
+\brief Moves a shared Packet Serial line to a new baud rate without blocking.
+
+Call start() once, then update() from loop() until it returns DONE, UNVERIFIED or FAILED.
+Unlike Sabertooth::setBaudRate(), nothing here calls flush() or delay().
+The set baud rate command is stored in the drivers' EEPROM, and sending it at a baud rate
+that a driver is not listening at is harmless, so it is safe to run at every startup.
+*/
+class SabertoothBaudChange
+{
+public:
+  /*!
+  Initializes a new instance of the SabertoothBaudChange class.
+  \param port The hardware serial port the drivers are connected to.
+  */
+  SabertoothBaudChange(HardwareSerial& port);
+  
+  /*!
+  Starts moving the line to a new baud rate.
+  \param fromBaud      The baud rate the drivers are listening at now.
+  \param toBaud        The new baud rate.
+  \param addresses     The driver addresses to send the command to.
+  \param count         The number of addresses.
+  \param verifyAddress A driver that can reply to get requests, or 0 if none can (skips verification).
+  \param sendAutobaud  If true, the autobaud character is sent once the line is at the new baud rate,
+                       so drivers that detect the baud rate (instead of storing it) follow too.
+  */
+  void start(long fromBaud, long toBaud, const byte* addresses, byte count,
+             byte verifyAddress = 0, boolean sendAutobaud = true);
+  
+  /*!
+  Advances the baud rate change. Never blocks.
+  \return The current state.
+  */
+  SabertoothBaudState update();
+  
+  /*!
+  Gets the current state.
+  \return The current state.
+  */
+  inline SabertoothBaudState state() const { return _state; }
+  
+  /*!
+  Gets the baud rate the port is running at.
+  \return The baud rate.
+  */
+  inline long baudRate() const { return _baudRate; }
+  
+private:
+  void enter(SabertoothBaudState state);
+  
+private:
+  HardwareSerial&       _port;
+  SabertoothBaudState   _state;
+  long                  _fromBaud;
+  long                  _toBaud;
+  long                  _baudRate;
+  const byte*           _addresses;
+  byte                  _count;
+  byte                  _sent;
+  byte                  _verifyAddress;
+  byte                  _attempts;
+  boolean               _autobaud;
+  unsigned long         _stateMicros;
+  SabertoothReplyParser _parser;
+};
+
 #endif
@@ -17,9 +17,12 @@
       • Happy, Sad, Talking, Yelling
       • Classic, Dance, Singing, Lines
   - PWM input edge detection (toggle-based and momentary support)
+    using the background button sampler in `PWMInputHandler.cpp`
   - Randomized file selection from each category’s track range
   - Automatic debounce and suppression during combo input or MarcDuino use
   - Serial1 (TX1 / pin 18) output to MP3 Trigger (SparkFun-compatible)
+  - No boot delay: the board gets `MP3_BOARD_BOOT_MS` to start up while
+    the droid already drives; button triggers wait until it has
 
   SOUND BANK ORGANIZATION:
   ─────────────────────────────────────────────────────────────────────
@@ -43,6 +46,23 @@
 
   - Each bank has **up to 15 free slots** for expansion, depending on usage.
 
+  PLAYBACK QUEUE:
+  ─────────────────────────────────────────────────────────────────────
+  Every sound goes through `playMP3(track, priority)`; only the queue
+  writes to the board (MP3 Trigger, YX5300 and DFPlayer alike).
+    - Nothing playing → sent at once.
+    - Playing: MODE cuts anything short. USER cuts USER / AMBIENT
+      short, and a long track (Dance / Singing) only with
+      `MP3_PREEMPT_LONG_TRACKS`; otherwise it waits. AMBIENT never
+      cuts in and never waits: chatter that missed the silence is
+      dropped.
+    - One waiting request per priority, newest wins; the mp3 task
+      starts it as soon as the rules allow (or the TX buffer has room).
+  "Playing" is the track's assumed length (`MP3_TRACK_MS`, or
+  `MP3_LONG_TRACK_MS` for 151–186). With `MP3_STATUS_FEEDBACK` the
+  MP3 Trigger's own 'X' / 'E' reply ends it early, but its TX has to
+  reach RX1 (pin 19), which is dome encoder A: move the encoder first.
+
   MARCDUINO COMPATIBILITY:
   ─────────────────────────────────────────────────────────────────────
   - `disableMP3Triggers()` and `enableMP3Triggers()` provide full integration
@@ -61,9 +81,9 @@
 
   DEBUGGING:
   ─────────────────────────────────────────────────────────────────────
-  Serial monitor displays:
+  Serial monitor displays (LOG_LEVEL_MP3, DebugLog.h):
     - Track type and ID number on every successful trigger
-    - Trigger suppression status
+    - Trigger suppression status (as a telemetry event, once per change)
     - Real-time feedback during combo overrides
 
   ⚠️  WARNING: DO NOT EDIT UNLESS YOU KNOW WHAT YOU ARE DOING ⚠️
@@ -91,8 +111,18 @@
 
 #include "MP3Handler.h"
 #include "ComboHandler.h"
+#include "PWMInputHandler.h"
+#include "LatencyTrace.h"
 #include <Arduino.h>
 #include <MP3Trigger.h>
+#include "Telemetry.h"
+#include "Startup.h"
+#include "InputPins.h"
+#include "DebugLog.h"
+
+#if MP3_STATUS_FEEDBACK && (DOME_ENCODER_PIN_A == 19 || DOME_ENCODER_PIN_B == 19)
+#error "MP3_STATUS_FEEDBACK reads RX1 (pin 19), which is wired to the dome encoder"
+#endif
 
 // ──────────────────────────────────────────────────────────────────────
 // SELECT YOUR MP3 BOARD HERE:
@@ -102,6 +132,16 @@
 // ──────────────────────────────────────────────────────────────────────
 #define ACTIVE_MP3_BOARD 1
 
+// Time the board needs after power-up before it takes commands;
+// triggers are held until then instead of blocking setup()
+#if ACTIVE_MP3_BOARD == 1
+#define MP3_BOARD_BOOT_MS 1000
+#define MP3_COMMAND_BYTES 2       // 't' + track
+#else
+#define MP3_BOARD_BOOT_MS 500
+#define MP3_COMMAND_BYTES 8       // 7E FF 06 03 00 00 track EF
+#endif
+
 // ─────────────────────────────────────────────────────────────────────────────
 // PIN DEFINITIONS — RC Channels (PWM Input Pins)
 // ─────────────────────────────────────────────────────────────────────────────
@@ -122,7 +162,6 @@ const int HIGH_THRESHOLD   = 1700;
 const int LOW_THRESHOLD    = 1300;
 const int CH6_HIGH_MIN     = 1985;
 const int CH6_HIGH_MAX     = 1995;
-const int DEBOUNCE_DELAY   = 50;
 const int VALID_PWM_MIN    = 900;
 const int VALID_PWM_MAX    = 2200;
 
@@ -146,10 +185,25 @@ const int BANK_SINGING_END    = 186;
 const int BANK_LINES_START    = 211;
 const int BANK_LINES_END      = 212;
 
+// Same ranges by MP3Bank, for combos (ComboHandler.cpp)
+static const int bankRanges[MP3_BANK_COUNT][2] = {
+  { BANK_HAPPY_START,   BANK_HAPPY_END },
+  { BANK_SAD_START,     BANK_SAD_END },
+  { BANK_TALKING_START, BANK_TALKING_END },
+  { BANK_YELLING_START, BANK_YELLING_END },
+  { BANK_CLASSIC_START, BANK_CLASSIC_END },
+  { BANK_DANCE_START,   BANK_DANCE_END },
+  { BANK_SINGING_START, BANK_SINGING_END },
+  { BANK_LINES_START,   BANK_LINES_END },
+};
+
 // ─────────────────────────────────────────────────────────────────────────────
 // STATE VARIABLES
 // ─────────────────────────────────────────────────────────────────────────────
 bool mp3TriggersEnabled = true;
+static bool mp3Blocked = false;   // Triggers held this pass (telemetry flag)
+static bool mp3Ready = false;     // Board finished booting
+static unsigned long mp3OpenedMs = 0;
 
 int lastMP3_CH3A = -1, lastMP3_CH4A = -1, lastMP3_CH5A = -1;
 int lastMP3_CH3B = -1, lastMP3_CH4B = -1, lastMP3_CH5B = -1;
@@ -159,6 +213,18 @@ bool hasTriggeredMP3_CH6B = false;
 
 int currentMP3 = 0;
 
+// Playback queue
+struct MP3Request {
+  int  track;
+  bool waiting;
+};
+
+static MP3Request    waitingTracks[MP3_PRIORITY_COUNT];
+static int8_t        playingPriority = -1;    // -1 = nothing playing
+static int           playingTrack = 0;
+static unsigned long playingSinceMs = 0;
+MP3Stats mp3Stats;
+
 // ─────────────────────────────────────────────────────────────────────────────
 // MP3 TRIGGER INSTANCE
 // ─────────────────────────────────────────────────────────────────────────────
@@ -167,9 +233,9 @@ MP3Trigger mp3;
 // ─────────────────────────────────────────────────────────────────────────────
 // FORWARD DECLARATIONS
 // ─────────────────────────────────────────────────────────────────────────────
-void checkToggleAnyEdge(int pin, int &lastState, int startFile, int endFile, const char* label);
-void checkMomentary(int pin, bool &hasTriggered, int startFile, int endFile, const char* label);
-void playMP3Track(int track);
+void checkToggleAnyEdge(PWMChannel channel, int &lastState, int startFile, int endFile, const __FlashStringHelper* label);
+void checkMomentary(PWMChannel channel, bool &hasTriggered, int startFile, int endFile, const __FlashStringHelper* label);
+static void playMP3Track(int track);
 
 // ─────────────────────────────────────────────────────────────────────────────
 // INITIALIZATION
@@ -178,12 +244,11 @@ void setupMP3Handler() {
 #if ACTIVE_MP3_BOARD == 1
   Serial1.begin(38400);     // SparkFun MP3 Trigger
   mp3.setup(&Serial1);
-  delay(1000);
-
 #else
   Serial1.begin(9600);      // YX5300 or DFPlayer
-  delay(500);               
 #endif
+  mp3Ready = false;
+  mp3OpenedMs = millis();   // Board boots in the background (MP3_BOARD_BOOT_MS)
 
   pinMode(CH3_PIN_A, INPUT);
   pinMode(CH4_PIN_A, INPUT);
@@ -196,17 +261,34 @@ void setupMP3Handler() {
   pinMode(CH6_PIN_B, INPUT);
 }
 
+static bool finishMP3Boot() {
+  if (millis() - mp3OpenedMs < MP3_BOARD_BOOT_MS) return false;
+  mp3Ready = true;
+  markStartupStep(STARTUP_MP3);
+  return true;
+}
+
+bool isMP3Ready() {
+  return mp3Ready;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // MAIN UPDATE LOOP
 // ─────────────────────────────────────────────────────────────────────────────
 void updateMP3Handler() {
-  if (!mp3TriggersEnabled || isComboModeActive(currentMode)) {
-    Serial.print(">> MP3Handler: Triggers disabled or combo active | ");
-    Serial.print("Enabled: ");
-    Serial.print(mp3TriggersEnabled ? "YES" : "NO");
-    Serial.print(" | Combo Active: ");
-    Serial.println(isComboModeActive(currentMode) ? "YES" : "NO");
+  if (!mp3Ready && !finishMP3Boot()) return;   // Board still booting
+  updateMP3Queue();
+
+  bool comboActive = isComboModeActive(currentMode);
 
+  // Reported once per change as a telemetry event (was a text line every pass)
+  bool blocked = !mp3TriggersEnabled || comboActive;
+  if (blocked != mp3Blocked) {
+    mp3Blocked = blocked;
+    logTelemetryEvent(TELEMETRY_EVENT_MP3_BLOCKED, blocked);
+  }
+
+  if (blocked) {
     lastMP3_CH3A = lastMP3_CH4A = lastMP3_CH5A = -1;
     lastMP3_CH3B = lastMP3_CH4B = lastMP3_CH5B = -1;
     hasTriggeredMP3_CH6A = hasTriggeredMP3_CH6B = false;
@@ -214,25 +296,23 @@ void updateMP3Handler() {
   }
 
   // Channel A
-  checkToggleAnyEdge(CH3_PIN_A, lastMP3_CH3A, BANK_HAPPY_START, BANK_HAPPY_END, "Happy");
-  checkToggleAnyEdge(CH4_PIN_A, lastMP3_CH4A, BANK_SAD_START, BANK_SAD_END, "Sad");
-  checkToggleAnyEdge(CH5_PIN_A, lastMP3_CH5A, BANK_TALKING_START, BANK_TALKING_END, "Talking");
-  checkMomentary(CH6_PIN_A, hasTriggeredMP3_CH6A, BANK_YELLING_START, BANK_YELLING_END, "Yelling");
+  checkToggleAnyEdge(PWM_CH3A, lastMP3_CH3A, BANK_HAPPY_START, BANK_HAPPY_END, F("Happy"));
+  checkToggleAnyEdge(PWM_CH4A, lastMP3_CH4A, BANK_SAD_START, BANK_SAD_END, F("Sad"));
+  checkToggleAnyEdge(PWM_CH5A, lastMP3_CH5A, BANK_TALKING_START, BANK_TALKING_END, F("Talking"));
+  checkMomentary(PWM_CH6A, hasTriggeredMP3_CH6A, BANK_YELLING_START, BANK_YELLING_END, F("Yelling"));
 
   // Channel B
-  checkToggleAnyEdge(CH3_PIN_B, lastMP3_CH3B, BANK_CLASSIC_START, BANK_CLASSIC_END, "Classic");
-  checkToggleAnyEdge(CH4_PIN_B, lastMP3_CH4B, BANK_DANCE_START, BANK_DANCE_END, "Dance");
-  checkToggleAnyEdge(CH5_PIN_B, lastMP3_CH5B, BANK_SINGING_START, BANK_SINGING_END, "Singing");
-  checkMomentary(CH6_PIN_B, hasTriggeredMP3_CH6B, BANK_LINES_START, BANK_LINES_END, "Lines");
-
-  delay(DEBOUNCE_DELAY);
+  checkToggleAnyEdge(PWM_CH3B, lastMP3_CH3B, BANK_CLASSIC_START, BANK_CLASSIC_END, F("Classic"));
+  checkToggleAnyEdge(PWM_CH4B, lastMP3_CH4B, BANK_DANCE_START, BANK_DANCE_END, F("Dance"));
+  checkToggleAnyEdge(PWM_CH5B, lastMP3_CH5B, BANK_SINGING_START, BANK_SINGING_END, F("Singing"));
+  checkMomentary(PWM_CH6B, hasTriggeredMP3_CH6B, BANK_LINES_START, BANK_LINES_END, F("Lines"));
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // TOGGLE BUTTON HANDLER (CH3–CH5)
 // ─────────────────────────────────────────────────────────────────────────────
-void checkToggleAnyEdge(int pin, int &lastState, int startFile, int endFile, const char* label) {
-  int pwm = pulseIn(pin, HIGH, 30000);
+void checkToggleAnyEdge(PWMChannel channel, int &lastState, int startFile, int endFile, const __FlashStringHelper* label) {
+  int pwm = getFramePulse(channel);
   if (pwm == 0 || pwm < VALID_PWM_MIN || pwm > VALID_PWM_MAX) return;
 
   int newState = (pwm > HIGH_THRESHOLD) ? HIGH : (pwm < LOW_THRESHOLD) ? LOW : lastState;
@@ -246,12 +326,14 @@ void checkToggleAnyEdge(int pin, int &lastState, int startFile, int endFile, con
     int randomTrack = random(startFile, endFile + 1);
     currentMP3 = randomTrack;
 
-    Serial.print(">> MP3 Trigger [");
-    Serial.print(label);
-    Serial.print("]: Track ");
-    Serial.println(currentMP3);
+    if (LOG_ENABLED(MP3, LOG_INFO)) {
+      usbLog.print(F(">> MP3 Trigger ["));
+      usbLog.print(label);
+      usbLog.print(F("]: Track "));
+      usbLog.println(currentMP3);
+    }
 
-    playMP3Track(currentMP3); 
+    if (playMP3(currentMP3, MP3_PRIORITY_USER)) traceOutputLatency(LATENCY_BUTTON_TO_MP3, channel);
     lastState = newState;
   }
 }
@@ -259,20 +341,22 @@ void checkToggleAnyEdge(int pin, int &lastState, int startFile, int endFile, con
 // ─────────────────────────────────────────────────────────────────────────────
 // MOMENTARY BUTTON HANDLER (CH6)
 // ─────────────────────────────────────────────────────────────────────────────
-void checkMomentary(int pin, bool &hasTriggered, int startFile, int endFile, const char* label) {
+void checkMomentary(PWMChannel channel, bool &hasTriggered, int startFile, int endFile, const __FlashStringHelper* label) {
   static unsigned long lastTriggerTime = 0;
-  int pwm = pulseIn(pin, HIGH, 30000);
+  int pwm = getFramePulse(channel);
 
   if (pwm > HIGH_THRESHOLD && !hasTriggered) {
     int randomTrack = random(startFile, endFile + 1);
     currentMP3 = randomTrack;
 
-    Serial.print(">> MP3 Momentary Trigger [");
-    Serial.print(label);
-    Serial.print("]: Track ");
-    Serial.println(currentMP3);
+    if (LOG_ENABLED(MP3, LOG_INFO)) {
+      usbLog.print(F(">> MP3 Momentary Trigger ["));
+      usbLog.print(label);
+      usbLog.print(F("]: Track "));
+      usbLog.println(currentMP3);
+    }
 
-    playMP3Track(currentMP3); 
+    if (playMP3(currentMP3, MP3_PRIORITY_USER)) traceOutputLatency(LATENCY_BUTTON_TO_MP3, channel);
     hasTriggered = true;
     lastTriggerTime = millis();
   }
@@ -287,22 +371,102 @@ void checkMomentary(int pin, bool &hasTriggered, int startFile, int endFile, con
 // ─────────────────────────────────────────────────────────────────────────────
 void disableMP3Triggers() {
   mp3TriggersEnabled = false;
-  Serial.println(">> MP3Handler: Triggers DISABLED by MarcDuino mode.");
+  LOG_LINE(MP3, LOG_INFO, ">> MP3Handler: Triggers DISABLED by MarcDuino mode.");
 }
 
 void enableMP3Triggers() {
   mp3TriggersEnabled = true;
-  Serial.println(">> MP3Handler: Triggers RE-ENABLED by Quiet Mode.");
+  LOG_LINE(MP3, LOG_INFO, ">> MP3Handler: Triggers RE-ENABLED by Quiet Mode.");
+}
+
+bool isMP3Blocked() {
+  return mp3Blocked;
 }
 
 bool isMP3Suppressed() {
   return !mp3TriggersEnabled;
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// PLAYBACK QUEUE
+// ─────────────────────────────────────────────────────────────────────────────
+static bool isLongTrack(int track) {
+  return track >= MP3_LONG_FIRST && track <= MP3_LONG_LAST;
+}
+
+bool isMP3Playing() {
+  if (playingPriority < 0) return false;
+#if MP3_STATUS_FEEDBACK && ACTIVE_MP3_BOARD == 1
+  mp3.update();
+  if (!mp3.isPlaying()) playingPriority = -1;   // 'X' / 'E' from the board
+#endif
+  unsigned long lengthMs = isLongTrack(playingTrack) ? MP3_LONG_TRACK_MS : MP3_TRACK_MS;
+  if (playingPriority >= 0 && millis() - playingSinceMs >= lengthMs) playingPriority = -1;
+  return playingPriority >= 0;
+}
+
+static bool canStart(uint8_t priority) {
+  if (!mp3Ready) return false;
+  if (txRoom(TX_PORT_SERIAL1) < MP3_COMMAND_BYTES) return false;   // Never block, never pass a queued MarcDuino command
+  if (!isMP3Playing()) return true;
+
+  if (priority == MP3_PRIORITY_AMBIENT) return false;   // Only into silence
+  if (priority < playingPriority) return false;         // Let the confirmation finish
+  if (priority == MP3_PRIORITY_USER && isLongTrack(playingTrack) && !MP3_PREEMPT_LONG_TRACKS) return false;
+  return true;
+}
+
+static void startTrack(int track, uint8_t priority) {
+  if (isMP3Playing()) mp3Stats.preempted++;
+  playMP3Track(track);
+  playingPriority = priority;
+  playingTrack    = track;
+  playingSinceMs  = millis();
+  mp3Stats.played++;
+}
+
+bool playMP3(int track, uint8_t priority) {
+  if (priority >= MP3_PRIORITY_COUNT) return false;
+  if (canStart(priority)) {
+    startTrack(track, priority);
+    return true;
+  }
+  if (priority == MP3_PRIORITY_AMBIENT) {
+    mp3Stats.dropped++;
+    return false;
+  }
+
+  MP3Request &r = waitingTracks[priority];
+  if (r.waiting) mp3Stats.dropped++;     // Replaced by the newer request
+  r.track   = track;
+  r.waiting = true;
+  mp3Stats.waited++;
+  return false;
+}
+
+bool playMP3Bank(uint8_t bank, uint8_t priority) {
+  if (bank >= MP3_BANK_COUNT) return false;
+  currentMP3 = random(bankRanges[bank][0], bankRanges[bank][1] + 1);
+  return playMP3(currentMP3, priority);
+}
+
+void updateMP3Queue() {
+  for (int8_t p = MP3_PRIORITY_COUNT - 1; p > MP3_PRIORITY_AMBIENT; p--) {
+    MP3Request &r = waitingTracks[p];
+    if (!r.waiting) continue;
+    if (canStart(p)) {
+      r.waiting = false;
+      startTrack(r.track, p);
+    }
+    return;                              // Highest waiting request first, one per pass
+  }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // UNIVERSAL TRACK PLAYER — Supports SparkFun, YX5300, DFPlayer
 // ─────────────────────────────────────────────────────────────────────────────
-void playMP3Track(int track) {
+// Only the queue calls this
+static void playMP3Track(int track) {
 #if ACTIVE_MP3_BOARD == 1
   // SparkFun MP3 Trigger
   mp3.trigger(track);
@@ -312,6 +476,6 @@ void playMP3Track(int track) {
   byte command[] = {
     0x7E, 0xFF, 0x06, 0x03, 0x00, 0x00, (byte)track, 0xEF
   };
-  Serial1.write(command, sizeof(command));
+  txSend(TX_PORT_SERIAL1, command, sizeof(command), TX_CLASS_SHOW);   // Fits: canStart() checked
 #endif
 }
@@ -19,7 +19,56 @@
 
 // === Setup and Main Loop ===
 void setupMP3Handler();
-void updateMP3Handler();
+void updateMP3Handler();              // Scheduled every DEBOUNCE_DELAY ms
+bool isMP3Ready();                    // Board booted; buttons are ignored until then
+
+// === Trigger Debounce ===
+const int DEBOUNCE_DELAY = 50;        // ms between updateMP3Handler() passes
+
+// === Playback Queue ===
+// One waiting request per priority; a newer one replaces it. A request
+// plays at once unless the rules in MP3Handler.cpp make it wait.
+enum MP3Priority {
+  MP3_PRIORITY_AMBIENT = 0,   // Random chatter: only into silence, never waits
+  MP3_PRIORITY_USER,          // CH3–CH6 buttons
+  MP3_PRIORITY_MODE,          // Mode-change confirmation, startup sound
+  MP3_PRIORITY_COUNT
+};
+
+#define MP3_TRACK_MS            6000    // Assumed length of a sound effect
+#define MP3_LONG_TRACK_MS       90000   // ...of a Dance / Singing track (MP3_LONG_FIRST–LAST)
+#define MP3_LONG_FIRST          151
+#define MP3_LONG_LAST           186
+#define MP3_PREEMPT_LONG_TRACKS 1       // 0 = a button waits for a long track to end
+#define MP3_STATUS_FEEDBACK     0       // 1 = board TX on RX1: end tracks on its 'X' / 'E'
+
+struct MP3Stats {
+  unsigned long played;       // Tracks sent to the board
+  unsigned long preempted;    // ...of which cut a playing track short
+  unsigned long waited;       // Requests that had to wait in the queue
+  unsigned long dropped;      // Ambient into a playing track, or replaced while waiting
+};
+
+extern MP3Stats mp3Stats;
+
+bool playMP3(int track, uint8_t priority);  // true = sent now; false = waiting or dropped
+void updateMP3Queue();                // Starts a waiting request when the rules allow
+bool isMP3Playing();                  // Status feedback if wired, else the assumed length
+
+// === Sound Banks (track ranges in MP3Handler.cpp) ===
+enum MP3Bank {
+  MP3_BANK_HAPPY = 0,         // CH3A
+  MP3_BANK_SAD,               // CH4A
+  MP3_BANK_TALKING,           // CH5A
+  MP3_BANK_YELLING,           // CH6A
+  MP3_BANK_CLASSIC,           // CH3B
+  MP3_BANK_DANCE,             // CH4B
+  MP3_BANK_SINGING,           // CH5B
+  MP3_BANK_LINES,             // CH6B
+  MP3_BANK_COUNT
+};
+
+bool playMP3Bank(uint8_t bank, uint8_t priority);  // Random track → currentMP3, then playMP3()
 
 // === MP3 File Tracker ===
 extern int currentMP3;
@@ -29,5 +78,6 @@ extern MP3Trigger mp3;  // ✅ Declare the mp3 object used in .cpp
 void suppressMP3Handler(unsigned long duration = 30000, int combo = -1, const char* label = nullptr);
 void clearMP3Suppression();
 bool isMP3Suppressed();
+bool isMP3Blocked();                  // Triggers held by a combo or MarcDuino mode
 
 #endif
\ No newline at end of file
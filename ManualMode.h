@@ -16,16 +16,19 @@
 #ifndef MANUALMODE_H
 #define MANUALMODE_H
 
+#include "DriveController.h"
+
 void setupManualMode();
 void loopManualMode();
 
+extern DriveProfile manualProfile;   // Live-tuned by `tune` (TuningStore.cpp)
+
 // Required for Sabertooth + SyRen serial motor control
 #include <Sabertooth.h>
 #include <SyRenSimplified.h>
 
-// External motor controller objects (defined in ManualMode.cpp)
-extern Sabertooth ST;            // For drive motors (motor 1 and 2)
-extern Sabertooth domeMotor;    // For dome motor control
+// Shared motor controller objects + bus scheduler (ST, domeMotor)
+#include "MotorBus.h"
 
 #endif
 
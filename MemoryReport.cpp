@@ -0,0 +1,73 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                  MemoryReport.cpp - Shadow-RC System               ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ How much of the Mega's 8 KB of SRAM is left, and how close the    ║
+  ║ stack has come to the statics. Growing a TX queue or the          ║
+  ║ telemetry ring used to be a guess until the droid reset itself.   ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - `paintFreeSram()` runs in `.init3`, before `main()` and before
+    anything is pushed: every byte between the end of the statics
+    (`__heap_start`) and the top of SRAM gets `MEMORY_PAINT_BYTE`.
+  - The stack grows down from RAMEND and overwrites the paint. The
+    bytes still painted above the statics / heap are SRAM nothing has
+    used since boot: the low-water mark. The stack peak is the rest.
+  - Free now is the stack pointer minus the end of the heap (the
+    firmware does not allocate, so that is the end of the statics).
+  - The host build has no AVR memory map: everything reads 0.
+
+  READ BACK:
+  ─────────────────────────────────────────────────────────────────────
+  `stats` shows the statics, free now, never used and the stack now /
+  peak, then the biggest buffers (TX queues, telemetry ring, UART
+  rings, latency samples) so you can see what a change would cost.
+  Keep a few hundred bytes never used: ISRs push onto the same stack.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `MemoryReport.cpp`
+  Header:    `MemoryReport.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "MemoryReport.h"
+#include <Arduino.h>
+
+#if defined(__AVR__)
+extern uint8_t  __heap_start;            // Linker: end of .data + .bss + .noinit
+extern uint8_t* __brkval;                // malloc(): end of the heap, NULL = never used
+
+// ==========================
+//        EARLY BOOT
+// ==========================
+// Before .data / .bss are set up; nothing is on the stack yet
+void paintFreeSram() __attribute__((naked, used, section(".init3")));
+void paintFreeSram() {
+  for (uint8_t* p = &__heap_start; p <= (uint8_t*)RAMEND; p++) *p = MEMORY_PAINT_BYTE;
+}
+#endif
+
+// ==========================
+//          READ
+// ==========================
+void readMemoryUsage(MemoryUsage &usage) {
+  memset(&usage, 0, sizeof(usage));
+#if defined(__AVR__)
+  uint8_t* heapEnd = __brkval ? __brkval : &__heap_start;
+  uint8_t* sp = (uint8_t*)SP;
+
+  const uint8_t* p = heapEnd;
+  while (p < sp && *p == MEMORY_PAINT_BYTE) p++;
+
+  usage.staticBytes    = &__heap_start - (uint8_t*)RAMSTART;
+  usage.freeBytes      = sp - heapEnd;
+  usage.neverUsedBytes = p - heapEnd;
+  usage.stackBytes     = (uint8_t*)RAMEND - sp;
+  usage.stackPeakBytes = (uint8_t*)RAMEND + 1 - p;
+#endif
+}
@@ -0,0 +1,32 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                 MemoryReport.h - Shadow-RC                 ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the SRAM report: statics, free memory now and   ║
+  ║ the deepest the stack has reached since boot, so a buffer  ║
+  ║ can be grown knowing what is left of the Mega's 8 KB.      ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing the stack paint.       ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include <Arduino.h>
+
+#define MEMORY_PAINT_BYTE       0xC5   // Fills free SRAM at boot; the stack overwrites it
+
+// Bytes. All 0 on the host build (no AVR memory map).
+struct MemoryUsage {
+  uint16_t staticBytes;    // .data + .bss + .noinit
+  uint16_t freeBytes;      // Stack pointer → end of statics / heap, now
+  uint16_t neverUsedBytes; // ...still painted: the free SRAM low-water mark
+  uint16_t stackBytes;     // Stack depth now
+  uint16_t stackPeakBytes; // Deepest since boot
+};
+
+// Walks the painted bytes (~1 ms with 2 KB free): `stats` only, not the tick
+void readMemoryUsage(MemoryUsage &usage);
+
+#endif
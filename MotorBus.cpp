@@ -0,0 +1,456 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                    MotorBus.cpp - Shadow-RC System                 ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Schedules every packet on the shared Serial2 line between the     ║
+  ║ Sabertooth 2x32 (drive, address 128) and the SyRen 10 (dome,      ║
+  ║ address 129). Modes only set the power they want; this file       ║
+  ║ decides what actually goes on the wire and when.                   ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  WHY:
+  ─────────────────────────────────────────────────────────────────────
+  At 9600 baud one 4-byte packet takes ~4.2 ms. Sending drive + turn
+  every 5 ms frame is ~8.3 ms of wire time per frame, so the TX buffer
+  fills, `write()` starts blocking, and dome packets wait behind stale
+  drive packets.
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - Three slots: DRIVE, TURN (both to 128) and DOME (to 129).
+    Each slot keeps only its newest value; an unsent value that gets
+    replaced is simply dropped ("coalesced").
+  - A slot is sent when its value changed, or as a keepalive
+    every `MOTOR_BUS_KEEPALIVE_MS` when it did not.
+  - Idle (`setMotorBusIdle()`, IdleGovernor.cpp): every slot sits at
+    0, so the 2x32 only needs one packet per keepalive period to keep
+    its timeout from firing. The DRIVE keepalive does that; the TURN
+    one is skipped while TURN holds 0. The SyRen keeps its own.
+  - Both drivers get `setTimeout(MOTOR_BUS_TIMEOUT_MS)` at setup, so if
+    the keepalives stop (firmware stall, cable off) they stop the
+    motors on their own. The watchdog (Failsafe.cpp) usually gets
+    there first and `sendBootStop()` stops them after the reset.
+  - Send order: stop packets (a slot going to 0, or `stopAllMotors()`)
+    → changed values → keepalives, oldest first within each group.
+  - A packet is only written when it fits in the TX buffer, and normal
+    packets wait until at most `MOTOR_BUS_MAX_QUEUED` bytes are still
+    queued. Nothing here ever blocks, and a new value never sits
+    behind more than one old packet. Stop packets skip the queue limit.
+
+  STARTUP + BAUD UPGRADE:
+  ─────────────────────────────────────────────────────────────────────
+  `setupMotorBus()` only arms the startup: the drivers boot with the
+  Mega, so nothing is sent before `MOTOR_BUS_DRIVER_BOOT_MS` (0 after a
+  watchdog reset, when they kept power). It then opens the port at
+  `MOTOR_BUS_START_BAUD`. If `MOTOR_BUS_BAUD` is higher, a
+  `SabertoothBaudChange` sends the set baud rate command to both
+  addresses, waits for it to leave the UART, switches the port,
+  waits out the drivers' restart, sends the sync byte (0xAA) and, if
+  `MOTOR_BUS_VERIFY_ADDRESS` is set, asks the 2x32 for its battery
+  voltage to confirm it followed. If it does not answer, the line
+  drops back to the start baud. Motor packets are held until this
+  finishes; it never blocks the loop.
+
+  STATISTICS:
+  ─────────────────────────────────────────────────────────────────────
+  `printMotorBusStats()` shows packets per slot, keepalives, stops,
+  coalesced values, TX-full holds and bus usage per address as a
+  percentage of the line's capacity since the last reset.
+
+  DRIVER FEEDBACK:
+  ─────────────────────────────────────────────────────────────────────
+  With `MOTOR_FEEDBACK_POLL_MS` set, the 2x32 is asked for one value
+  per poll, in a fixed rotation that reads the two motor currents
+  three times as often as battery voltage and temperature.
+  - A request only goes out when the TX buffer is empty, and only
+    when no motor packet is waiting unless the last request is
+    `FEEDBACK_OVERDUE_POLLS` polls old (a stick that keeps moving would
+    starve it). It delays a new motor value by at most one 7-byte
+    request, and never a stop packet. One request is outstanding at a
+    time.
+  - Replies are read a byte at a time from RX2 by a
+    `SabertoothReplyParser` at the top of every `updateMotorBus()`;
+    nothing waits for them. No reply in `MOTOR_FEEDBACK_TIMEOUT_MS`
+    counts as missed and frees the line for the next request.
+  - `driveFeedback` holds the newest readings (Carpet Mode's traction
+    control, telemetry and `stats` read them).
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `MotorBus.cpp`
+  Header:    `MotorBus.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "MotorBus.h"
+#include "LatencyTrace.h"
+#include "Startup.h"
+#include "DebugLog.h"
+#include <Arduino.h>
+
+// ==========================
+//   Sabertooth / SyRen Setup
+// ==========================
+Sabertooth ST(DRIVE_ADDRESS, MOTOR_BUS_PORT);
+Sabertooth domeMotor(DOME_ADDRESS, MOTOR_BUS_PORT);
+
+// ==========================
+//       INTERNAL STATE
+// ==========================
+struct MotorSlotState {
+  int           target;       // Newest requested power
+  int           sent;         // Power last put on the wire
+  bool          everSent;
+  bool          urgent;       // Forced stop from stopAllMotors()
+  unsigned long lastSentMs;
+};
+
+enum SendRank { RANK_NONE = 0, RANK_KEEPALIVE, RANK_CHANGED, RANK_STOP };
+
+static MotorSlotState slots[MOTOR_SLOT_COUNT];
+MotorBusStats motorBusStats;
+
+static const byte busAddresses[] = { DRIVE_ADDRESS, DOME_ADDRESS };
+static SabertoothBaudChange baudChange(MOTOR_BUS_PORT);
+
+DriveFeedback driveFeedback;
+
+struct FeedbackRequest {
+  byte type;                            // SABERTOOTH_GET_*
+  byte motor;                           // 1 or 2
+};
+
+// Currents every other request, the rest in between
+static const FeedbackRequest feedbackRequests[] = {
+  { SABERTOOTH_GET_CURRENT, 1 }, { SABERTOOTH_GET_CURRENT, 2 }, { SABERTOOTH_GET_BATTERY, 1 },
+  { SABERTOOTH_GET_CURRENT, 1 }, { SABERTOOTH_GET_CURRENT, 2 }, { SABERTOOTH_GET_TEMPERATURE, 1 },
+  { SABERTOOTH_GET_CURRENT, 1 }, { SABERTOOTH_GET_CURRENT, 2 }, { SABERTOOTH_GET_TEMPERATURE, 2 },
+};
+#define FEEDBACK_REQUEST_COUNT  (sizeof(feedbackRequests) / sizeof(feedbackRequests[0]))
+
+#define FEEDBACK_OVERDUE_POLLS  3      // Ahead of changed values / keepalives after this many polls
+
+static SabertoothReplyParser replyParser;
+static uint8_t       nextRequest = 0;
+static bool          awaitingReply = false;
+static bool          haveCurrent = false;
+static unsigned long lastRequestMs = 0;
+static bool busReady = false;
+static bool busIdle  = false;         // Idle governor: one keepalive per driver
+static bool busStarted = false;       // baudChange.start() called
+static unsigned long busStartMs = 0;  // ...not before this millis()
+
+// ==========================
+//        SETUP
+// ==========================
+void setupMotorBus(unsigned long driverBootMs) {
+  busReady   = false;
+  busStarted = false;
+  busStartMs = driverBootMs;
+
+  for (uint8_t i = 0; i < MOTOR_SLOT_COUNT; i++) {
+    slots[i].target   = 0;
+    slots[i].sent     = 0;
+    slots[i].everSent = false;
+    slots[i].urgent   = false;
+    slots[i].lastSentMs = 0;
+  }
+  resetMotorBusStats();
+  memset(&driveFeedback, 0, sizeof(driveFeedback));
+  awaitingReply = false;
+  haveCurrent = false;
+}
+
+// Finishes the baud upgrade, then programs the driver timeouts once
+static bool finishBusStartup() {
+  if (!busStarted) {
+    if ((long)(millis() - busStartMs) < 0) return false;   // Drivers still booting
+    baudChange.start(MOTOR_BUS_START_BAUD, MOTOR_BUS_BAUD,
+                     busAddresses, sizeof(busAddresses), MOTOR_BUS_VERIFY_ADDRESS);
+    busStarted = true;
+  }
+
+  SabertoothBaudState state = baudChange.update();
+  motorBusStats.baudState = state;
+  motorBusStats.baudRate  = baudChange.baudRate();
+
+  if (state != SABERTOOTH_BAUD_DONE &&
+      state != SABERTOOTH_BAUD_UNVERIFIED &&
+      state != SABERTOOTH_BAUD_FAILED) return false;
+
+  if (!ST.tryCommand(14, (MOTOR_BUS_TIMEOUT_MS + 99) / 100)) return false;
+  if (!domeMotor.tryCommand(14, (MOTOR_BUS_TIMEOUT_MS + 99) / 100)) return false;
+
+  if (LOG_ENABLED(BUS, state == SABERTOOTH_BAUD_FAILED ? LOG_WARN : LOG_INFO)) {
+    usbLog.print(F("[BUS] Motor bus at "));
+    usbLog.print(baudChange.baudRate());
+    usbLog.println(state == SABERTOOTH_BAUD_DONE       ? F(" baud (verified).") :
+                   state == SABERTOOTH_BAUD_UNVERIFIED ? F(" baud.") :
+                                                         F(" baud (upgrade FAILED, no reply)."));
+  }
+  busReady = true;
+  markStartupStep(STARTUP_MOTOR_BUS);
+  return true;
+}
+
+bool isMotorBusReady() {
+  return busReady;
+}
+
+void setMotorBusIdle(bool idle) {
+  busIdle = idle;
+}
+
+// After a reset the drivers never saw (watchdog, button): they are still
+// on the bus rate and may still hold the last command. Runs before the
+// watchdog is armed, so the ~13 ms flush is fine here.
+void sendBootStop() {
+  MOTOR_BUS_PORT.begin(MOTOR_BUS_BAUD);
+  ST.drive(0);
+  ST.turn(0);
+  domeMotor.motor(0);
+  MOTOR_BUS_PORT.flush();
+}
+
+// ==========================
+//      MOTOR COMMANDS
+// ==========================
+static void setSlot(MotorSlot slot, int power) {
+  MotorSlotState &s = slots[slot];
+  power = constrain(power, -127, 127);
+  if (s.target != s.sent && power != s.target) motorBusStats.coalesced++;
+  s.target = power;
+}
+
+void setDrivePower(int power) { setSlot(MOTOR_SLOT_DRIVE, power); }
+void setTurnPower(int power)  { setSlot(MOTOR_SLOT_TURN,  power); }
+void setDomePower(int power)  { setSlot(MOTOR_SLOT_DOME,  power); }
+
+int getMotorPower(MotorSlot slot) {
+  return slots[slot].target;
+}
+
+void stopAllMotors() {
+  for (uint8_t i = 0; i < MOTOR_SLOT_COUNT; i++) {
+    slots[i].target = 0;
+    slots[i].urgent = true;
+  }
+  updateMotorBus();
+}
+
+// ==========================
+//      DRIVER FEEDBACK
+// ==========================
+static void storeReply(const SabertoothReply &r) {
+  uint8_t motor = (r.targetNumber == '2') ? 1 : 0;
+  switch (r.type) {
+    case SABERTOOTH_GET_BATTERY:
+      driveFeedback.batteryDv = r.value;
+      break;
+    case SABERTOOTH_GET_CURRENT:
+      driveFeedback.currentDa[motor] = r.value;
+      driveFeedback.currentMs = millis();
+      driveFeedback.currentSamples++;
+      haveCurrent = true;
+      break;
+    case SABERTOOTH_GET_TEMPERATURE:
+      driveFeedback.temperatureC[motor] = constrain(r.value, -128, 127);
+      break;
+    default:
+      return;
+  }
+  driveFeedback.replies++;
+  awaitingReply = false;
+}
+
+static void readFeedbackReplies() {
+  while (MOTOR_BUS_PORT.available() > 0) {
+    if (replyParser.feed(MOTOR_BUS_PORT.read()) && replyParser.reply().address == DRIVE_ADDRESS) {
+      storeReply(replyParser.reply());
+    }
+  }
+}
+
+// Only into an empty TX buffer; `waitMs` = time since the last request it needs
+static bool requestFeedback(unsigned long now, unsigned long waitMs) {
+  if (awaitingReply) {
+    if (now - lastRequestMs < MOTOR_FEEDBACK_TIMEOUT_MS) return false;
+    awaitingReply = false;
+    driveFeedback.missed++;
+  }
+  if (now - lastRequestMs < waitMs) return false;
+  if (MOTOR_BUS_PORT.availableForWrite() < SERIAL_TX_BUFFER_SIZE - 1) return false;
+
+  const FeedbackRequest &q = feedbackRequests[nextRequest];
+  if (!ST.tryGet(q.type, q.motor)) return false;
+  nextRequest = (nextRequest + 1) % FEEDBACK_REQUEST_COUNT;
+  awaitingReply = true;
+  lastRequestMs = now;
+  driveFeedback.requests++;
+  motorBusStats.bytesDrive += SABERTOOTH_GET_PACKET_SIZE;
+  return true;
+}
+
+bool isDriveCurrentFresh() {
+  return haveCurrent && millis() - driveFeedback.currentMs < MOTOR_FEEDBACK_STALE_MS;
+}
+
+int driveCurrentPeak() {
+  return max(abs(driveFeedback.currentDa[0]), abs(driveFeedback.currentDa[1]));
+}
+
+// ==========================
+//       BUS SCHEDULER
+// ==========================
+// Idle: address 128 already hears the DRIVE keepalive, and 0 is latched
+static bool isKeepaliveCovered(uint8_t slot) {
+  return busIdle && slot == MOTOR_SLOT_TURN && slots[MOTOR_SLOT_TURN].sent == 0 &&
+         slots[MOTOR_SLOT_DRIVE].target == slots[MOTOR_SLOT_DRIVE].sent;
+}
+
+static uint8_t rankSlot(uint8_t slot, unsigned long now) {
+  const MotorSlotState &s = slots[slot];
+  if (s.urgent) return RANK_STOP;
+  if (s.target == 0 && (s.sent != 0 || !s.everSent)) return RANK_STOP;
+  if (s.target != s.sent) return RANK_CHANGED;
+  if (now - s.lastSentMs >= MOTOR_BUS_KEEPALIVE_MS) {
+    if (!isKeepaliveCovered(slot)) return RANK_KEEPALIVE;
+    slots[slot].lastSentMs = now;             // Counted as sent with the DRIVE one
+    motorBusStats.keepalivesSkipped++;
+  }
+  return RANK_NONE;
+}
+
+static bool sendSlot(uint8_t slot, uint8_t rank, unsigned long now) {
+  MotorSlotState &s = slots[slot];
+  int power = s.target;
+
+  bool queued = false;
+  switch (slot) {
+    case MOTOR_SLOT_DRIVE: queued = ST.tryDrive(power);        break;
+    case MOTOR_SLOT_TURN:  queued = ST.tryTurn(power);         break;
+    case MOTOR_SLOT_DOME:  queued = domeMotor.tryMotor(power); break;
+  }
+  if (!queued) return false;
+  traceMotorPacket(slot, rank != RANK_KEEPALIVE);
+  markStartupStep(STARTUP_FIRST_COMMAND);   // Only the first one counts
+
+  s.sent       = power;
+  s.everSent   = true;
+  s.urgent     = false;
+  s.lastSentMs = now;
+
+  motorBusStats.packets[slot]++;
+  if (slot == MOTOR_SLOT_DOME) motorBusStats.bytesDome  += MOTOR_PACKET_BYTES;
+  else                         motorBusStats.bytesDrive += MOTOR_PACKET_BYTES;
+  if (rank == RANK_KEEPALIVE)  motorBusStats.keepalives++;
+  if (rank == RANK_STOP)       motorBusStats.stops++;
+  return true;
+}
+
+void updateMotorBus() {
+  if (!busReady && !finishBusStartup()) return;
+
+  unsigned long now = millis();
+  if (MOTOR_FEEDBACK_POLL_MS > 0) readFeedbackReplies();
+
+  while (true) {
+    int8_t  pick = -1;
+    uint8_t best = RANK_NONE;
+    for (uint8_t i = 0; i < MOTOR_SLOT_COUNT; i++) {
+      uint8_t rank = rankSlot(i, now);
+      if (rank == RANK_NONE) continue;
+      if (rank > best ||
+          (rank == best && now - slots[i].lastSentMs > now - slots[pick].lastSentMs)) {
+        pick = i;
+        best = rank;
+      }
+    }
+    if (pick < 0) {
+      if (MOTOR_FEEDBACK_POLL_MS > 0) requestFeedback(now, MOTOR_FEEDBACK_POLL_MS);
+      return;
+    }
+    if (MOTOR_FEEDBACK_POLL_MS > 0 && best != RANK_STOP &&
+        requestFeedback(now, MOTOR_FEEDBACK_POLL_MS * FEEDBACK_OVERDUE_POLLS)) return;
+
+    int room   = MOTOR_BUS_PORT.availableForWrite();
+    int queued = (SERIAL_TX_BUFFER_SIZE - 1) - room;
+    if (room < MOTOR_PACKET_BYTES ||
+        (best != RANK_STOP && queued > MOTOR_BUS_MAX_QUEUED)) {
+      motorBusStats.txHeld++;
+      if (room < MOTOR_PACKET_BYTES) motorBusStats.txFull++;
+      return;
+    }
+
+    if (!sendSlot(pick, best, now)) {
+      motorBusStats.txHeld++;
+      motorBusStats.txFull++;
+      return;
+    }
+  }
+}
+
+// ==========================
+//        STATISTICS
+// ==========================
+static void printBusUsage(const __FlashStringHelper* label, unsigned long bytes, unsigned long elapsedMs) {
+  // 10 bits per byte on the wire (8N1)
+  float percent = elapsedMs ? bytes * 1000000.0 / ((float)motorBusStats.baudRate * elapsedMs) : 0;
+  Serial.print(label);
+  Serial.print(bytes);
+  Serial.print(F(" bytes ("));
+  Serial.print(percent, 1);
+  Serial.println(F("% of bus)"));
+}
+
+void printMotorBusStats() {
+  unsigned long elapsed = millis() - motorBusStats.windowStartMs;
+
+  Serial.print(F("=== Motor Bus @ "));
+  Serial.print(motorBusStats.baudRate);
+  Serial.println(F(" baud ==="));
+  Serial.print(F("Packets  drive: "));
+  Serial.print(motorBusStats.packets[MOTOR_SLOT_DRIVE]);
+  Serial.print(F(" | turn: "));
+  Serial.print(motorBusStats.packets[MOTOR_SLOT_TURN]);
+  Serial.print(F(" | dome: "));
+  Serial.println(motorBusStats.packets[MOTOR_SLOT_DOME]);
+
+  Serial.print(F("Keepalives: "));
+  Serial.print(motorBusStats.keepalives);
+  Serial.print(F(" (skipped idle: "));
+  Serial.print(motorBusStats.keepalivesSkipped);
+  Serial.print(F(") | Stops: "));
+  Serial.print(motorBusStats.stops);
+  Serial.print(F(" | Coalesced: "));
+  Serial.print(motorBusStats.coalesced);
+  Serial.print(F(" | TX held: "));
+  Serial.print(motorBusStats.txHeld);
+  Serial.print(F(" (full: "));
+  Serial.print(motorBusStats.txFull);
+  Serial.println(F(")"));
+
+  printBusUsage(F("Address 128: "), motorBusStats.bytesDrive, elapsed);
+  printBusUsage(F("Address 129: "), motorBusStats.bytesDome,  elapsed);
+
+  if (MOTOR_FEEDBACK_POLL_MS > 0) {
+    Serial.print(F("2x32 gets: "));
+    Serial.print(driveFeedback.requests);
+    Serial.print(F(" | replies: "));
+    Serial.print(driveFeedback.replies);
+    Serial.print(F(" | missed: "));
+    Serial.println(driveFeedback.missed);
+  }
+}
+
+void resetMotorBusStats() {
+  long    baudRate  = baudChange.baudRate();
+  uint8_t baudState = baudChange.state();
+  memset(&motorBusStats, 0, sizeof(motorBusStats));
+  motorBusStats.windowStartMs = millis();
+  motorBusStats.baudRate  = baudRate;
+  motorBusStats.baudState = baudState;
+  driveFeedback.requests = driveFeedback.replies = driveFeedback.missed = 0;
+}
@@ -0,0 +1,123 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                  MotorBus.h - Shadow-RC                    ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the shared Serial2 motor bus scheduler.         ║
+  ║ Modes set drive / turn / dome power here; the bus decides  ║
+  ║ which Sabertooth / SyRen packet goes on the wire next.     ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing motor bus wiring.      ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef MOTOR_BUS_H
+#define MOTOR_BUS_H
+
+#include <Arduino.h>
+#include <Sabertooth.h>
+
+// ---------- Bus Wiring ----------
+#define MOTOR_BUS_PORT          Serial2
+#define DRIVE_ADDRESS           128    // Sabertooth 2x32 (drive)
+#define DOME_ADDRESS            129    // SyRen 10 (dome)
+
+// ---------- Baud Upgrade ----------
+// The drivers listen at MOTOR_BUS_START_BAUD after power-up. A higher
+// MOTOR_BUS_BAUD moves the line up at boot without blocking:
+// 38400 = 4x, 115200 = 12x less wire time per packet. Every driver on
+// the line must support the new rate (V2 drivers store it, older ones
+// autobaud from the sync byte sent after the switch).
+#define MOTOR_BUS_START_BAUD      9600
+#define MOTOR_BUS_BAUD            9600   // 9600 = no upgrade
+#define MOTOR_BUS_VERIFY_ADDRESS  0      // DRIVE_ADDRESS if the 2x32's S2 is wired to RX2 (pin 17)
+
+// ---------- Driver Boot ----------
+// The drivers power up with the Mega and miss a sync byte sent before
+// they finish booting. On a power-on the bus holds it this long after
+// reset (the old `delay(1500)` in setup(), now in the background).
+#define MOTOR_BUS_DRIVER_BOOT_MS  1500
+
+// ---------- Driver Feedback ----------
+// The 2x32 answers packet-serial get requests (battery, motor current,
+// temperature) on its S2 line. Wire S2 to RX2 (pin 17) and set S2 as a
+// TX line in DEScribe, then set MOTOR_FEEDBACK_POLL_MS. One 7-byte
+// request goes out this often, only into an idle line; at 9600 baud
+// 40 ms is ~18% of the bus, so prefer MOTOR_BUS_BAUD 38400.
+#ifndef MOTOR_FEEDBACK_POLL_MS
+#define MOTOR_FEEDBACK_POLL_MS    0      // 0 = never ask (S2 not wired); -D overrides
+#endif
+#define MOTOR_FEEDBACK_TIMEOUT_MS 40     // No reply by then = missed, next request may go
+#define MOTOR_FEEDBACK_STALE_MS   500    // Older current readings are not trusted
+
+// ---------- Bus Timing ----------
+#define MOTOR_BUS_KEEPALIVE_MS  100    // Re-send an unchanged value this often (idle: one slot per driver)
+#define MOTOR_BUS_TIMEOUT_MS    200    // Drivers stop on their own after this much silence (see Failsafe.cpp)
+#define MOTOR_BUS_MAX_QUEUED    4      // TX bytes allowed ahead of a new packet (one packet)
+#define MOTOR_PACKET_BYTES      4
+
+// One slot per output; only the newest value of each slot is ever queued
+enum MotorSlot {
+  MOTOR_SLOT_DRIVE = 0,  // ST.drive()
+  MOTOR_SLOT_TURN,       // ST.turn()
+  MOTOR_SLOT_DOME,       // domeMotor.motor()
+  MOTOR_SLOT_COUNT
+};
+
+struct MotorBusStats {
+  unsigned long packets[MOTOR_SLOT_COUNT];   // Packets sent per slot
+  unsigned long keepalives;                  // Re-sends of unchanged values
+  unsigned long keepalivesSkipped;           // TURN keepalives the DRIVE one covered (idle)
+  unsigned long stops;                       // Stop packets sent ahead of the queue
+  unsigned long coalesced;                   // Values replaced before they were sent
+  unsigned long txHeld;                      // Passes where the TX buffer held a packet back
+  unsigned long txFull;                      // ...of which the buffer had no room at all
+  unsigned long bytesDrive;                  // Bytes sent to DRIVE_ADDRESS
+  unsigned long bytesDome;                   // Bytes sent to DOME_ADDRESS
+  unsigned long windowStartMs;               // Start of the bandwidth window
+  long          baudRate;                    // Line speed after the startup upgrade
+  uint8_t       baudState;                   // SabertoothBaudState of the upgrade
+};
+
+extern MotorBusStats motorBusStats;
+
+// Newest 2x32 readings (driver units: 0.1 V, 0.1 A, °C)
+struct DriveFeedback {
+  int16_t       batteryDv;                   // Battery voltage (0 = no reply yet)
+  int16_t       currentDa[2];                // Motor 1 / 2 current; negative = regenerating
+  int8_t        temperatureC[2];             // Motor 1 / 2 output stage
+  unsigned long currentMs;                   // millis() of the newest current reply
+  uint16_t      currentSamples;              // +1 per current reply (wraps)
+  unsigned long requests;                    // Get requests sent
+  unsigned long replies;                     // Valid replies from DRIVE_ADDRESS
+  unsigned long missed;                      // Requests with no reply in MOTOR_FEEDBACK_TIMEOUT_MS
+};
+
+extern DriveFeedback driveFeedback;
+
+// Shared motor controller objects (defined in MotorBus.cpp)
+extern Sabertooth ST;            // For drive motors (motor 1 and 2)
+extern Sabertooth domeMotor;     // For dome motor control
+
+// ---------- Setup & Loop ----------
+void setupMotorBus(unsigned long driverBootMs);  // Sync / baud upgrade starts this long after reset
+void updateMotorBus();           // Sends what fits without blocking; call often
+bool isMotorBusReady();          // Baud upgrade finished and driver timeouts programmed
+void setMotorBusIdle(bool idle); // Idle governor: every slot at 0, skip the TURN keepalive
+void sendBootStop();             // Before setupMotorBus(): blocking stop packets at MOTOR_BUS_BAUD
+
+// ---------- Motor Commands ----------
+void setDrivePower(int power);   // -127..127
+void setTurnPower(int power);    // -127..127
+void setDomePower(int power);    // -127..127
+void stopAllMotors();            // Zero every slot and send ahead of everything else
+int  getMotorPower(MotorSlot slot);  // Newest requested power of a slot
+
+// ---------- Driver Feedback ----------
+bool isDriveCurrentFresh();      // A current reply within MOTOR_FEEDBACK_STALE_MS
+int  driveCurrentPeak();         // Larger |motor current| of the two, 0.1 A
+
+// ---------- Statistics ----------
+void printMotorBusStats();
+void resetMotorBusStats();
+
+#endif
@@ -17,20 +17,95 @@
       • CH1A (Turn)  – Controller A joystick left/right
       • CH2A (Drive) – Controller A joystick up/down
       • CH1B (Dome)  – Controller B joystick left/right
-  - Uses `micros()` with pin-change interrupts for precise timing
+  - Captures all button channels in the background:
+      • CH3A–CH6A on pins 22, 24, 26, 28
+      • CH2B–CH6B on pins 23, 25, 27, 29, 31
+  - Uses `micros()` with external / pin-change interrupts for precise timing
+  - CH1B runs on the PCINT2 pin-change bank (pin A8), so it is captured
+    in every mode alongside the dome encoder's external interrupts
   - Live pulse width capture at each loop iteration
   - Configurable input pins for clean physical wiring
 
+  BUTTON CHANNEL SAMPLER:
+  ─────────────────────────────────────────────────────────────────────
+  Pins 22–29 are PORTA and pin 31 is PORTC6. Neither port has pin-change
+  interrupts on the Mega 2560, so instead of blocking `pulseIn()` calls
+  a Timer3 compare interrupt reads PINA + PINC every
+  `BUTTON_SAMPLE_INTERVAL_US` and timestamps any edges it sees.
+  Pulse widths are accurate to one sample interval, which is far finer
+  than the 1300/1700/1900 µs combo and sound thresholds.
+
+  Timer3 runs free at 0.5 µs per tick, so `analogWrite()` on pins 2, 3
+  and 5 is unavailable (2 and 3 are stick inputs anyway).
+
+  TIMER CAPTURE BACKEND:
+  ─────────────────────────────────────────────────────────────────────
+  Set `PWM_CAPTURE_BACKEND` to `PWM_CAPTURE_TIMER` in the header to time
+  the sticks from the same free-running Timer3 instead of `micros()`.
+  Each stick pin gets a single CHANGE interrupt that grabs TCNT3 as its
+  first instruction and reads the pin level straight from the port
+  register, so widths resolve to 0.5 µs with no `attachInterrupt()`
+  swap per edge. Pulse widths stay in µs behind `getPWMValue_*()`.
+
+  That resolution is not the accuracy. TCNT3 is read once the ISR is
+  entered, and entry waits for whatever ISR is already running: the
+  button sampler itself, the UARTs, Timer0, the dome encoder or the
+  other stick. Each edge can land late by up to that worst-case entry
+  latency, so a width is good to ±(worst entry latency), not ±0.5 µs.
+  The button sampler measures it: its compare match time is known, so
+  TCNT3 − OCR3A at entry is exactly how late it ran. The sticks sit on
+  higher-priority vectors, so the worst figure `stats` prints
+  ("ISR entry worst") bounds their lateness too. Only the ICP4 / ICP5
+  input-capture pins (49 / 48, Timer4 / 5) latch the edge in hardware;
+  this board's wiring keeps the sticks on INT4 / INT5 / PCINT16.
+
+  SINGLE-WIRE RECEIVERS:
+  ─────────────────────────────────────────────────────────────────────
+  With `RC_INPUT_BACKEND` set to CPPM, iBUS or SBUS, `ReceiverHandler.cpp`
+  decodes whole receiver frames into this same channel table and none
+  of the per-channel pins above are used.
+
+  INPUT CONDITIONING:
+  ─────────────────────────────────────────────────────────────────────
+  The ISRs store every pulse; `updateInputFrame()` decides which ones
+  the modes get to see:
+  - A width outside `PWM_PULSE_MIN_US`–`PWM_PULSE_MAX_US` (the runt
+    pulses a browning-out receiver sends) is dropped.
+  - A stick jumping more than `PWM_MAX_STEP_US` since its last
+    accepted pulse is held until a second pulse confirms it, so one
+    spike cannot slam a motor. A real slam costs one frame.
+  - A dropped pulse does not refresh the channel's age. After
+    `PWM_LINK_LOSS_FRAMES` frames with nothing accepted the channel is
+    invalid; CH1A or CH2A invalid sets `inputFrame.linkLost`, and
+    DriveController stops the motors in that same control tick. Worst
+    case from the last good pulse to the stop packet on the wire:
+    PWM_SIGNAL_TIMEOUT_US + one control tick + one packet slot.
+  - `inputStats` counts the drops and times each link loss; the
+    `stats` report prints both.
+  - Every ISR that stores a width also hands it to `noteIdleInput()`:
+    while the idle governor has the droid parked, a pulse that moved
+    brings the full control rate back on the next loop() pass.
+
+  TEAR-FREE READS:
+  ─────────────────────────────────────────────────────────────────────
+  A 16/32-bit value read on the 8-bit AVR takes several instructions,
+  so an ISR can land in the middle and hand back half old, half new.
+  Each channel has a sequence counter that its ISR bumps after writing.
+  ISRs never interrupt each other, so a reader that sees the same count
+  before and after copying knows the copy is whole; otherwise it simply
+  re-reads that one channel. Interrupts are never disabled to read.
+
   WIRING GUIDANCE:
   ─────────────────────────────────────────────────────────────────────
   - CH1_PIN  (Controller A CH1):     Pin 2
   - CH2_PIN  (Controller A CH2):     Pin 3
-  - CH1B_PIN (Controller B CH1):     Pin 21
+  - CH1B_PIN (Controller B CH1):     Pin A8
+  (all interrupt-driven pins are assigned in `InputPins.h`)
 
   • All input pins must be connected to PWM-capable outputs on your RC
     receivers.
-  • Pins must support external interrupts — only specific pins on the
-    Arduino Mega are interrupt-capable.
+  • CH1 / CH2 need external interrupts; CH1B needs a port K pin
+    (A8–A15). `checkInputPins()` reports a pin that cannot work.
 
   ⚠️  WARNING: DO NOT MODIFY THIS FILE UNLESS ABSOLUTELY NECESSARY ⚠️
   ─────────────────────────────────────────────────────────────────────
@@ -50,6 +125,10 @@
   - `getPWMValue_CH1A()`   → Returns CH1 (turn) value
   - `getPWMValue_CH2A()`   → Returns CH2 (drive) value
   - `getPWMValue_CH1B()`   → Returns CH1B (dome) value
+  - `getPWMValue(ch)`      → Returns any channel, 0 if no recent pulse
+  - `readPWMSnapshot(s)`   → Tear-free copy of widths + edge timestamps
+  - `updateInputFrame()`   → Captures every channel into `inputFrame`
+  - `getFramePulse(ch)`    → Reads a channel from the current frame
 
   INTERNAL USE ONLY:
   - Do not call interrupt handlers manually. They are automatically
@@ -67,49 +146,257 @@
 
 #include "PWMInputHandler.h"
 #include <Arduino.h>
-#include "ComboHandler.h"  // for access to currentMode
+#include "ReceiverHandler.h"  // CPPM / iBUS / SBUS backends
+#include "LatencyTrace.h"     // Optional scope mark on each captured edge
+#include "IdleGovernor.h"     // A changed pulse wakes a parked droid at once
 
 // ===================================
-// === PIN ASSIGNMENTS (Interrupt) ===
+// === BUTTON SAMPLER (Timer3) =======
 // ===================================
-#define CH1_PIN    2   // Channel 1 (Turn - Controller A)
-#define CH2_PIN    3   // Channel 2 (Drive - Controller A)
-#define CH1B_PIN   21  // Channel 1B (Dome - Controller B)
+// Bit N of the sampled word is PINA bit N (pins 22–29); bit 8 is PINC6 (pin 31)
+static const uint8_t BUTTON_SAMPLE_COUNT = 9;
+static const uint8_t buttonSampleChannel[BUTTON_SAMPLE_COUNT] = {
+  PWM_CH3A,  // 22  PA0
+  PWM_CH2B,  // 23  PA1
+  PWM_CH4A,  // 24  PA2
+  PWM_CH3B,  // 25  PA3
+  PWM_CH5A,  // 26  PA4
+  PWM_CH4B,  // 27  PA5
+  PWM_CH6A,  // 28  PA6
+  PWM_CH5B,  // 29  PA7
+  PWM_CH6B   // 31  PC6
+};
+
+static const uint16_t BUTTON_SAMPLE_TICKS = BUTTON_SAMPLE_INTERVAL_US * 2;  // 0.5 µs per tick
+
+static volatile uint16_t lastButtonLevels = 0;
+static bool captureTimerRunning = false;
+static bool buttonSamplerRunning = false;
 
 // ==================================================
 // === VOLATILE VALUES (Shared with Interrupts) =====
 // ==================================================
-volatile int ch1_value  = 1500;  // Turn input (CH1A)
-volatile int ch2_value  = 1500;  // Drive input (CH2A)
-volatile int ch1b_value = 1500;  // Dome input  (CH1B)
+volatile int pwmWidth[PWM_CHANNEL_COUNT] = {
+  1500, 1500, 0, 0, 0, 0,   // CH1A, CH2A start centered
+  1500, 0, 0, 0, 0, 0       // CH1B starts centered
+};
+volatile unsigned long pwmRiseMicros[PWM_CHANNEL_COUNT];
+volatile unsigned long pwmFallMicros[PWM_CHANNEL_COUNT];
+volatile uint8_t       pwmSeq[PWM_CHANNEL_COUNT];   // Bumped by the ISR after each update
+
+// Per-loop snapshot consumed by combos, MP3 triggers, kill switches and modes
+InputFrame inputFrame;
+InputStats inputStats;
+
+// Conditioning state (loop context only)
+static unsigned long seenEdge[PWM_CHANNEL_COUNT];      // Last ISR edge already judged
+static int           pendingWidth[PWM_CHANNEL_COUNT];  // Stick jump waiting for a second pulse (0 = none)
+
+static inline void readPWMChannel(uint8_t ch, int &width, unsigned long &lastEdge);
+static int getHeldPWMValue(PWMChannel channel);
 
-volatile unsigned long ch1_start, ch2_start, ch1b_start;
+#if PWM_CAPTURE_BACKEND == PWM_CAPTURE_TIMER
+// Port input registers for the stick pins, looked up once at setup
+static volatile uint8_t* ch1InputReg;
+static volatile uint8_t* ch2InputReg;
+static uint8_t ch1Mask, ch2Mask;
+
+static volatile uint16_t stickRiseTicks[PWM_CHANNEL_COUNT];
+#endif
+
+// CH1B is read from the port in the PCINT2 ISR with either backend
+static volatile uint8_t* ch1bInputReg;
+static uint8_t ch1bMask;
+static uint8_t lastCh1bLevel = 0;
+
+static void setupCaptureTimer() {
+  if (captureTimerRunning) return;
+
+  TCCR3A = 0;                       // Normal mode, free-running
+  TCCR3B = _BV(CS31);               // Prescaler 8 → 0.5 µs per tick
+
+  captureTimerRunning = true;
+}
+
+static void setupButtonSampler() {
+  if (buttonSamplerRunning) return;
+
+  lastButtonLevels = PINA | ((PINC & _BV(6)) << 2);
+
+  OCR3A  = TCNT3 + BUTTON_SAMPLE_TICKS;
+  TIFR3  = _BV(OCF3A);              // Drop any stale compare flag
+  TIMSK3 |= _BV(OCIE3A);
+
+  buttonSamplerRunning = true;
+}
 
 // ===============================
 // === SETUP FUNCTION ===========
 // ===============================
 void setupPWMInputs() {
+  setupCaptureTimer();
+
+  for (uint8_t ch = 0; ch < PWM_CHANNEL_COUNT; ch++) inputFrame.width[ch] = pwmWidth[ch];   // Sticks centred
+  inputFrame.linkLost = true;       // Until receiver A's first pulses
+
+#if RC_INPUT_BACKEND != RC_INPUT_PWM
+  setupReceiverHandler();  // Single-wire receivers fill the same table
+  return;
+#endif
+
   pinMode(CH1_PIN, INPUT);
   pinMode(CH2_PIN, INPUT);
   pinMode(CH1B_PIN, INPUT);
 
+  setupButtonSampler();
+
+#if PWM_CAPTURE_BACKEND == PWM_CAPTURE_TIMER
+  ch1InputReg  = portInputRegister(digitalPinToPort(CH1_PIN));
+  ch2InputReg  = portInputRegister(digitalPinToPort(CH2_PIN));
+  ch1Mask  = digitalPinToBitMask(CH1_PIN);
+  ch2Mask  = digitalPinToBitMask(CH2_PIN);
+
+  attachInterrupt(digitalPinToInterrupt(CH1_PIN), ch1_change, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(CH2_PIN), ch2_change, CHANGE);
+#else
   attachInterrupt(digitalPinToInterrupt(CH1_PIN), ch1_rise, RISING);
   attachInterrupt(digitalPinToInterrupt(CH2_PIN), ch2_rise, RISING);
+#endif
 
-  // Only attach CH1B interrupts in Manual or Carpet Mode
-  if (currentMode == 1 || currentMode == 4) {
-    attachInterrupt(digitalPinToInterrupt(CH1B_PIN), ch1b_rise, RISING);
-  } else {
-    Serial.println("[PWM] CH1B interrupt skipped for encoder compatibility.");
-  }
+  // CH1B: pin-change bank, so it never competes with the encoder's INT pins
+  ch1bInputReg  = portInputRegister(digitalPinToPort(CH1B_PIN));
+  ch1bMask      = digitalPinToBitMask(CH1B_PIN);
+  lastCh1bLevel = *ch1bInputReg & ch1bMask;
+  *digitalPinToPCMSK(CH1B_PIN) |= _BV(digitalPinToPCMSKbit(CH1B_PIN));
+  PCIFR = _BV(digitalPinToPCICRbit(CH1B_PIN));   // Drop any stale change flag
+  *digitalPinToPCICR(CH1B_PIN) |= _BV(digitalPinToPCICRbit(CH1B_PIN));
 }
 
 // ===============================
 // === ACCESSOR FUNCTIONS ========
 // ===============================
-int getPWMValue_CH1A()  { return ch1_value;  }
-int getPWMValue_CH2A()  { return ch2_value;  }
-int getPWMValue_CH1B()  { return ch1b_value; }
+// Stick accessors hold the last width on signal loss (0 would map to full reverse)
+int getPWMValue_CH1A()  { return getHeldPWMValue(PWM_CH1A); }
+int getPWMValue_CH2A()  { return getHeldPWMValue(PWM_CH2A); }
+int getPWMValue_CH1B()  { return getHeldPWMValue(PWM_CH1B); }
+
+static inline void readPWMChannel(uint8_t ch, int &width, unsigned long &lastEdge) {
+  uint8_t seq;
+  do {
+    seq      = pwmSeq[ch];
+    width    = pwmWidth[ch];
+    lastEdge = pwmFallMicros[ch];
+  } while (seq != pwmSeq[ch]);  // ISR updated this channel mid-copy — read again
+}
+
+static int getHeldPWMValue(PWMChannel channel) {
+  int width;
+  unsigned long lastEdge;
+  readPWMChannel(channel, width, lastEdge);
+  return width;
+}
+
+int getPWMValue(PWMChannel channel) {
+  int width;
+  unsigned long lastEdge;
+  readPWMChannel(channel, width, lastEdge);
+
+  if (lastEdge == 0 || micros() - lastEdge > PWM_SIGNAL_TIMEOUT_US) return 0;
+  return width;
+}
+
+void readPWMSnapshot(PWMSnapshot &snapshot) {
+  for (uint8_t ch = 0; ch < PWM_CHANNEL_COUNT; ch++) {
+    readPWMChannel(ch, snapshot.width[ch], snapshot.lastEdge[ch]);
+  }
+}
+
+// ===============================
+// === INPUT FRAME ===============
+// ===============================
+static inline bool isStickChannel(uint8_t ch) {
+  return ch == PWM_CH1A || ch == PWM_CH2A || ch == PWM_CH1B || ch == PWM_CH2B;
+}
+
+// True = believable pulse; it becomes the channel's width
+static bool acceptPulse(uint8_t ch, int width) {
+  if (width < PWM_PULSE_MIN_US || width > PWM_PULSE_MAX_US) {
+    inputStats.rangeRejects++;
+    return false;
+  }
+
+  // Only against a live value: after a dropout the first good pulse is taken as is
+  if (isStickChannel(ch) && inputFrame.valid[ch] && abs(width - inputFrame.width[ch]) > PWM_MAX_STEP_US) {
+    bool confirmed = pendingWidth[ch] && abs(width - pendingWidth[ch]) <= PWM_STEP_CONFIRM_US;
+    if (!confirmed) {
+      pendingWidth[ch] = width;
+      inputStats.stepRejects++;
+      return false;
+    }
+  }
+
+  pendingWidth[ch] = 0;
+  return true;
+}
+
+void updateInputFrame() {
+#if RC_INPUT_BACKEND == RC_INPUT_IBUS || RC_INPUT_BACKEND == RC_INPUT_SBUS
+  updateReceiverHandler();  // Decode any stream bytes that arrived since last pass
+#endif
+
+  PWMSnapshot snapshot;
+  readPWMSnapshot(snapshot);
+
+  unsigned long now = micros();
+  inputFrame.timestamp = now;
+
+  for (uint8_t ch = 0; ch < PWM_CHANNEL_COUNT; ch++) {
+    bool accepted = false;
+    if (snapshot.lastEdge[ch] != seenEdge[ch]) {
+      seenEdge[ch] = snapshot.lastEdge[ch];
+      accepted = acceptPulse(ch, snapshot.width[ch]);
+    }
+    if (accepted) {
+      inputFrame.width[ch]    = snapshot.width[ch];
+      inputFrame.lastEdge[ch] = snapshot.lastEdge[ch];
+    }
+
+    unsigned long lastEdge = inputFrame.lastEdge[ch];
+    unsigned long age = now - lastEdge;
+    inputFrame.fresh[ch] = accepted;
+    inputFrame.age[ch]   = age;
+    inputFrame.valid[ch] = (lastEdge != 0 && age <= PWM_SIGNAL_TIMEOUT_US);
+  }
+
+  // === Link Loss ===
+  bool linkLost = !inputFrame.valid[PWM_CH1A] || !inputFrame.valid[PWM_CH2A];
+  if (linkLost && !inputFrame.linkLost) {
+    unsigned long detectUs = inputFrame.valid[PWM_CH2A] ? inputFrame.age[PWM_CH1A] : inputFrame.age[PWM_CH2A];
+    inputStats.linkLosses++;
+    inputStats.lossDetectUs = detectUs;
+    if (detectUs > inputStats.worstLossDetectUs) inputStats.worstLossDetectUs = detectUs;
+  }
+  inputFrame.linkLost = linkLost;
+}
+
+int getFramePulse(PWMChannel channel) {
+  return inputFrame.valid[channel] ? inputFrame.width[channel] : 0;
+}
+
+// The button sampler writes worstEntryTicks: no ISR may land mid-clear
+void resetInputStats() {
+  noInterrupts();
+  memset(&inputStats, 0, sizeof(inputStats));
+  interrupts();
+}
+
+void storePWMChannel(uint8_t channel, int width, unsigned long now) {
+  noteIdleInput(pwmWidth[channel], width, now);
+  pwmWidth[channel] = width;
+  pwmFallMicros[channel] = now;
+  pwmSeq[channel]++;
+  markLatencyInput(channel);
+}
 
 // ===============================
 // === INTERRUPT HANDLERS ========
@@ -117,30 +404,119 @@ int getPWMValue_CH1B()  { return ch1b_value; }
 
 // === Channel 1 (Turn) ===
 void ch1_rise() {
-  ch1_start = micros();
+  pwmRiseMicros[PWM_CH1A] = micros();
   attachInterrupt(digitalPinToInterrupt(CH1_PIN), ch1_fall, FALLING);
 }
 void ch1_fall() {
-  ch1_value = micros() - ch1_start;
+  unsigned long now = micros();
+  int width = now - pwmRiseMicros[PWM_CH1A];
+  noteIdleInput(pwmWidth[PWM_CH1A], width, now);
+  pwmWidth[PWM_CH1A] = width;
+  pwmFallMicros[PWM_CH1A] = now;
+  pwmSeq[PWM_CH1A]++;
+  markLatencyInput(PWM_CH1A);
   attachInterrupt(digitalPinToInterrupt(CH1_PIN), ch1_rise, RISING);
 }
 
 // === Channel 2 (Drive) ===
 void ch2_rise() {
-  ch2_start = micros();
+  pwmRiseMicros[PWM_CH2A] = micros();
   attachInterrupt(digitalPinToInterrupt(CH2_PIN), ch2_fall, FALLING);
 }
 void ch2_fall() {
-  ch2_value = micros() - ch2_start;
+  unsigned long now = micros();
+  int width = now - pwmRiseMicros[PWM_CH2A];
+  noteIdleInput(pwmWidth[PWM_CH2A], width, now);
+  pwmWidth[PWM_CH2A] = width;
+  pwmFallMicros[PWM_CH2A] = now;
+  pwmSeq[PWM_CH2A]++;
+  markLatencyInput(PWM_CH2A);
   attachInterrupt(digitalPinToInterrupt(CH2_PIN), ch2_rise, RISING);
 }
 
-// === Channel 1B (Dome) ===
-void ch1b_rise() {
-  ch1b_start = micros();
-  attachInterrupt(digitalPinToInterrupt(CH1B_PIN), ch1b_fall, FALLING);
+// === Timer Capture Backend (CHANGE interrupts) ===
+#if PWM_CAPTURE_BACKEND == PWM_CAPTURE_TIMER
+static inline void captureStickEdge(uint8_t ch, bool high, uint16_t tick) {
+  if (high) {
+    stickRiseTicks[ch] = tick;
+  } else {
+    uint16_t ticks = tick - stickRiseTicks[ch];   // Wraps cleanly: pulses ≪ 32 ms
+    int width = (ticks + 1) >> 1;                 // 0.5 µs ticks → µs, rounded
+    unsigned long now = micros();
+    noteIdleInput(pwmWidth[ch], width, now);
+    pwmWidth[ch] = width;
+    pwmFallMicros[ch] = now;
+    pwmSeq[ch]++;
+    markLatencyInput(ch);
+  }
 }
-void ch1b_fall() {
-  ch1b_value = micros() - ch1b_start;
-  attachInterrupt(digitalPinToInterrupt(CH1B_PIN), ch1b_rise, RISING);
+
+void ch1_change()  { uint16_t t = TCNT3; captureStickEdge(PWM_CH1A, *ch1InputReg  & ch1Mask,  t); }
+void ch2_change()  { uint16_t t = TCNT3; captureStickEdge(PWM_CH2A, *ch2InputReg  & ch2Mask,  t); }
+#endif
+
+// === Channel 1B (Dome, PCINT2 bank) ===
+// Fires on either edge; the level says which. Any other port K pin
+// unmasked by mistake shows up as "no change" and is ignored.
+ISR(PCINT2_vect) {
+#if PWM_CAPTURE_BACKEND == PWM_CAPTURE_TIMER
+  uint16_t t = TCNT3;
+#endif
+  uint8_t level = *ch1bInputReg & ch1bMask;
+  if (level == lastCh1bLevel) return;
+  lastCh1bLevel = level;
+
+#if PWM_CAPTURE_BACKEND == PWM_CAPTURE_TIMER
+  captureStickEdge(PWM_CH1B, level, t);
+#else
+  unsigned long now = micros();
+  if (level) {
+    pwmRiseMicros[PWM_CH1B] = now;
+  } else {
+    int width = now - pwmRiseMicros[PWM_CH1B];
+    noteIdleInput(pwmWidth[PWM_CH1B], width, now);
+    pwmWidth[PWM_CH1B] = width;
+    pwmFallMicros[PWM_CH1B] = now;
+    pwmSeq[PWM_CH1B]++;
+    markLatencyInput(PWM_CH1B);
+  }
+#endif
+}
+
+// === Button Channels (CH3–CH6 A, CH2–CH6 B) ===
+static inline void sampleButtons() {
+  uint16_t levels  = PINA | ((PINC & _BV(6)) << 2);
+  uint16_t changed = levels ^ lastButtonLevels;
+  if (!changed) return;
+  lastButtonLevels = levels;
+
+  unsigned long now = micros();
+  for (uint8_t i = 0; i < BUTTON_SAMPLE_COUNT; i++) {
+    if (!(changed & (1 << i))) continue;
+    uint8_t ch = buttonSampleChannel[i];
+    if (levels & (1 << i)) {
+      pwmRiseMicros[ch] = now;
+    } else {
+      int width = now - pwmRiseMicros[ch];
+      noteIdleInput(pwmWidth[ch], width, now);
+      pwmWidth[ch] = width;
+      pwmFallMicros[ch] = now;
+      pwmSeq[ch]++;
+      markLatencyInput(ch);
+    }
+  }
+}
+
+ISR(TIMER3_COMPA_vect) {
+  uint16_t now3  = TCNT3;
+  uint16_t match = OCR3A;
+  uint16_t late  = now3 - match;     // Ticks since the compare matched: this entry's latency
+  if (late > inputStats.worstEntryTicks) inputStats.worstEntryTicks = late > 255 ? 255 : late;
+
+  uint16_t next = match + BUTTON_SAMPLE_TICKS;
+  if ((int16_t)(next - now3) <= 0) next = now3 + BUTTON_SAMPLE_TICKS;  // Entered late: re-anchor, don't wait out a 32.8 ms wrap
+  OCR3A = next;
+
+  sampleButtons();
+  noteIdleIsrTicks(TCNT3 - match);   // Wake-up + entry + body: awake, not asleep
 }
@@ -13,28 +13,111 @@
 #ifndef PWMINPUTHANDLER_H
 #define PWMINPUTHANDLER_H
 
-// Define PWM signal tracking variables
-extern volatile int ch1_value;   // Turn (from Controller A)
-extern volatile int ch2_value;   // Drive (from Controller A)
-extern volatile int ch1b_value;  // Dome (from Controller B)
+#include <Arduino.h>
+#include "InputPins.h"    // CH1_PIN, CH2_PIN, CH1B_PIN and their interrupts
 
-// Define pin assignments for PWM signal inputs (update these according to your actual wiring)
-#define CH1_PIN    2  // Example pin for Channel 1 (Controller A)
-#define CH2_PIN    3  // Example pin for Channel 2 (Controller A)
-#define CH1B_PIN   18 // Example pin for Channel 1 (Controller B)
+// Channel table shared by the stick ISRs and the button sampler
+enum PWMChannel {
+  PWM_CH1A = 0,  // Turn  (Controller A joystick X)
+  PWM_CH2A,      // Drive (Controller A joystick Y)
+  PWM_CH3A,      // Controller A toggle
+  PWM_CH4A,      // Controller A toggle
+  PWM_CH5A,      // Controller A toggle
+  PWM_CH6A,      // Controller A momentary
+  PWM_CH1B,      // Dome  (Controller B joystick X)
+  PWM_CH2B,      // Combo axis (Controller B joystick Y)
+  PWM_CH3B,      // Controller B toggle
+  PWM_CH4B,      // Controller B toggle
+  PWM_CH5B,      // Controller B toggle
+  PWM_CH6B,      // Controller B momentary
+  PWM_CHANNEL_COUNT
+};
+
+// ---------- Input Conditioning (updateInputFrame) ----------
+// A channel with no accepted pulse for PWM_LINK_LOSS_FRAMES frames reads
+// as 0 (like pulseIn() timing out); CH1A or CH2A lost = link lost.
+#define PWM_FRAME_US            22000  // Longest frame your receivers send (50 Hz = 20000, some 45 Hz)
+#define PWM_LINK_LOSS_FRAMES    2      // Missed frames before a channel is lost (1–2)
+#define PWM_SIGNAL_TIMEOUT_US   ((unsigned long)PWM_LINK_LOSS_FRAMES * PWM_FRAME_US)
+#define PWM_PULSE_MIN_US        800    // Narrower = runt pulse (receiver brownout), dropped
+#define PWM_PULSE_MAX_US        2200   // Wider = noise, dropped
+#define PWM_MAX_STEP_US         600    // A stick jump bigger than this needs a second pulse...
+#define PWM_STEP_CONFIRM_US     40     // ...within this of the first before it counts
+
+// Button channels (pins 22–29 + 31) are sampled from the port registers this often
+#define BUTTON_SAMPLE_INTERVAL_US  50
+
+// Tear-free copy of the ISR-owned channel table
+struct PWMSnapshot {
+  int           width[PWM_CHANNEL_COUNT];      // Last pulse width in µs
+  unsigned long lastEdge[PWM_CHANNEL_COUNT];   // micros() of the last falling edge (0 = never)
+};
+
+// One consistent view of every channel, captured once per loop() pass
+struct InputFrame {
+  unsigned long timestamp;                  // micros() when the frame was captured
+  int           width[PWM_CHANNEL_COUNT];   // Last accepted pulse width in µs (held when stale)
+  bool          valid[PWM_CHANNEL_COUNT];   // Pulse accepted within PWM_SIGNAL_TIMEOUT_US
+  bool          fresh[PWM_CHANNEL_COUNT];   // New accepted pulse since the previous frame
+  unsigned long age[PWM_CHANNEL_COUNT];     // µs since the channel's last accepted pulse
+  unsigned long lastEdge[PWM_CHANNEL_COUNT];// micros() of the last accepted falling edge
+  bool          linkLost;                   // CH1A or CH2A lost (true until the first pulses)
+};
+
+extern InputFrame inputFrame;
+
+// Pulses dropped by the conditioning stage, and how fast link loss is seen
+struct InputStats {
+  unsigned long rangeRejects;       // Outside PWM_PULSE_MIN_US..PWM_PULSE_MAX_US
+  unsigned long stepRejects;        // Stick jumps no second pulse confirmed
+  unsigned long linkLosses;
+  unsigned long lossDetectUs;       // Last accepted pulse → link loss declared (last loss)
+  unsigned long worstLossDetectUs;
+  volatile uint8_t worstEntryTicks; // Button sampler: compare match → TCNT3 read, 0.5 µs (255 = ≥ 127 µs)
+};
+
+extern InputStats inputStats;
+
+// Stick capture backend
+//   PWM_CAPTURE_MICROS → RISING/FALLING interrupts timed with micros() (4 µs steps)
+//   PWM_CAPTURE_TIMER  → one CHANGE interrupt per pin, timed from free-running
+//                        Timer3 (0.5 µs steps, no attachInterrupt() per edge)
+#define PWM_CAPTURE_MICROS  1
+#define PWM_CAPTURE_TIMER   2
+#define PWM_CAPTURE_BACKEND PWM_CAPTURE_MICROS
+
+// Receiver input backend (see ReceiverHandler.h for stream settings)
+//   RC_INPUT_PWM   → one wire per channel, ~12 pins (default wiring)
+//   RC_INPUT_CPPM  → one PPM wire per receiver: A on CH1_PIN, B on CPPM_B_PIN
+//   RC_INPUT_IBUS  → FlySky iBUS stream into RC_SERIAL_PORT RX
+//   RC_INPUT_SBUS  → SBUS stream (through an inverter) into RC_SERIAL_PORT RX
+#define RC_INPUT_PWM   1
+#define RC_INPUT_CPPM  2
+#define RC_INPUT_IBUS  3
+#define RC_INPUT_SBUS  4
+#define RC_INPUT_BACKEND RC_INPUT_PWM
 
 // Function declarations
 void setupPWMInputs();
 int getPWMValue_CH1A();
 int getPWMValue_CH2A();
 int getPWMValue_CH1B();
+int getPWMValue(PWMChannel channel);  // Pulse width in µs, 0 if the channel is silent
+
+void readPWMSnapshot(PWMSnapshot &snapshot);  // Consistent copy, never disables interrupts
+void updateInputFrame();                 // Call once at the top of loop()
+int  getFramePulse(PWMChannel channel);  // Frame width, 0 if invalid (pulseIn() semantics)
+void resetInputStats();                  // `reset`: clears inputStats, the ISR-written byte included
+
+// Receiver backends write decoded channels through this (ISR or loop context)
+void storePWMChannel(uint8_t channel, int width, unsigned long now);
 
 // Interrupt handler function declarations
 void ch1_rise();
 void ch1_fall();
 void ch2_rise();
 void ch2_fall();
-void ch1b_rise();
-void ch1b_fall();
+void ch1_change();
+void ch2_change();
 
 #endif
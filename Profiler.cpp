@@ -0,0 +1,370 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                   Profiler.cpp - Shadow-RC System                  ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Shows where each loop pass goes: combo detection, MP3 triggers,   ║
+  ║ the active mode, the motor bus, LEDs and telemetry each get a     ║
+  ║ `micros()` probe, so a change can be proven to shorten the hot    ║
+  ║ path on the real droid instead of guessed at.                     ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - `probeStart()` / `probeEnd(probe, start)` wrap each subsystem call
+    in `Shadow_RC_v1.0.ino`. Each probe keeps count, min, mean, max
+    and an 8-bucket histogram (50 µs … 5 ms, then "over 5 ms").
+  - `micros()` has 4 µs resolution and one probe costs ~5 µs.
+    Set `PROFILER_ENABLED` to 0 to compile the probes out entirely.
+  - Fault counters shown next to the probes:
+      • control tick overruns / missed deadlines  (Scheduler)
+      • Serial2 TX buffer full / packets held     (MotorBus)
+      • stale PWM frames per stick channel         (this file)
+      • telemetry frames dropped                   (Telemetry)
+      • watchdog feed gaps + reset counts          (Failsafe)
+      • boot step times since power-on             (Startup)
+      • MP3 tracks played / cut short / dropped     (MP3Handler)
+      • output messages queued / dropped per port  (SerialTx)
+      • dome moves: time + overshoot               (DomePosition)
+      • time, rate and current active vs parked    (IdleGovernor)
+      • free SRAM, stack peak, buffer sizes        (MemoryReport)
+
+  REPORT:
+  ─────────────────────────────────────────────────────────────────────
+  Type `stats` in the Serial Monitor (see SerialConsole.cpp). The
+  table prints one short row at a time, only when the USB TX buffer
+  is empty, so dumping it never stalls the control tick. `reset`
+  clears every probe and counter.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `Profiler.cpp`
+  Header:    `Profiler.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "Profiler.h"
+#include "PWMInputHandler.h"
+#include "Scheduler.h"
+#include "MotorBus.h"
+#include "DriveController.h"
+#include "Telemetry.h"
+#include "DomePosition.h"
+#include "Failsafe.h"
+#include "Startup.h"
+#include "MP3Handler.h"
+#include "SerialTx.h"
+#include "IdleGovernor.h"
+#include "LatencyTrace.h"
+#include "MemoryReport.h"
+#include <Arduino.h>
+
+ProbeStats       probeStats[PROBE_COUNT];
+ProfilerCounters profilerCounters;
+
+static const char probeNames[PROBE_COUNT][10] PROGMEM = {
+  "input", "mode loop", "motor bus", "tick", "combo", "mp3", "led", "telemetry"
+};
+
+static const uint16_t bucketEdges[PROBE_BUCKETS - 1] = { 50, 100, 250, 500, 1000, 2500, 5000 };
+
+// ==========================
+//          PROBES
+// ==========================
+#if PROFILER_ENABLED
+void probeEnd(uint8_t probe, unsigned long startUs) {
+  unsigned long us = micros() - startUs;
+  ProbeStats &p = probeStats[probe];
+
+  if (p.count == 0 || us < p.minUs) p.minUs = us;
+  if (us > p.maxUs) p.maxUs = us;
+  p.count++;
+  p.totalUs += us;
+
+  uint8_t b = 0;
+  while (b < PROBE_BUCKETS - 1 && us >= bucketEdges[b]) b++;
+  if (p.histogram[b] < 0xFFFF) p.histogram[b]++;
+}
+#endif
+
+void countStaleInputs() {
+  if (!inputFrame.valid[PWM_CH1A]) profilerCounters.stalePwmFrames[0]++;
+  if (!inputFrame.valid[PWM_CH2A]) profilerCounters.stalePwmFrames[1]++;
+  if (!inputFrame.valid[PWM_CH1B]) profilerCounters.stalePwmFrames[2]++;
+}
+
+void resetProfilerStats() {
+  memset(probeStats, 0, sizeof(probeStats));
+  memset(&profilerCounters, 0, sizeof(profilerCounters));
+  resetSchedulerStats();
+  resetMotorBusStats();
+  telemetryStats.dropped = 0;
+  resetInputStats();
+  resetFailsafeStats();
+  memset(&mp3Stats, 0, sizeof(mp3Stats));
+  resetSerialTxStats();
+  resetDomeStats();
+  resetIdleStats();          // After the motor bus: it diffs the packet counts
+}
+
+// ==========================
+//   REPORT (row at a time)
+// ==========================
+#define REPORT_IDLE  0xFF
+
+static uint8_t reportRow = REPORT_IDLE;
+
+void startProfilerReport() {
+  reportRow = 0;
+}
+
+static void printStartupMs(uint8_t step) {
+  if (isStartupStepDone(step)) Serial.print(startupStats.doneMs[step]);
+  else                         Serial.print('-');
+}
+
+// "Active s: 12 | tick/s: 200 | pkt/s: 30 | sleep <=0% | >=~20 mA"
+static void printGovernorRow(uint8_t state) {
+  const GovernorStateStats &s = governorStats.state[state];
+  unsigned long ms = s.ms ? s.ms : 1;
+  Serial.print(state == GOVERNOR_IDLE ? F("Parked s: ") : F("Active s: "));
+  Serial.print(s.ms / 1000);
+  Serial.print(F(" | tick/s: "));
+  Serial.print((unsigned long)(s.ticks * 1000.0 / ms));
+  Serial.print(F(" | pkt/s: "));
+  Serial.print((unsigned long)(s.packets * 1000.0 / ms));
+  Serial.print(F(" | sleep <="));   // Unmeasured ISRs count as asleep
+  Serial.print((unsigned long)(s.sleepMs * 100.0 / ms));
+  Serial.print(F("% | >=~"));
+  Serial.print(estimateIdleCurrent(state));
+  Serial.println(F(" mA"));
+}
+
+// Every row is shorter than the 63 bytes the TX buffer can take at once
+static bool printReportRow(uint8_t row) {
+  if (row == 0) {
+    Serial.println(F("=== Loop Timing (us) ==="));
+    return true;
+  }
+  if (row == 1) {
+    Serial.println(F("  hist: <50 <100 <250 <500 <1k <2.5k <5k >5k"));
+    return true;
+  }
+
+  uint8_t probeRow = row - 2;
+  if (probeRow < PROBE_COUNT * 2) {
+    const ProbeStats &p = probeStats[probeRow / 2];
+    if (probeRow % 2 == 0) {
+      Serial.print((const __FlashStringHelper*)probeNames[probeRow / 2]);
+      Serial.print(F(": n="));
+      Serial.print(p.count);
+      Serial.print(F(" min="));
+      Serial.print(p.minUs);
+      Serial.print(F(" avg="));
+      Serial.print(p.count ? p.totalUs / p.count : 0);
+      Serial.print(F(" max="));
+      Serial.println(p.maxUs);
+    } else {
+      Serial.print(F("  hist:"));
+      for (uint8_t b = 0; b < PROBE_BUCKETS; b++) {
+        Serial.print(' ');
+        Serial.print(p.histogram[b]);
+      }
+      Serial.println();
+    }
+    return true;
+  }
+
+  uint8_t counterRow = row - 2 - PROBE_COUNT * 2;
+  switch (counterRow) {
+    case 0:
+      Serial.print(F("Tick overruns: "));
+      Serial.print(controlTickStats.overruns);
+      Serial.print(F(" | missed: "));
+      Serial.print(controlTickStats.missedDeadlines);
+      Serial.print(F(" | skipped: "));
+      Serial.println(controlTickStats.skippedTicks);
+      return true;
+    case 1:
+      Serial.print(F("Serial2 TX full: "));
+      Serial.print(motorBusStats.txFull);
+      Serial.print(F(" | held: "));
+      Serial.println(motorBusStats.txHeld);
+      return true;
+    case 2:
+      Serial.print(F("Stale PWM  1A: "));
+      Serial.print(profilerCounters.stalePwmFrames[0]);
+      Serial.print(F(" | 2A: "));
+      Serial.print(profilerCounters.stalePwmFrames[1]);
+      Serial.print(F(" | 1B: "));
+      Serial.println(profilerCounters.stalePwmFrames[2]);
+      return true;
+    case 3:
+      Serial.print(F("Telemetry dropped: "));
+      Serial.println(telemetryStats.dropped);
+      return true;
+    case 4:
+      Serial.print(F("Dome encoder errors: "));
+      Serial.println(readDomeEncoderErrors());
+      return true;
+    case 5:
+      Serial.print(F("Input rejected  range: "));
+      Serial.print(inputStats.rangeRejects);
+      Serial.print(F(" | step: "));
+      Serial.print(inputStats.stepRejects);
+      Serial.print(F(" | ISR entry worst: "));
+      Serial.print(inputStats.worstEntryTicks / 2.0, 1);
+      Serial.println(F(" us"));
+      return true;
+    case 6:
+      Serial.print(F("Link lost: "));
+      Serial.print(inputStats.linkLosses);
+      Serial.print(F(" | seen after: "));
+      Serial.print(inputStats.lossDetectUs);
+      Serial.print(F(" us, worst "));
+      Serial.println(inputStats.worstLossDetectUs);
+      return true;
+    case 7:
+      Serial.print(F("Watchdog gap: "));
+      Serial.print(failsafeStats.worstFeedGapUs);
+      Serial.print(F(" us | late feeds: "));
+      Serial.println(failsafeStats.lateFeeds);
+      return true;
+    case 8:
+      Serial.print(F("Resets  wdt: "));
+      Serial.print(failsafeStats.resets[RESET_WATCHDOG]);
+      Serial.print(F(" | brown-out: "));
+      Serial.print(failsafeStats.resets[RESET_BROWN_OUT]);
+      Serial.print(F(" | ext: "));
+      Serial.println(failsafeStats.resets[RESET_EXTERNAL]);
+      return true;
+    case 9:
+      Serial.print(F("Power-ons: "));
+      Serial.print(failsafeStats.resets[RESET_POWER_ON]);
+      Serial.print(F(" | this boot: "));
+      Serial.println(resetCauseName(failsafeStats.resetCause));
+      return true;
+    case 10:
+      Serial.print(F("Boot ms  bus: "));
+      printStartupMs(STARTUP_MOTOR_BUS);
+      Serial.print(F(" | 1st cmd: "));
+      printStartupMs(STARTUP_FIRST_COMMAND);
+      Serial.print(F(" | mp3: "));
+      printStartupMs(STARTUP_MP3);
+      Serial.println();
+      return true;
+    case 11:
+      Serial.print(F("MP3 played: "));
+      Serial.print(mp3Stats.played);
+      Serial.print(F(" | cut: "));
+      Serial.print(mp3Stats.preempted);
+      Serial.print(F(" | waited: "));
+      Serial.print(mp3Stats.waited);
+      Serial.print(F(" | dropped: "));
+      Serial.println(mp3Stats.dropped);
+      return true;
+    case 12:
+      Serial.print(F("TX usb/s1/s3 waited: "));
+      Serial.print(txStats[TX_PORT_USB].queued);
+      Serial.print(F("/"));
+      Serial.print(txStats[TX_PORT_SERIAL1].queued);
+      Serial.print(F("/"));
+      Serial.print(txStats[TX_PORT_SERIAL3].queued);
+      Serial.print(F(" | dropped: "));
+      Serial.print(txStats[TX_PORT_USB].dropped);
+      Serial.print(F("/"));
+      Serial.print(txStats[TX_PORT_SERIAL1].dropped);
+      Serial.print(F("/"));
+      Serial.print(txStats[TX_PORT_SERIAL3].dropped);
+      Serial.print(F(" | merged: "));
+      Serial.println(txStats[TX_PORT_SERIAL1].coalesced + txStats[TX_PORT_SERIAL3].coalesced);
+      return true;
+    case 13:
+      Serial.print(F("Dome moves: "));
+      Serial.print(domeStats.moves);
+      Serial.print(F(" | last: "));
+      Serial.print(domeStats.lastMoveMs);
+      Serial.print(F(" ms | overshoot: "));
+      Serial.print(domeStats.lastOvershoot);
+      Serial.print(F(" worst "));
+      Serial.print(domeStats.worstOvershoot);
+      Serial.println(F(" counts"));
+      return true;
+    case 14:
+    case 15:
+      printGovernorRow(counterRow == 14 ? GOVERNOR_ACTIVE : GOVERNOR_IDLE);
+      return true;
+    case 16:
+      Serial.print(F("Parked: "));
+      Serial.print(governorStats.entries);
+      Serial.print(F(" | pulse wakes: "));
+      Serial.print(governorStats.edgeWakes);
+      Serial.print(F(" | wake us: "));
+      Serial.print(governorStats.lastWakeUs);
+      Serial.print(F(" worst "));
+      Serial.println(governorStats.worstWakeUs);
+      return true;
+    case 17:
+    case 18: {
+      MemoryUsage mem;
+      readMemoryUsage(mem);
+      if (counterRow == 17) {
+        Serial.print(F("SRAM static: "));
+        Serial.print(mem.staticBytes);
+        Serial.print(F(" | free: "));
+        Serial.print(mem.freeBytes);
+        Serial.print(F(" | never used: "));
+        Serial.println(mem.neverUsedBytes);
+      } else {
+        Serial.print(F("Stack now: "));
+        Serial.print(mem.stackBytes);
+        Serial.print(F(" | peak: "));
+        Serial.println(mem.stackPeakBytes);
+      }
+      return true;
+    }
+    case 19:
+      Serial.print(F("Buffers  tx: "));
+      Serial.print(TX_USB_QUEUE_BYTES + TX_SERIAL1_QUEUE_BYTES + TX_SERIAL3_QUEUE_BYTES);
+      Serial.print(F(" | tlm: "));
+      Serial.print(TELEMETRY_RING_BYTES);
+      Serial.print(F(" | uart: "));
+      Serial.print(4 * (SERIAL_RX_BUFFER_SIZE + SERIAL_TX_BUFFER_SIZE));
+      Serial.print(F(" | lat: "));
+      Serial.println(LATENCY_TRACE ? sizeof(LatencyStats) * LATENCY_PATH_COUNT : 0);
+      return true;
+    case 20:
+      if (MOTOR_FEEDBACK_POLL_MS == 0) return false;
+      Serial.print(F("2x32 V: "));
+      Serial.print(driveFeedback.batteryDv / 10.0, 1);
+      Serial.print(F(" | A: "));
+      Serial.print(driveFeedback.currentDa[0] / 10.0, 1);
+      Serial.print(F("/"));
+      Serial.print(driveFeedback.currentDa[1] / 10.0, 1);
+      Serial.print(F(" | C: "));
+      Serial.print(driveFeedback.temperatureC[0]);
+      Serial.print(F("/"));
+      Serial.println(driveFeedback.temperatureC[1]);
+      return true;
+    case 21:
+      Serial.print(F("2x32 gets: "));
+      Serial.print(driveFeedback.requests);
+      Serial.print(F(" | missed: "));
+      Serial.print(driveFeedback.missed);
+      Serial.print(F(" | traction: "));
+      Serial.print(((long)driveGovernor.scale * 100 + Q8_8_ONE / 2) / Q8_8_ONE);
+      Serial.print(F("% ramp "));
+      Serial.println(driveGovernor.maxStep);
+      return true;
+  }
+  return false;  // Past the last row
+}
+
+void updateProfilerReport() {
+  if (reportRow == REPORT_IDLE) return;
+  if (Serial.availableForWrite() < SERIAL_TX_BUFFER_SIZE - 1) return;  // Wait for an empty buffer
+
+  if (printReportRow(reportRow)) reportRow++;
+  else reportRow = REPORT_IDLE;
+}
@@ -0,0 +1,68 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                   Profiler.h - Shadow-RC                   ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the per-subsystem timing probes.                ║
+  ║ micros() probes with min / mean / max and a histogram,     ║
+  ║ plus fault counters, dumped by the "stats" command.        ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are adding a probe.                 ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+
+#define PROFILER_ENABLED   1    // 0 = probes compile to nothing
+
+// One probe per subsystem; order is the report order
+enum ProbeId {
+  PROBE_INPUT_FRAME = 0,   // updateInputFrame()
+  PROBE_MODE_LOOP,         // loopXMode() for the active mode
+  PROBE_MOTOR_BUS,         // updateMotorBus() inside the control tick
+  PROBE_CONTROL_TICK,      // Whole control tick
+  PROBE_COMBO,             // updateComboHandler()
+  PROBE_MP3,               // updateMP3Handler()
+  PROBE_LED,               // updateLEDPattern()
+  PROBE_TELEMETRY,         // updateTelemetry() drain
+  PROBE_COUNT
+};
+
+// Histogram bucket upper edges in µs; the last bucket is everything above
+#define PROBE_BUCKETS  8
+// 50, 100, 250, 500, 1000, 2500, 5000, >5000
+
+struct ProbeStats {
+  unsigned long count;
+  unsigned long minUs;
+  unsigned long maxUs;
+  unsigned long totalUs;                 // For the mean; reset before ~71 min of busy time
+  uint16_t      histogram[PROBE_BUCKETS];
+};
+
+struct ProfilerCounters {
+  unsigned long stalePwmFrames[3];       // Control ticks with CH1A / CH2A / CH1B silent
+};
+
+extern ProbeStats       probeStats[PROBE_COUNT];
+extern ProfilerCounters profilerCounters;
+
+// ---------- Probes ----------
+#if PROFILER_ENABLED
+static inline unsigned long probeStart() { return micros(); }
+void probeEnd(uint8_t probe, unsigned long startUs);
+#else
+static inline unsigned long probeStart() { return 0; }
+static inline void probeEnd(uint8_t, unsigned long) {}
+#endif
+
+void countStaleInputs();                 // Once per control tick, after updateInputFrame()
+
+// ---------- Report ----------
+void startProfilerReport();              // Queues the table; printed a row at a time
+void updateProfilerReport();             // Prints the next row if USB TX has room
+void resetProfilerStats();
+
+#endif
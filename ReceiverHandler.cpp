@@ -0,0 +1,210 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                ReceiverHandler.cpp - Shadow-RC System              ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Decodes single-wire receiver outputs as an alternative to running  ║
+  ║ one PWM wire per channel. A whole receiver frame is decoded at     ║
+  ║ once and written into the same channel table used by every mode,  ║
+  ║ so ComboHandler, MP3Handler and the drive code need no changes.    ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  SUPPORTED BACKENDS (`RC_INPUT_BACKEND` in PWMInputHandler.h):
+  ─────────────────────────────────────────────────────────────────────
+  - RC_INPUT_CPPM
+      • Receiver A PPM output → CH1_PIN  (pin 2)
+      • Receiver B PPM output → CPPM_B_PIN (pin 21)
+      • Rising-edge interrupts timed from Timer3 (0.5 µs ticks)
+      • A gap longer than `CPPM_SYNC_GAP_US` marks the frame start
+  - RC_INPUT_IBUS
+      • FlySky iBUS servo output → RX of `RC_SERIAL_PORT` (115200 8N1)
+      • 32-byte frames every ~7 ms, 14 channels, checksum verified
+  - RC_INPUT_SBUS
+      • SBUS output → RX of `RC_SERIAL_PORT` (100000 8E2)
+      • SBUS is inverted: a signal inverter is REQUIRED on the Mega
+      • 25-byte frames every 7–14 ms, 16 channels, failsafe flag honored
+
+  CHANNEL MAPPING (serial streams):
+  ─────────────────────────────────────────────────────────────────────
+  Stream channels 1–6 feed Controller A CH1–CH6 and 7–12 feed Controller
+  B CH1–CH6, so one 12-channel transmitter (or a receiver pair merged
+  into one stream) replaces both PWM receivers. Edit
+  `streamChannelMap` to change the assignment.
+
+  NOTES:
+  ─────────────────────────────────────────────────────────────────────
+  - Serial bytes are decoded in `updateReceiverHandler()` from the
+    control tick and the 1 ms "tx" task, so the 64-byte RX buffer is
+    drained even while the idle governor stretches the tick to 20 ms;
+    nothing blocks. Keep every task under ~5 ms.
+  - `RC_SERIAL_PORT` TX runs at the receiver's baud rate, so nothing
+    else may transmit on it. The Mega has no spare UART: with the
+    stream on Serial3, set `MARCDUINO_SETUP` 1 (MarcDuino shares
+    Serial1 with the MP3 Trigger) or 0. ComboHandler.cpp refuses to
+    build otherwise.
+  - A frame that fails its checksum is dropped and counted in
+    `receiverBadFrames`. Channels then go stale exactly like a
+    silent PWM wire.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `ReceiverHandler.cpp`
+  Header:    `ReceiverHandler.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "ReceiverHandler.h"
+#include <Arduino.h>
+
+// ---------- Statistics ----------
+unsigned long receiverFrameCount = 0;
+unsigned long receiverBadFrames  = 0;
+
+// ---------- Stream Channel Map ----------
+static const uint8_t streamChannelMap[RC_SERIAL_CHANNELS] = {
+  PWM_CH1A, PWM_CH2A, PWM_CH3A, PWM_CH4A, PWM_CH5A, PWM_CH6A,
+  PWM_CH1B, PWM_CH2B, PWM_CH3B, PWM_CH4B, PWM_CH5B, PWM_CH6B
+};
+
+// ==========================
+//           CPPM
+// ==========================
+#if RC_INPUT_BACKEND == RC_INPUT_CPPM
+
+struct CPPMDecoder {
+  uint16_t lastTick;
+  uint8_t  index;      // Next channel in the frame, 0xFF until first sync
+};
+
+static CPPMDecoder cppmA = { 0, 0xFF };
+static CPPMDecoder cppmB = { 0, 0xFF };
+
+static inline void cppmEdge(CPPMDecoder &d, uint8_t firstChannel, uint16_t tick) {
+  uint16_t us = (uint16_t)(tick - d.lastTick) >> 1;  // 0.5 µs ticks → µs
+  d.lastTick = tick;
+
+  if (us >= CPPM_SYNC_GAP_US) {
+    d.index = 0;
+    if (firstChannel == PWM_CH1A) receiverFrameCount++;
+    return;
+  }
+  if (d.index < CPPM_CHANNELS) {
+    storePWMChannel(firstChannel + d.index, us, micros());
+    d.index++;
+  }
+}
+
+void cppmA_rise() { uint16_t t = TCNT3; cppmEdge(cppmA, PWM_CH1A, t); }
+void cppmB_rise() { uint16_t t = TCNT3; cppmEdge(cppmB, PWM_CH1B, t); }
+
+#endif
+
+// ==========================
+//           iBUS
+// ==========================
+#if RC_INPUT_BACKEND == RC_INPUT_IBUS
+
+static const uint8_t IBUS_FRAME_LENGTH = 32;
+static const uint8_t IBUS_CHANNELS     = 14;
+
+static uint8_t ibusBuffer[IBUS_FRAME_LENGTH];
+static uint8_t ibusIndex = 0;
+
+static void decodeIBUSByte(uint8_t b) {
+  if (ibusIndex == 0 && b != 0x20) return;                      // Length byte
+  if (ibusIndex == 1 && b != 0x40) { ibusIndex = (b == 0x20); return; }  // Servo command
+
+  ibusBuffer[ibusIndex++] = b;
+  if (ibusIndex < IBUS_FRAME_LENGTH) return;
+  ibusIndex = 0;
+
+  uint16_t sum = 0xFFFF;
+  for (uint8_t i = 0; i < IBUS_FRAME_LENGTH - 2; i++) sum -= ibusBuffer[i];
+  uint16_t check = ibusBuffer[30] | (ibusBuffer[31] << 8);
+  if (sum != check) {
+    receiverBadFrames++;
+    return;
+  }
+
+  unsigned long now = micros();
+  for (uint8_t i = 0; i < RC_SERIAL_CHANNELS && i < IBUS_CHANNELS; i++) {
+    uint16_t value = ibusBuffer[2 + i * 2] | (ibusBuffer[3 + i * 2] << 8);
+    storePWMChannel(streamChannelMap[i], value & 0x0FFF, now);
+  }
+  receiverFrameCount++;
+}
+
+#endif
+
+// ==========================
+//           SBUS
+// ==========================
+#if RC_INPUT_BACKEND == RC_INPUT_SBUS
+
+static const uint8_t SBUS_FRAME_LENGTH  = 25;
+static const uint8_t SBUS_CHANNELS      = 16;
+static const uint8_t SBUS_FLAG_FAILSAFE = 0x08;
+
+static uint8_t sbusBuffer[SBUS_FRAME_LENGTH];
+static uint8_t sbusIndex = 0;
+
+static void decodeSBUSByte(uint8_t b) {
+  if (sbusIndex == 0 && b != 0x0F) return;  // Header
+
+  sbusBuffer[sbusIndex++] = b;
+  if (sbusIndex < SBUS_FRAME_LENGTH) return;
+  sbusIndex = 0;
+
+  if (sbusBuffer[24] != 0x00) {             // Footer
+    receiverBadFrames++;
+    return;
+  }
+  if (sbusBuffer[23] & SBUS_FLAG_FAILSAFE) return;  // Receiver lost the transmitter
+
+  unsigned long now = micros();
+  uint32_t bits = 0;
+  uint8_t  bitCount = 0;
+  uint8_t  byteIndex = 1;
+  for (uint8_t i = 0; i < RC_SERIAL_CHANNELS && i < SBUS_CHANNELS; i++) {
+    while (bitCount < 11) {
+      bits |= (uint32_t)sbusBuffer[byteIndex++] << bitCount;
+      bitCount += 8;
+    }
+    uint16_t raw = bits & 0x07FF;
+    bits >>= 11;
+    bitCount -= 11;
+
+    storePWMChannel(streamChannelMap[i], (raw * 5) / 8 + 880, now);  // 172–1811 → ~988–2012 µs
+  }
+  receiverFrameCount++;
+}
+
+#endif
+
+// ==========================
+//        SETUP + LOOP
+// ==========================
+void setupReceiverHandler() {
+#if RC_INPUT_BACKEND == RC_INPUT_CPPM
+  pinMode(CH1_PIN, INPUT);
+  pinMode(CPPM_B_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(CH1_PIN),    cppmA_rise, RISING);
+  attachInterrupt(digitalPinToInterrupt(CPPM_B_PIN), cppmB_rise, RISING);
+  Serial.println(F("[RC] CPPM input on pins 2 (A) and 21 (B)."));
+#elif RC_INPUT_BACKEND == RC_INPUT_IBUS
+  RC_SERIAL_PORT.begin(115200);
+  Serial.println(F("[RC] iBUS input on RC_SERIAL_PORT."));
+#elif RC_INPUT_BACKEND == RC_INPUT_SBUS
+  RC_SERIAL_PORT.begin(100000, SERIAL_8E2);
+  Serial.println(F("[RC] SBUS input on RC_SERIAL_PORT."));
+#endif
+}
+
+void updateReceiverHandler() {
+#if RC_INPUT_BACKEND == RC_INPUT_IBUS
+  while (RC_SERIAL_PORT.available()) decodeIBUSByte(RC_SERIAL_PORT.read());
+#elif RC_INPUT_BACKEND == RC_INPUT_SBUS
+  while (RC_SERIAL_PORT.available()) decodeSBUSByte(RC_SERIAL_PORT.read());
+#endif
+}
@@ -0,0 +1,45 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║              ReceiverHandler.h - Shadow-RC                 ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for single-wire receiver input (CPPM, iBUS, SBUS).  ║
+  ║ Select the backend with `RC_INPUT_BACKEND` in              ║
+  ║ `PWMInputHandler.h`; decoded channels land in the same     ║
+  ║ table the `getPWMValue_*()` functions read.                ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing receiver hardware.     ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef RECEIVER_HANDLER_H
+#define RECEIVER_HANDLER_H
+
+#include <Arduino.h>
+#include "PWMInputHandler.h"
+
+// ---------- Serial Stream (iBUS / SBUS) ----------
+// Serial1 is the MP3 Trigger and Serial2 the motor bus; on Serial3 (RX3,
+// pin 15) the MarcDuino needs MARCDUINO_SETUP 1 or 0 (ComboHandler.cpp)
+#define RC_SERIAL_PORT_NUMBER 3
+#define RC_SERIAL_PORT_NAME(n)  Serial ## n
+#define RC_SERIAL_PORT_OF(n)    RC_SERIAL_PORT_NAME(n)
+#define RC_SERIAL_PORT      RC_SERIAL_PORT_OF(RC_SERIAL_PORT_NUMBER)
+#define RC_SERIAL_CHANNELS  12       // Stream ch 1–6 → Controller A, 7–12 → Controller B
+
+// ---------- CPPM ----------
+#define CPPM_SYNC_GAP_US    3000     // Any gap longer than this starts a new frame
+#define CPPM_CHANNELS       6        // Channels used per receiver
+
+// ---------- Setup & Loop ----------
+void setupReceiverHandler();
+void updateReceiverHandler();        // Serial backends: control tick + "tx" task (at least every ~5 ms)
+
+// ---------- CPPM Interrupt Handlers ----------
+void cppmA_rise();
+void cppmB_rise();
+
+// ---------- Statistics ----------
+extern unsigned long receiverFrameCount;  // Complete frames decoded
+extern unsigned long receiverBadFrames;   // Checksum / framing failures
+
+#endif
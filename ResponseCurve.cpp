@@ -0,0 +1,67 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                 ResponseCurve.cpp - Shadow-RC System               ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Builds the exponential joystick response tables shared by Manual, ║
+  ║ Carpet and Hybrid Mode. The Mega has no FPU, so one `pow()` costs  ║
+  ║ on the order of 100+ µs; doing three per frame (drive, turn,      ║
+  ║ dome) was a large slice of the 5 ms control tick.                  ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - Each table holds `pow(i / 127.0, curve) * limit` for i = 0–127,
+    truncated exactly like the old `applyExpoCurve()`.
+  - Tables are built once, when their owner is constructed at boot
+    (128 `pow()` calls, or none at all when the curve is 1.0).
+  - `applyResponseCurve()` is a single table read plus a sign flip.
+  - Changing `expoCurve` or a speed limit at runtime: call
+    `setResponseCurve()` with the new values. It rebuilds only if
+    something actually changed.
+  - A full rebuild is too long for one 5 ms tick when `curve` is not
+    1.0. The `tune` command (TuningStore.cpp) builds a spare table a
+    few `responseCurveEntry()` rows per pass instead, then swaps it in.
+
+  MEMORY:
+  ─────────────────────────────────────────────────────────────────────
+  128 bytes of SRAM per table. Drive and turn share one table
+  because they always use the same curve and limit.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `ResponseCurve.cpp`
+  Header:    `ResponseCurve.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "ResponseCurve.h"
+#include <Arduino.h>
+
+ResponseCurve::ResponseCurve(float curve, int limit) {
+  buildResponseCurve(*this, curve, limit);
+}
+
+void buildResponseCurve(ResponseCurve &c, float curve, int limit) {
+  limit = constrain(limit, 0, 255);
+  c.curve = curve;
+  c.limit = limit;
+
+  for (int i = 0; i < RESPONSE_CURVE_SIZE; i++) {
+    c.table[i] = responseCurveEntry(curve, limit, i);
+  }
+}
+
+uint8_t responseCurveEntry(float curve, int limit, int i) {
+  limit = constrain(limit, 0, 255);
+  if (curve == 1.0) return (uint8_t)((long)i * limit / 127);   // Linear: no pow() needed
+  float normalized = i / 127.0;
+  return (uint8_t)(pow(normalized, curve) * limit);
+}
+
+bool setResponseCurve(ResponseCurve &c, float curve, int limit) {
+  if (c.curve == curve && c.limit == constrain(limit, 0, 255)) return false;
+  buildResponseCurve(c, curve, limit);
+  return true;
+}
@@ -0,0 +1,40 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                ResponseCurve.h - Shadow-RC                 ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for precomputed joystick response curves.           ║
+  ║ One 128-entry table per (expoCurve, limit) pair replaces   ║
+  ║ the per-frame pow() in every mode.                         ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing how curves are shaped. ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef RESPONSE_CURVE_H
+#define RESPONSE_CURVE_H
+
+#include <Arduino.h>
+
+#define RESPONSE_CURVE_SIZE  128   // One entry per input magnitude 0–127
+
+struct ResponseCurve {
+  ResponseCurve(float curve, int limit);
+
+  float   curve;                        // Exponent the table was built with
+  int     limit;                        // Output at full stick (0–255)
+  uint8_t table[RESPONSE_CURVE_SIZE];   // |output| for each |input|
+};
+
+// ---------- Building ----------
+void buildResponseCurve(ResponseCurve &c, float curve, int limit);
+bool setResponseCurve(ResponseCurve &c, float curve, int limit);  // Rebuilds only if changed
+uint8_t responseCurveEntry(float curve, int limit, int i);        // One row, for building a few per pass
+
+// ---------- Lookup (O(1), integer only) ----------
+// Same result as the old applyExpoCurve(): sign kept, |input| capped at 127
+static inline int applyResponseCurve(const ResponseCurve &c, int input) {
+  if (input >= 0) return c.table[input > 127 ? 127 : input];
+  return -(int)c.table[input < -127 ? 127 : -input];
+}
+
+#endif
@@ -0,0 +1,252 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                   Scheduler.cpp - Shadow-RC System                 ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Runs the main loop as one deadline-driven control tick plus a set  ║
+  ║ of cooperative background tasks. The control tick always goes     ║
+  ║ first, so a slow sound trigger or debug line can no longer hold   ║
+  ║ back motor output.                                                 ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - The control tick is released every `CONTROL_TICK_US` on a fixed
+    grid (release = previous release + period, never "now + period"),
+    so its rate does not drift with loop load.
+  - Each `runScheduler()` pass runs the control tick if it is due,
+    then at most ONE background task, then returns to `loop()`.
+  - The due task with the highest priority runs first; ties go to
+    the task that has waited longest.
+  - A task only starts if its worst run so far fits before the next
+    control release. A task that has waited a full period extra runs
+    anyway so nothing starves.
+  - The period is `CONTROL_TICK_US` unless the idle governor slowed
+    it (`setControlTickPeriod()`). `releaseControlTick()` runs the
+    tick on the next pass, so a wake-up does not wait out the slow
+    period; the tick after it is back on the old grid, so its phase
+    against the receiver frames does not change.
+
+  DEADLINE ACCOUNTING:
+  ─────────────────────────────────────────────────────────────────────
+  - missedDeadlines → tick finished more than one period after release
+  - skippedTicks    → loop fell a whole period behind; late releases
+                      are dropped instead of run back to back
+  - overruns        → the tick body alone is longer than the period
+  Call `printSchedulerStats()` to dump these plus every task's worst
+  run time over USB serial.
+
+  NOTES:
+  ─────────────────────────────────────────────────────────────────────
+  - Tasks are cooperative: they must return quickly and never call
+    `delay()`. Use `millis()` state machines instead.
+  - `micros()` wraps every ~71 minutes; all comparisons are done on
+    differences so the wrap is harmless.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `Scheduler.cpp`
+  Header:    `Scheduler.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "Scheduler.h"
+#include <Arduino.h>
+
+// ---------- Control Tick State ----------
+ControlTickStats controlTickStats;
+
+static TaskFunction  controlTickFunction = nullptr;
+static unsigned long nextControlRelease  = 0;
+static unsigned long controlPeriodUs     = CONTROL_TICK_US;
+static unsigned long gridRelease         = 0;       // Grid slot an early release stepped off
+static bool          earlyRelease        = false;
+
+// ---------- Background Tasks ----------
+static SchedulerTask tasks[SCHEDULER_MAX_TASKS];
+static uint8_t taskCount = 0;
+
+// true once `now` has reached `deadline` (wrap-safe)
+static inline bool reached(unsigned long now, unsigned long deadline) {
+  return (long)(now - deadline) >= 0;
+}
+
+// ==========================
+//           SETUP
+// ==========================
+void setupScheduler(TaskFunction controlTick) {
+  controlTickFunction = controlTick;
+  nextControlRelease  = micros();
+
+  unsigned long now = micros();
+  for (uint8_t i = 0; i < taskCount; i++) tasks[i].nextRunUs = now;
+
+  resetSchedulerStats();
+}
+
+bool addSchedulerTask(const char* name, TaskFunction run, unsigned long periodUs, uint8_t priority) {
+  if (taskCount >= SCHEDULER_MAX_TASKS) {
+    Serial.print(F("[SCHED] Task table full, dropped: "));
+    Serial.println(name);
+    return false;
+  }
+
+  SchedulerTask &t = tasks[taskCount++];
+  t.name      = name;
+  t.run       = run;
+  t.periodUs  = periodUs;
+  t.nextRunUs = micros();
+  t.priority  = priority;
+  t.runs      = 0;
+  t.worstUs   = 0;
+  return true;
+}
+
+// ==========================
+//        CONTROL TICK
+// ==========================
+static void runControlTick(unsigned long now) {
+  unsigned long lateness = now - nextControlRelease;
+  if (lateness > controlTickStats.worstLatenessUs) controlTickStats.worstLatenessUs = lateness;
+
+  controlTickFunction();
+
+  unsigned long end = micros();
+  unsigned long duration = end - now;
+  controlTickStats.ticks++;
+  controlTickStats.lastUs = duration;
+  if (duration > controlTickStats.worstUs) controlTickStats.worstUs = duration;
+  if (duration > controlPeriodUs)          controlTickStats.overruns++;
+  if (end - nextControlRelease > controlPeriodUs) controlTickStats.missedDeadlines++;
+
+  if (earlyRelease) {
+    // Back onto the grid: its first slot after this tick, at the current period
+    while ((long)(gridRelease - controlPeriodUs - end) > 0) gridRelease -= controlPeriodUs;
+    nextControlRelease = gridRelease;
+    earlyRelease = false;
+  } else {
+    nextControlRelease += controlPeriodUs;
+  }
+
+  // Fell a whole period (or more) behind: drop the late releases and re-align
+  if (reached(end, nextControlRelease)) {
+    unsigned long behind = (end - nextControlRelease) / controlPeriodUs + 1;
+    controlTickStats.skippedTicks += behind;
+    nextControlRelease += behind * controlPeriodUs;
+  }
+}
+
+void setControlTickPeriod(unsigned long periodUs) {
+  controlPeriodUs = periodUs;
+}
+
+unsigned long getControlTickPeriod() {
+  return controlPeriodUs;
+}
+
+void releaseControlTick() {
+  if (!earlyRelease) gridRelease = nextControlRelease;
+  earlyRelease = true;
+  nextControlRelease = micros();
+}
+
+// ==========================
+//         MAIN LOOP
+// ==========================
+bool runScheduler() {
+  unsigned long now = micros();
+  bool ran = false;
+
+  if (controlTickFunction && reached(now, nextControlRelease)) {
+    runControlTick(now);
+    now = micros();
+    ran = true;
+  }
+
+  // Pick the most urgent due task
+  int8_t pick = -1;
+  for (uint8_t i = 0; i < taskCount; i++) {
+    SchedulerTask &t = tasks[i];
+    if (!reached(now, t.nextRunUs)) continue;
+
+    if (pick < 0 ||
+        t.priority < tasks[pick].priority ||
+        (t.priority == tasks[pick].priority &&
+         (now - t.nextRunUs) > (now - tasks[pick].nextRunUs))) {
+      pick = i;
+    }
+  }
+  if (pick < 0) return ran;
+
+  SchedulerTask &t = tasks[pick];
+
+  // Leave the slot to the control tick unless this task has waited a full extra period
+  unsigned long slack = controlTickFunction ? (nextControlRelease - now) : 0xFFFFFFFFUL;
+  bool starving = (now - t.nextRunUs) >= t.periodUs;
+  if (t.worstUs > slack && !starving) return true;    // Due, just not yet: do not sleep
+
+  t.run();
+
+  unsigned long end = micros();
+  unsigned long duration = end - now;
+  t.runs++;
+  if (duration > t.worstUs) t.worstUs = duration;
+
+  t.nextRunUs += t.periodUs;
+  if (reached(end, t.nextRunUs)) t.nextRunUs = end + t.periodUs;  // Don't burst to catch up
+  return true;
+}
+
+// Earliest of the next control release and every task's next run
+unsigned long getSchedulerNextDueUs() {
+  unsigned long now = micros();
+  unsigned long due = controlTickFunction ? nextControlRelease : now + 0x7FFFFFFFUL;
+  for (uint8_t i = 0; i < taskCount; i++) {
+    if ((long)(tasks[i].nextRunUs - due) < 0) due = tasks[i].nextRunUs;
+  }
+  return due;
+}
+
+// ==========================
+//         STATISTICS
+// ==========================
+void printSchedulerStats() {
+  Serial.println(F("=== Scheduler ==="));
+  Serial.print(F("Control tick: "));
+  Serial.print(controlTickStats.ticks);
+  Serial.print(F(" runs | last "));
+  Serial.print(controlTickStats.lastUs);
+  Serial.print(F(" us | worst "));
+  Serial.print(controlTickStats.worstUs);
+  Serial.print(F(" us | worst late "));
+  Serial.print(controlTickStats.worstLatenessUs);
+  Serial.println(F(" us"));
+
+  Serial.print(F("Missed deadlines: "));
+  Serial.print(controlTickStats.missedDeadlines);
+  Serial.print(F(" | Skipped: "));
+  Serial.print(controlTickStats.skippedTicks);
+  Serial.print(F(" | Overruns: "));
+  Serial.println(controlTickStats.overruns);
+
+  for (uint8_t i = 0; i < taskCount; i++) {
+    Serial.print(F("  ["));
+    Serial.print(tasks[i].priority);
+    Serial.print(F("] "));
+    Serial.print(tasks[i].name);
+    Serial.print(F(": "));
+    Serial.print(tasks[i].runs);
+    Serial.print(F(" runs | worst "));
+    Serial.print(tasks[i].worstUs);
+    Serial.println(F(" us"));
+  }
+}
+
+void resetSchedulerStats() {
+  memset(&controlTickStats, 0, sizeof(controlTickStats));
+  for (uint8_t i = 0; i < taskCount; i++) {
+    tasks[i].runs = 0;
+    tasks[i].worstUs = 0;
+  }
+}
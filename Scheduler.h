@@ -0,0 +1,70 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                  Scheduler.h - Shadow-RC                   ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the main-loop scheduler.                        ║
+  ║ One fixed-rate control tick (sticks → shaping → motors)    ║
+  ║ plus cooperative background tasks by priority.             ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing loop timing.           ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+// ---------- Control Tick ----------
+#define CONTROL_TICK_US       5000   // 200 Hz: read sticks → shape → send motor commands
+                                     // (IdleGovernor.h slows it while the droid is parked)
+
+// ---------- Background Tasks ----------
+#define SCHEDULER_MAX_TASKS   8
+
+typedef void (*TaskFunction)();
+
+enum TaskPriority {
+  TASK_PRIORITY_HIGH = 0,   // Combos, mode changes
+  TASK_PRIORITY_NORMAL,     // MP3 triggers, show commands
+  TASK_PRIORITY_LOW         // LEDs, logging
+};
+
+struct SchedulerTask {
+  const char*   name;
+  TaskFunction  run;
+  unsigned long periodUs;
+  unsigned long nextRunUs;
+  uint8_t       priority;
+  unsigned long runs;
+  unsigned long worstUs;    // Longest single run seen
+};
+
+struct ControlTickStats {
+  unsigned long ticks;            // Control ticks run
+  unsigned long missedDeadlines;  // Ticks that finished more than one period after release
+  unsigned long skippedTicks;     // Releases dropped because the loop fell a whole period behind
+  unsigned long overruns;         // Tick bodies that alone took longer than CONTROL_TICK_US
+  unsigned long lastUs;           // Duration of the last tick body
+  unsigned long worstUs;          // Longest tick body seen
+  unsigned long worstLatenessUs;  // Longest delay from release to start
+};
+
+extern ControlTickStats controlTickStats;
+
+// ---------- Setup & Loop ----------
+void setupScheduler(TaskFunction controlTick);
+bool addSchedulerTask(const char* name, TaskFunction run, unsigned long periodUs, uint8_t priority);
+bool runScheduler();                 // Call from loop(); never blocks. false = nothing was due
+
+// ---------- Control Rate ----------
+void setControlTickPeriod(unsigned long periodUs);   // From the next release on
+unsigned long getControlTickPeriod();
+void releaseControlTick();           // Next pass runs the tick, then back on the grid
+unsigned long getSchedulerNextDueUs();   // micros() at which the tick or a task is next due
+
+// ---------- Statistics ----------
+void printSchedulerStats();
+void resetSchedulerStats();
+
+#endif
@@ -0,0 +1,142 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                 SerialConsole.cpp - Shadow-RC System               ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ A tiny command line on the USB port for checking and tuning the   ║
+  ║ droid while it runs. Reading it never blocks the control tick.    ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - The "console" background task reads whatever bytes have arrived
+    (never waits), collects them into a line, and on Enter looks the
+    first word up in the command table.
+  - Subsystems register commands from `setup()` with
+    `addConsoleCommand("name", handler, F("help text"))`. The help
+    text stays in flash. The handler gets the rest of the line as its
+    argument string.
+  - `help` is built in. Like the `stats` report, it prints one line
+    per pass and only when the USB TX buffer is empty.
+  - Set the Serial Monitor to send a newline (or CR) at 115200 baud.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `SerialConsole.cpp`
+  Header:    `SerialConsole.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "SerialConsole.h"
+#include "Profiler.h"
+#include "LatencyTrace.h"
+#include "Startup.h"
+#include "TuningStore.h"
+#include <Arduino.h>
+
+struct ConsoleCommand {
+  const char*                name;
+  ConsoleHandler             handler;
+  const __FlashStringHelper* help;
+};
+
+static ConsoleCommand commands[CONSOLE_MAX_COMMANDS];
+static uint8_t commandCount = 0;
+
+static char    line[CONSOLE_LINE_LENGTH + 1];
+static uint8_t lineLength = 0;
+static bool    lineOverflow = false;
+
+#define HELP_IDLE  0xFF
+static uint8_t helpRow = HELP_IDLE;
+
+// ==========================
+//       REGISTRATION
+// ==========================
+bool addConsoleCommand(const char* name, ConsoleHandler handler, const __FlashStringHelper* help) {
+  if (commandCount >= CONSOLE_MAX_COMMANDS) {
+    Serial.print(F("[CONSOLE] Command table full, dropped: "));
+    Serial.println(name);
+    return false;
+  }
+  commands[commandCount].name    = name;
+  commands[commandCount].handler = handler;
+  commands[commandCount].help    = help;
+  commandCount++;
+  return true;
+}
+
+// ==========================
+//         DISPATCH
+// ==========================
+static void runLine(char* text) {
+  while (*text == ' ') text++;
+  if (*text == '\0') return;
+
+  char* args = text;
+  while (*args && *args != ' ') args++;
+  if (*args) *args++ = '\0';
+  while (*args == ' ') args++;
+
+  if (strcmp(text, "help") == 0) {
+    helpRow = 0;
+    return;
+  }
+
+  for (uint8_t i = 0; i < commandCount; i++) {
+    if (strcmp(text, commands[i].name) == 0) {
+      commands[i].handler(args);
+      return;
+    }
+  }
+
+  Serial.print(F("[CONSOLE] Unknown command: "));
+  Serial.println(text);
+}
+
+// One line per pass, only into an empty TX buffer
+static void updateHelp() {
+  if (helpRow == HELP_IDLE) return;
+  if (CONSOLE_PORT.availableForWrite() < SERIAL_TX_BUFFER_SIZE - 1) return;
+
+  if (helpRow == 0) {
+    Serial.println(F("=== Commands ==="));
+  } else if (helpRow <= commandCount) {
+    const ConsoleCommand &c = commands[helpRow - 1];
+    Serial.print(c.name);
+    Serial.print(F(" - "));
+    Serial.println(c.help);
+  } else {
+    helpRow = HELP_IDLE;
+    return;
+  }
+  helpRow++;
+}
+
+// ==========================
+//        CONSOLE TASK
+// ==========================
+void updateSerialConsole() {
+  while (CONSOLE_PORT.available() > 0) {
+    char c = CONSOLE_PORT.read();
+
+    if (c == '\r' || c == '\n') {
+      line[lineLength] = '\0';
+      if (lineOverflow) Serial.println(F("[CONSOLE] Line too long, ignored."));
+      else runLine(line);
+      lineLength = 0;
+      lineOverflow = false;
+    } else if (lineLength < CONSOLE_LINE_LENGTH) {
+      line[lineLength++] = c;
+    } else {
+      lineOverflow = true;
+    }
+  }
+
+  updateHelp();
+  updateProfilerReport();
+  updateLatencyReport();
+  updateStartupLog();
+  updateTuningStore();
+}
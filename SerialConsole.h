@@ -0,0 +1,30 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                 SerialConsole.h - Shadow-RC                ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the USB serial command line.                    ║
+  ║ Type a command + Enter in the Serial Monitor; `help`       ║
+  ║ lists everything registered.                               ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are changing how commands are read. ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef SERIAL_CONSOLE_H
+#define SERIAL_CONSOLE_H
+
+#include <Arduino.h>
+
+#define CONSOLE_PORT          Serial
+#define CONSOLE_MAX_COMMANDS  12
+#define CONSOLE_LINE_LENGTH   40     // Longest command line accepted
+#define CONSOLE_TASK_US       10000  // Input poll + paced output
+
+typedef void (*ConsoleHandler)(const char* args);  // args = text after the command name
+
+// ---------- Setup & Loop ----------
+// help stays in flash: pass it as F("...")
+bool addConsoleCommand(const char* name, ConsoleHandler handler, const __FlashStringHelper* help);
+void updateSerialConsole();          // Background task; never blocks
+
+#endif
@@ -0,0 +1,205 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                    SerialTx.cpp - Shadow-RC System                 ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ One output path for everything that is not a motor packet. A       ║
+  ║ MarcDuino command or a debug line used to go straight to           ║
+  ║ `print()`, which waits whenever the UART's 63-byte TX buffer is    ║
+  ║ full: Hybrid's dome move lines alone stretched a tick past 6 ms.   ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - One queue per port, sized for its device (SerialTx.h). A message
+    is stored as its length byte + its bytes, so it is queued whole or
+    not at all and always leaves in one piece: a MarcDuino never sees
+    half a ":SE03\r" followed by somebody else's bytes.
+  - `txSend()` writes straight to the UART when nothing is waiting
+    and the message fits in the TX buffer right now, so the latency of
+    a short command does not change. Otherwise it is queued.
+  - Full queue: show commands are dropped and counted (a repeat of the
+    last command still waiting is coalesced instead); debug lines are
+    dropped and counted. Nothing ever waits for the UART.
+  - The "tx" task runs every 1 ms at high priority: `updateMotorBus()`
+    first (Serial2 stop packets, then commands and keepalives), then
+    `updateSerialTx()` sends every whole message that fits, show ports
+    before USB. So safety > motor > show > debug.
+  - `usbLog` is a Print: `usbLog.println(...)` replaces
+    `Serial.println(...)` in the mode loops, the combo / MP3 tasks and
+    the dome + drive code. Console replies and the stats report keep
+    plain `Serial`: they run on request and wait for an empty buffer.
+  - A port that stops draining only fills its own queue; the other
+    ports and the motor bus keep going.
+
+  STATISTICS:
+  ─────────────────────────────────────────────────────────────────────
+  `stats` shows, per port, the messages that had to wait and the ones
+  dropped, plus the coalesced ("merged") show commands. `reset`
+  clears them.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `SerialTx.cpp`
+  Header:    `SerialTx.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "SerialTx.h"
+#include <Arduino.h>
+
+#if (TX_USB_QUEUE_BYTES & (TX_USB_QUEUE_BYTES - 1)) || \
+    (TX_SERIAL1_QUEUE_BYTES & (TX_SERIAL1_QUEUE_BYTES - 1)) || \
+    (TX_SERIAL3_QUEUE_BYTES & (TX_SERIAL3_QUEUE_BYTES - 1))
+#error "TX queue sizes must be powers of 2"
+#endif
+
+struct TxQueue {
+  HardwareSerial* uart;
+  uint8_t*        buf;
+  uint16_t        mask;
+  uint16_t        head;       // Next byte to fill
+  uint16_t        tail;       // Length byte of the next message to send
+  uint16_t        last;       // Length byte of the newest queued message
+  bool            hasLast;    // ...and it has not been sent yet
+};
+
+static uint8_t usbQueue[TX_USB_QUEUE_BYTES];
+static uint8_t serial1Queue[TX_SERIAL1_QUEUE_BYTES];
+static uint8_t serial3Queue[TX_SERIAL3_QUEUE_BYTES];
+
+static TxQueue queues[TX_PORT_COUNT] = {
+  { &Serial,  usbQueue,     TX_USB_QUEUE_BYTES - 1,     0, 0, 0, false },
+  { &Serial1, serial1Queue, TX_SERIAL1_QUEUE_BYTES - 1, 0, 0, 0, false },
+  { &Serial3, serial3Queue, TX_SERIAL3_QUEUE_BYTES - 1, 0, 0, 0, false },
+};
+
+TxPortStats txStats[TX_PORT_COUNT];
+TxLinePrint usbLog(TX_PORT_USB);
+
+// ==========================
+//        SETUP
+// ==========================
+void setupSerialTx() {
+  for (uint8_t i = 0; i < TX_PORT_COUNT; i++) {
+    queues[i].head = queues[i].tail = 0;
+    queues[i].hasLast = false;
+  }
+  resetSerialTxStats();
+}
+
+// ==========================
+//          QUEUE
+// ==========================
+static uint16_t queueUsed(const TxQueue &q) {
+  return (q.head - q.tail) & q.mask;
+}
+
+static bool isLastQueued(const TxQueue &q, const uint8_t* data, uint8_t length) {
+  if (!q.hasLast || q.buf[q.last] != length) return false;
+  for (uint8_t i = 0; i < length; i++) {
+    if (q.buf[(q.last + 1 + i) & q.mask] != data[i]) return false;
+  }
+  return true;
+}
+
+bool txSend(uint8_t port, const uint8_t* data, uint8_t length, uint8_t txClass) {
+  if (port >= TX_PORT_COUNT) return false;
+  TxQueue &q = queues[port];
+  TxPortStats &s = txStats[port];
+  if (length == 0) return true;
+  if (length > TX_MESSAGE_MAX) {
+    s.dropped++;
+    return false;
+  }
+
+  // Nothing waiting and room in the UART: no reason to queue
+  if (q.head == q.tail && q.uart->availableForWrite() >= length) {
+    q.uart->write(data, length);
+    s.sent++;
+    return true;
+  }
+
+  if (txClass == TX_CLASS_SHOW && isLastQueued(q, data, length)) {
+    s.coalesced++;
+    return true;
+  }
+  if (queueUsed(q) + length + 1 > q.mask) {    // One byte stays free: head == tail is empty
+    s.dropped++;
+    return false;
+  }
+
+  q.last = q.head;
+  q.hasLast = true;
+  q.buf[q.head] = length;
+  q.head = (q.head + 1) & q.mask;
+  for (uint8_t i = 0; i < length; i++) {
+    q.buf[q.head] = data[i];
+    q.head = (q.head + 1) & q.mask;
+  }
+
+  s.queued++;
+  uint16_t depth = queueUsed(q);
+  if (depth > s.worstBytes) s.worstBytes = depth;
+  return true;
+}
+
+bool txSend(uint8_t port, const char* text, uint8_t txClass) {
+  size_t length = strlen(text);
+  if (length > TX_MESSAGE_MAX) length = TX_MESSAGE_MAX + 1;   // Counted as dropped
+  return txSend(port, (const uint8_t*)text, (uint8_t)length, txClass);
+}
+
+int txRoom(uint8_t port) {
+  if (port >= TX_PORT_COUNT) return 0;
+  const TxQueue &q = queues[port];
+  return q.head == q.tail ? q.uart->availableForWrite() : 0;
+}
+
+// ==========================
+//      BACKGROUND TASK
+// ==========================
+// Whole messages only, while the UART has room for the next one
+static void drainQueue(uint8_t port) {
+  TxQueue &q = queues[port];
+  while (q.head != q.tail) {
+    uint8_t length = q.buf[q.tail];
+    if (q.uart->availableForWrite() < length) return;
+
+    if (q.hasLast && q.tail == q.last) q.hasLast = false;
+    uint16_t i = (q.tail + 1) & q.mask;
+    for (uint8_t n = 0; n < length; n++) {
+      q.uart->write(q.buf[i]);
+      i = (i + 1) & q.mask;
+    }
+    q.tail = i;
+    txStats[port].sent++;
+  }
+}
+
+void updateSerialTx() {
+  drainQueue(TX_PORT_SERIAL3);   // Show commands first
+  drainQueue(TX_PORT_SERIAL1);
+  drainQueue(TX_PORT_USB);       // Debug text last
+}
+
+// ==========================
+//       DEBUG TEXT
+// ==========================
+// Longer lines than TX_MESSAGE_MAX go out in TX_MESSAGE_MAX pieces
+size_t TxLinePrint::write(uint8_t c) {
+  _line[_length++] = c;
+  if (c == '\n' || _length == TX_MESSAGE_MAX) {
+    txSend(_port, _line, _length, TX_CLASS_DEBUG);
+    _length = 0;
+  }
+  return 1;
+}
+
+// ==========================
+//        STATISTICS
+// ==========================
+void resetSerialTxStats() {
+  memset(txStats, 0, sizeof(txStats));
+}
@@ -0,0 +1,84 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                   SerialTx.h - Shadow-RC                   ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the non-blocking output queues on USB, Serial1  ║
+  ║ and Serial3. Whole messages go in or nothing does; the     ║
+  ║ "tx" task sends them as the UARTs drain.                   ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless a device moves to another port.         ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef SERIAL_TX_H
+#define SERIAL_TX_H
+
+#include <Arduino.h>
+
+// ---------- Queue Sizes (bytes, powers of 2) ----------
+// Each queued message costs its length + 1.
+#define TX_USB_QUEUE_BYTES      256    // Debug lines, ~6 at 40 characters
+#define TX_SERIAL1_QUEUE_BYTES  32     // MP3 Trigger (+ MarcDuino with MARCDUINO_SETUP 1)
+#define TX_SERIAL3_QUEUE_BYTES  64     // MarcDuino: ~9 ":SExx\r" commands
+#define TX_MESSAGE_MAX          63     // Longest message; must fit an empty UART TX buffer
+
+enum TxPort {
+  TX_PORT_USB = 0,         // Serial: console + debug text
+  TX_PORT_SERIAL1,         // MP3 Trigger / MarcDuino
+  TX_PORT_SERIAL3,         // MarcDuino (MARCDUINO_SETUP 2)
+  TX_PORT_COUNT
+};
+
+// Send order of the "tx" task, and what happens when a queue is full.
+// Serial2 is not queued here: MotorBus already sends stop packets
+// (safety) ahead of changed values and keepalives (motor).
+enum TxClass {
+  TX_CLASS_SAFETY = 0,     // Serial2 stop packets (MotorBus)
+  TX_CLASS_MOTOR,          // Serial2 commands + keepalives (MotorBus)
+  TX_CLASS_SHOW,           // MarcDuino / MP3 commands: a repeat of the last queued one is coalesced
+  TX_CLASS_DEBUG,          // USB text: dropped when it does not fit
+  TX_CLASS_COUNT
+};
+
+struct TxPortStats {
+  unsigned long sent;      // Messages written to the UART
+  unsigned long queued;    // ...of which had to wait for room
+  unsigned long coalesced; // Show commands already waiting in the queue
+  unsigned long dropped;   // Messages that did not fit
+  uint16_t      worstBytes;// Deepest the queue got
+};
+
+extern TxPortStats txStats[TX_PORT_COUNT];
+
+// ---------- Setup & Loop ----------
+void setupSerialTx();
+void updateSerialTx();         // "tx" task, after updateMotorBus(): show ports, then USB
+
+// ---------- Sending ----------
+// Straight to the UART when nothing is waiting and it fits, else queued
+// whole. false = dropped (queue full or longer than TX_MESSAGE_MAX).
+bool txSend(uint8_t port, const uint8_t* data, uint8_t length, uint8_t txClass);
+bool txSend(uint8_t port, const char* text, uint8_t txClass);
+int  txRoom(uint8_t port);     // Bytes a direct write can take now without jumping the queue
+
+// ---------- Debug Text ----------
+// Drop-in for `Serial.print()` on the hot paths: collects a line and
+// queues it whole at '\n' as TX_CLASS_DEBUG. Never blocks.
+class TxLinePrint : public Print {
+public:
+  explicit TxLinePrint(uint8_t port) : _port(port), _length(0) {}
+  size_t write(uint8_t c);
+  using Print::write;
+
+private:
+  uint8_t _port;
+  uint8_t _length;
+  uint8_t _line[TX_MESSAGE_MAX];
+};
+
+extern TxLinePrint usbLog;
+
+// ---------- Statistics ----------
+void resetSerialTxStats();
+
+#endif
@@ -24,6 +24,23 @@
     - ComboHandler: Detects joystick + button combinations
     - MP3Handler: Plays randomized or triggered sounds
     - PWMInputHandler: Maps RC receiver input to usable values
+    - Scheduler: Fixed-rate control tick + prioritized background tasks
+    - MotorBus: Change-only + keepalive packets on the shared Serial2 line
+    - DriveController: One stick pipeline, one profile per drive mode
+    - Telemetry: Binary drive records on USB serial (never blocks)
+    - FixedPoint: Integer-only stick shaping (no soft-float in the tick)
+    - Profiler: micros() probe per subsystem + fault counters
+    - SerialConsole: USB command line (`help`, `stats`, `reset`, `cal`, `tune`)
+    - LatencyTrace: Receiver edge → output write latency (optional)
+    - InputTrace: Raw channel + encoder recording for host replay
+    - DomePosition: Encoder-based closed-loop dome angle control
+    - Failsafe: Watchdog fed by the control tick; a reset boot stops the motors first
+    - Startup: Boot timeline; drivers + MP3 board finish after setup()
+    - SerialTx: Whole-message queues for USB, Serial1 and Serial3 (never blocks)
+    - IdleGovernor: Parked droid → slow tick, fewer keepalives, AVR idle sleep
+    - DebugLog: Compile-time log level per subsystem, text kept in flash
+    - MemoryReport: Free SRAM + stack peak in `stats` (stack painted at boot)
+    - TuningStore: Stick calibration + live profile tuning, kept in EEPROM
 
   FEATURES:
   ────────────────────────────────────────────────────────────────────
@@ -44,22 +61,58 @@
   STRUCTURE:
   ────────────────────────────────────────────────────────────────────
   On startup:
-    - Initializes all subsystems
-    - Plays startup sound (if no MarcDuino)
-    - Enters last used control mode
-
-  In loop():
-    - Processes combo inputs
-    - Updates MP3 system
-    - Handles control mode changes
-    - Calls the active mode’s loop
-    - Blinks LED to reflect current mode
+    - Initializes all subsystems without waiting on any of them
+    - Enters last used control mode; the control tick runs at once
+    - In the background: motor drivers synced (1.5 s after power-on),
+      MP3 board booted, then the startup sound (if no MarcDuino)
+
+  In loop(), the scheduler runs:
+    - Control tick (every 5 ms, always first):
+        • Captures one InputFrame of every RC channel
+        • Applies a pending mode change (profile swap, same tick)
+        • Calls the active mode’s loop (shape → motor commands)
+        • Queues whatever motor packets fit on Serial2
+        • Records a telemetry frame (every TELEMETRY_DECIMATION ticks)
+        • Idle governor: parked after IDLE_ENTER_MS of centred sticks
+          → 20 ms ticks + sleep until the next task; a moved pulse
+          brings the 5 ms tick back at once
+    - Background tasks (by priority, one per pass):
+        • TX: motor bus, show cmds, debug text  (high)
+        • Combo inputs                          (high)
+        • MP3 triggers                          (normal)
+        • Telemetry drain when USB TX has room  (low)
+        • LED mode blinks + optional stats      (low)
+        • USB console commands                  (low)
 
   DEBUGGING TOOLS:
   ────────────────────────────────────────────────────────────────────
-  - Serial output for all mode changes and kill switch events
+  - Serial output for all mode changes and kill switch events, queued
+    and sent as USB drains (`stats` counts lines dropped under load)
   - Mode LED for quick visual confirmation (1 blink = Manual, etc.)
   - Startup messages identify detected subsystems (MP3, MarcDuino)
+  - Drive / turn / dome values stream as binary telemetry; decode them
+    with `python3 Tools/telemetry_decode.py <port>` (see Telemetry.h)
+  - Set `SCHEDULER_REPORT_MS` to print control-tick overruns and
+    missed deadlines, per-task worst run times and motor bus usage
+  - Type `stats` in the Serial Monitor for min / mean / max time and a
+    histogram per subsystem, plus tick overruns, Serial2 TX-full
+    holds, stale PWM frames and dropped telemetry (`reset` clears)
+  - Set `LATENCY_TRACE` (LatencyTrace.h) and type `latency` for
+    receiver-edge → Serial1 / Serial2 write percentiles, with
+    optional GPIO marks for a scope or logic analyzer
+  - No droid handy: `make bench` in `Tools/HostSim` runs this sketch on
+    a desktop against simulated receivers, motor drivers and MP3 board
+  - Type `trace on` to stream every RC channel change + encoder count
+    (InputTrace.h); `host_bench --replay` plays the recording back
+  - Every boot prints its reset cause; `stats` shows the watchdog,
+    brown-out and external reset counts kept in EEPROM
+  - `[BOOT]` lines time each startup step, power-on → first motor
+    command included (Startup.h)
+  - Type `cal start` to measure each stick's real min / centre / max
+    and `tune` to change the active profile without a reflash; both
+    are saved in EEPROM (TuningStore.h)
+  - Set `FIXED_POINT_BENCHMARK` (FixedPoint.h) to print the cycle cost
+    of the old float shaping path vs the fixed-point one at boot
 
   FILE LOCATION:
   ────────────────────────────────────────────────────────────────────
@@ -71,6 +124,10 @@
   - Be sure all pins are assigned properly in your PWM handler.
   - Confirm that Serial1 (TX1) is wired to MP3 trigger or MarcDuino.
   - Sabertooth + SyRen must share Serial2 (TX2) with sync byte on boot.
+    The motor bus sends it once at startup (see MotorBus.h for the
+    optional 38400/115200 baud upgrade).
+  - Carpet Mode traction control needs the 2x32's S2 wired to RX2 and
+    `MOTOR_FEEDBACK_POLL_MS` set in MotorBus.h; off, nothing is read back.
 
   May the Force be with you, Builder.
   ╚═══════════════════════════════════════════════════════════════════╝
@@ -84,7 +141,24 @@
 
 #include "ComboHandler.h"
 #include "PWMInputHandler.h"
+#include "ReceiverHandler.h"
 #include "MP3Handler.h"
+#include "Scheduler.h"
+#include "MotorBus.h"
+#include "DriveController.h"
+#include "Telemetry.h"
+#include "FixedPoint.h"
+#include "Profiler.h"
+#include "SerialConsole.h"
+#include "LatencyTrace.h"
+#include "InputTrace.h"
+#include "DomePosition.h"
+#include "Failsafe.h"
+#include "Startup.h"
+#include "SerialTx.h"
+#include "DebugLog.h"
+#include "IdleGovernor.h"
+#include "TuningStore.h"
 
 // =========================================
 // === MODE ENUMERATION ====================
@@ -103,6 +177,29 @@ enum Mode {
 // 1 blink = Manual, 2 = Automated, 3 = Hybrid, 4 = Carpet
 #define MODE_STATUS_LED LED_BUILTIN  // Usually pin 13 on Arduino Mega
 
+// =========================================
+// === SCHEDULER SETTINGS ==================
+// =========================================
+#define SCHEDULER_REPORT_MS   0      // > 0 prints scheduler + motor bus stats this often (ms)
+#define TX_TASK_US            1000   // Next Serial2 packet, then queued MarcDuino / MP3 / debug output
+#define COMBO_TASK_US         10000  // Combo detection + mode changes
+#define LED_TASK_US           10000  // Mode LED blink pattern
+
+// Scheduler entry points (defined below loop())
+void controlTick();
+void txTask();
+void comboTask();
+void applyModeChange();
+void ledTask();
+void mp3Task();
+void playStartupSound();
+void telemetryTask();
+void reportTask();
+void statsCommand(const char* args);
+void resetCommand(const char* args);
+void latencyCommand(const char* args);
+void traceCommand(const char* args);
+
 // =========================================
 // === LED BLINK STATE (Non-blocking) ======
 // =========================================
@@ -142,27 +239,30 @@ void updateLEDPattern(int mode) {
 // =========================================
 void setup() {
   Serial.begin(115200);
-  Serial.println("=== R2-D2 Control Master File ===");
-
-  Serial1.begin(9600);  // Serial1 = Sabertooth & SyRen shared TX
+  setupSerialTx();        // Queues for USB debug text, Serial1 and Serial3
+  setupFailsafe();        // First: stop packets if the drivers kept power through a reset
+  Serial.println(F("=== R2-D2 Control Master File ==="));
 
+  checkInputPins();       // Reports a pin moved to one without its interrupt
   setupPWMInputs();
+  // Serial2 sync / baud upgrade in the background, then change-only packet
+  // scheduling. Only a watchdog reset is sure the drivers kept power.
+  setupMotorBus(failsafeStats.resetCause == RESET_WATCHDOG ? 0 : MOTOR_BUS_DRIVER_BOOT_MS);
+  setupDomePosition();    // Encoder on pins 19 / 20 counts in every mode
   setupComboHandler();
-  setupMP3Handler();
+  setupMP3Handler();      // Board boots in the background; the mp3 task plays track 255
+  setupTelemetry();
+  setupLatencyTrace();
 
   pinMode(MODE_STATUS_LED, OUTPUT);
   digitalWrite(MODE_STATUS_LED, LOW);
 
-  delay(1500);  // Let everything initialize
-
-  // === Play startup sound (if no MarcDuino is present) ===
-#if !MARCDUINO_ENABLED
-  Serial.println(">> No MarcDuino detected — playing startup sound (track 255).");
-  mp3.trigger(255);  
-#else
-  Serial.println(">> MarcDuino enabled — skipping manual startup sound.");
+#if FIXED_POINT_BENCHMARK
+  benchmarkFixedPoint();
 #endif
 
+  setupTuningStore();     // Saved calibration + tuning, before a profile is selected
+
   // === Initialize current mode ===
   switch (currentMode) {
     case MANUAL_MODE:     setupManualMode();     break;
@@ -173,65 +273,198 @@ void setup() {
 
   currentBlinkTotal = currentMode;
   lastMode = currentMode;
+
+  // === Scheduler: control tick first, then background tasks ===
+  addSchedulerTask("tx",     txTask,    TX_TASK_US,    TASK_PRIORITY_HIGH);
+  addSchedulerTask("combos", comboTask, COMBO_TASK_US, TASK_PRIORITY_HIGH);
+  addSchedulerTask("mp3",    mp3Task,   DEBOUNCE_DELAY * 1000UL, TASK_PRIORITY_NORMAL);
+  addSchedulerTask("telemetry", telemetryTask, TELEMETRY_TASK_US, TASK_PRIORITY_LOW);
+  addSchedulerTask("led",    ledTask,   LED_TASK_US,   TASK_PRIORITY_LOW);
+  addSchedulerTask("console", updateSerialConsole, CONSOLE_TASK_US, TASK_PRIORITY_LOW);
+#if SCHEDULER_REPORT_MS > 0
+  addSchedulerTask("stats",  reportTask, SCHEDULER_REPORT_MS * 1000UL, TASK_PRIORITY_LOW);
+#endif
+  setupScheduler(controlTick);
+
+  // === USB console: type `help` in the Serial Monitor ===
+  addConsoleCommand("stats", statsCommand, F("Subsystem timing + fault counters"));
+  addConsoleCommand("reset", resetCommand, F("Clear counters (`reset resets`: boot counts)"));
+  addConsoleCommand("trace", traceCommand, F("on/off: record inputs for replay"));
+  addConsoleCommand("cal",   calCommand,   F("start/save/abort/reset: stick calibration"));
+  addConsoleCommand("tune",  tuneCommand,  F("<name> <value>, save, defaults: live tuning"));
+#if LATENCY_TRACE
+  addConsoleCommand("latency", latencyCommand, F("Input > output latency percentiles"));
+#endif
+  resetProfilerStats();
+  armFailsafe();          // Watchdog on: from here only the control tick feeds it
+  markStartupStep(STARTUP_SETUP);  // Motor bus and MP3 board finish in the background
 }
 
 // =========================================
 // === MAIN LOOP ===========================
 // =========================================
 void loop() {
+  pollIdleWake();                 // Parked and a pulse moved: full rate, tick now
+  if (!runScheduler()) {          // Control tick when due, then one background task
+    idleSleep();                  // Parked and nothing due: sleep until it is
+  }
+}
+
+// =========================================
+// === CONTROL TICK (every 5 ms) ===========
+// =========================================
+void controlTick() {
+  unsigned long tickStart = probeStart();
+
+  unsigned long t = probeStart();
+  updateInputFrame();     // Snapshot every RC channel once per tick
+  probeEnd(PROBE_INPUT_FRAME, t);
+  countStaleInputs();
+  recordInputTrace();     // Changed channels → telemetry ring while `trace on`
+
+  if (currentMode != lastMode) applyModeChange();  // New profile runs this same tick
+
+  beginMotorLatency();    // Latency trace: note each slot before the mode runs
+  t = probeStart();
+  switch (currentMode) {
+    case MANUAL_MODE:     loopManualMode();     break;
+    case CARPET_MODE:      loopCarpetMode();      break;
+    case HYBRID_MODE:     loopHybridMode();     break;
+    case AUTOMATED_MODE:  loopAutomatedMode();  break;
+  }
+  probeEnd(PROBE_MODE_LOOP, t);
+  tagMotorLatency();      // ...and tag slots a fresh stick edge just changed
+
+  t = probeStart();
+  updateMotorBus();       // Send changed values / keepalives that fit right now
+  probeEnd(PROBE_MOTOR_BUS, t);
+
+  recordTelemetryTick();  // Ring buffer only; the "telemetry" task drains it
+  updateIdleGovernor();   // Park / unpark for the next release
+  probeEnd(PROBE_CONTROL_TICK, tickStart);
+  feedFailsafe();         // The only watchdog feed: a stalled tick resets the Mega
+}
+
+// =========================================
+// === BACKGROUND TASKS ====================
+// =========================================
+// Every UART in priority order: Serial2 stop packets, motor commands and
+// keepalives (MotorBus), then MarcDuino / MP3 commands, then debug text.
+// An iBUS / SBUS stream is drained here too: parked, the control tick is
+// 20 ms apart and the 64-byte RX buffer fills in ~5.
+void txTask() {
+#if RC_INPUT_BACKEND == RC_INPUT_IBUS || RC_INPUT_BACKEND == RC_INPUT_SBUS
+  updateReceiverHandler();
+#endif
+  updateMotorBus();
+  updateSerialTx();
+}
+
+void comboTask() {
+  unsigned long t = probeStart();
   updateComboHandler();   // Detect joystick+button combos
-  updateMP3Handler();     // Process MP3 triggers (if enabled)
+  probeEnd(PROBE_COMBO, t);
+}
 
-  // === Mode Transition Handling ===
-  if (currentMode != lastMode) {
-    delay(1500);  // Allow systems to stabilize
+void mp3Task() {
+  unsigned long t = probeStart();
+  updateMP3Handler();     // CH3–CH6 sound / show triggers
+  if (isMP3Ready() && !isStartupStepDone(STARTUP_SOUND)) playStartupSound();
+  probeEnd(PROBE_MP3, t);
+}
 
-    switch (currentMode) {
-      case MANUAL_MODE:
-        Serial.println("==> Switching to MANUAL MODE");
-        setupManualMode();
-#ifndef DISABLE_MP3
-        mp3.trigger(231);  
+// Once, as soon as the MP3 board has booted. Runs in a task: the
+// "[BOOT] startup sound" line is the log, no print here.
+void playStartupSound() {
+#if !MARCDUINO_ENABLED
+  playMP3(255, MP3_PRIORITY_MODE);  // No MarcDuino: the startup sound is ours to play
 #endif
-        break;
+  markStartupStep(STARTUP_SOUND);
+}
 
-      case CARPET_MODE:
-        Serial.println("==> Switching to CARPET MODE");
-        setupCarpetMode();
+void ledTask() {
+  unsigned long t = probeStart();
+  updateLEDPattern(currentMode);  // Visual mode feedback
+  probeEnd(PROBE_LED, t);
+}
+
+void telemetryTask() {
+  unsigned long t = probeStart();
+  updateTelemetry();      // Drain whole frames that fit in USB TX
+  probeEnd(PROBE_TELEMETRY, t);
+}
+
+void reportTask() {
+  printSchedulerStats();
+  printMotorBusStats();
+}
+
+// === Console Commands ===
+void statsCommand(const char*) {
+  startProfilerReport();  // Printed a row at a time by the "console" task
+}
+
+void resetCommand(const char* args) {
+  resetProfilerStats();
+  resetLatencyStats();
+  if (!strcmp(args, "resets")) clearResetCounters();   // EEPROM, survives power-off
+  Serial.println(F("[STATS] Counters cleared."));
+}
+
+void latencyCommand(const char*) {
+  startLatencyReport();   // Printed a row at a time by the "console" task
+}
+
+void traceCommand(const char* args) {
+  if (!strcmp(args, "on"))       startInputTrace();
+  else if (!strcmp(args, "off")) stopInputTrace();
+  else Serial.println(isInputTraceActive() ? F("[TRACE] Recording.") : F("[TRACE] Off."));
+}
+
+// === Mode Transition Handling ===
+// Runs inside the control tick. Drive modes only swap their DriveController
+// profile (stop packets first, each axis held until its stick is centred);
+// Serial2, the inputs and every curve table are already set up.
+void applyModeChange() {
+  logTelemetryEvent(TELEMETRY_EVENT_MODE, currentMode);
+  stopDome();             // A dome move from the old mode ends here
+  if (currentMode == AUTOMATED_MODE) selectDriveProfile(NULL);  // Stops drive + dome
+
+  switch (currentMode) {
+    case MANUAL_MODE:
+      LOG_LINE(MODE, LOG_INFO, "==> Switching to MANUAL MODE");
+      setupManualMode();
 #ifndef DISABLE_MP3
-        mp3.trigger(232);  
+      playMP3(231, MP3_PRIORITY_MODE);  // Cuts any sound short
 #endif
-        break;
+      break;
 
-      case HYBRID_MODE:
-        Serial.println("==> Switching to HYBRID MODE");
-        setupHybridMode();
+    case CARPET_MODE:
+      LOG_LINE(MODE, LOG_INFO, "==> Switching to CARPET MODE");
+      setupCarpetMode();
 #ifndef DISABLE_MP3
-        mp3.trigger(233);  
+      playMP3(232, MP3_PRIORITY_MODE);  // Cuts any sound short
 #endif
-        break;
+      break;
 
-      case AUTOMATED_MODE:
-        Serial.println("==> Switching to AUTOMATED MODE");
-        setupAutomatedMode();
+    case HYBRID_MODE:
+      LOG_LINE(MODE, LOG_INFO, "==> Switching to HYBRID MODE");
+      setupHybridMode();
 #ifndef DISABLE_MP3
-        mp3.trigger(234);  
+      playMP3(233, MP3_PRIORITY_MODE);  // Cuts any sound short
 #endif
-        break;
-    }
-
-    currentBlinkTotal = currentMode;  // Update blink count
-    blinkCount = currentBlinkTotal;   // Force pause before next cycle
-    lastMode = currentMode;
-  }
+      break;
 
-  // === Call Active Mode Logic ===
-  switch (currentMode) {
-    case MANUAL_MODE:     loopManualMode();     break;
-    case CARPET_MODE:      loopCarpetMode();      break;
-    case HYBRID_MODE:     loopHybridMode();     break;
-    case AUTOMATED_MODE:  loopAutomatedMode();  break;
+    case AUTOMATED_MODE:
+      LOG_LINE(MODE, LOG_INFO, "==> Switching to AUTOMATED MODE");
+      setupAutomatedMode();
+#ifndef DISABLE_MP3
+      playMP3(234, MP3_PRIORITY_MODE);  // Cuts any sound short
+#endif
+      break;
   }
 
-  updateLEDPattern(currentMode);  // Visual mode feedback
+  currentBlinkTotal = currentMode;  // Update blink count
+  blinkCount = currentBlinkTotal;   // Force pause before next cycle
+  lastMode = currentMode;
 }
@@ -0,0 +1,124 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                    Startup.cpp - Shadow-RC System                  ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Records when each part of the droid finished booting. setup() used ║
+  ║ to sit in `delay()` for ~2.5 s (MP3 board, then "let everything    ║
+  ║ initialize") before the first motor packet; now it returns as soon ║
+  ║ as the inputs and modes are set up and the slow parts catch up.    ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - Nothing here waits. Each subsystem runs its own `millis()` state
+    and calls `markStartupStep()` when it is done:
+      setup        end of setup() (.ino)
+      motor bus    drivers synced, after `MOTOR_BUS_DRIVER_BOOT_MS` on
+                   a power-on (MotorBus.cpp)
+      first cmd    first motor packet queued (MotorBus.cpp)
+      mp3          `MP3_BOARD_BOOT_MS` after Serial1 opened
+                   (MP3Handler.cpp); triggers are held until then
+      sound        track 255 sent, or skipped with a MarcDuino (.ino)
+  - The first mark of a step counts; later calls are ignored, so a
+    re-run (a mode change, a reset command) does not move the time.
+  - Marking only stores the time. The "console" task prints one
+    `[BOOT] <step> at N ms` line per pass, only when the USB TX buffer
+    is empty, so the log never holds up the control tick; once every
+    step is out one line sums up power-on → first motor command.
+
+  TIMES:
+  ─────────────────────────────────────────────────────────────────────
+  `millis()` since the sketch started. The bootloader's own wait
+  before that is not counted. After a watchdog reset the drivers are
+  known to have kept power, so the bus skips the driver wait.
+
+  READ BACK:
+  ─────────────────────────────────────────────────────────────────────
+  `stats` shows the bus, first command and MP3 times ("-" = pending).
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `Startup.cpp`
+  Header:    `Startup.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "Startup.h"
+#include <Arduino.h>
+
+StartupStats startupStats;
+
+static const char stepSetup[]        PROGMEM = "setup";
+static const char stepMotorBus[]     PROGMEM = "motor bus";
+static const char stepFirstCommand[] PROGMEM = "first motor command";
+static const char stepMp3Board[]     PROGMEM = "mp3 board";
+static const char stepSound[]        PROGMEM = "startup sound";
+
+static const char* const stepNames[STARTUP_STEP_COUNT] PROGMEM = {
+  stepSetup, stepMotorBus, stepFirstCommand, stepMp3Board, stepSound
+};
+
+static const uint8_t ALL_STEPS = (1 << STARTUP_STEP_COUNT) - 1;
+
+static uint8_t loggedMask = 0;       // Steps printed so far
+static bool    summaryLogged = false;
+
+// ==========================
+//        BOOT STEPS
+// ==========================
+void markStartupStep(uint8_t step) {
+  if (step >= STARTUP_STEP_COUNT || isStartupStepDone(step)) return;
+
+  startupStats.doneMs[step] = millis();
+  startupStats.doneMask |= (1 << step);
+}
+
+bool isStartupStepDone(uint8_t step) {
+  return step < STARTUP_STEP_COUNT && (startupStats.doneMask & (1 << step));
+}
+
+bool isStartupComplete() {
+  return startupStats.doneMask == ALL_STEPS;
+}
+
+const __FlashStringHelper* startupStepName(uint8_t step) {
+  if (step >= STARTUP_STEP_COUNT) return F("?");
+  return (const __FlashStringHelper*)pgm_read_ptr(&stepNames[step]);
+}
+
+// ==========================
+//   LOG (line at a time)
+// ==========================
+static unsigned long lastDoneMs() {
+  unsigned long last = 0;
+  for (uint8_t i = 0; i < STARTUP_STEP_COUNT; i++) {
+    if (startupStats.doneMs[i] > last) last = startupStats.doneMs[i];
+  }
+  return last;
+}
+
+void updateStartupLog() {
+  if (summaryLogged) return;
+  if (Serial.availableForWrite() < SERIAL_TX_BUFFER_SIZE - 1) return;  // Wait for an empty buffer
+
+  for (uint8_t i = 0; i < STARTUP_STEP_COUNT; i++) {
+    if (!isStartupStepDone(i) || (loggedMask & (1 << i))) continue;
+    Serial.print(F("[BOOT] "));
+    Serial.print(startupStepName(i));
+    Serial.print(F(" at "));
+    Serial.print(startupStats.doneMs[i]);
+    Serial.println(F(" ms"));
+    loggedMask |= (1 << i);
+    return;
+  }
+  if (loggedMask != ALL_STEPS) return;               // Still booting
+
+  Serial.print(F("[BOOT] Drivable at "));
+  Serial.print(startupStats.doneMs[STARTUP_FIRST_COMMAND]);
+  Serial.print(F(" ms, all up at "));
+  Serial.print(lastDoneMs());
+  Serial.println(F(" ms."));
+  summaryLogged = true;
+}
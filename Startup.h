@@ -0,0 +1,42 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                   Startup.h - Shadow-RC                    ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the boot timeline. setup() no longer waits for  ║
+  ║ the drivers or the MP3 board; each finishes in the         ║
+  ║ background and marks its step here with a timestamp.       ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are adding a boot step.             ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <Arduino.h>
+
+// In the order they normally finish
+enum StartupStep {
+  STARTUP_SETUP = 0,       // setup() returned: inputs, modes, scheduler, watchdog live
+  STARTUP_MOTOR_BUS,       // Drivers synced, serial timeouts programmed
+  STARTUP_FIRST_COMMAND,   // First motor packet queued on Serial2: drivable
+  STARTUP_MP3,             // MP3 board finished its own boot
+  STARTUP_SOUND,           // Startup sound (track 255) sent, or skipped
+  STARTUP_STEP_COUNT
+};
+
+struct StartupStats {
+  unsigned long doneMs[STARTUP_STEP_COUNT];   // millis() at each step
+  uint8_t       doneMask;                     // Bit per finished step
+};
+
+extern StartupStats startupStats;
+
+// ---------- Boot Steps ----------
+void markStartupStep(uint8_t step);   // First call per step counts, later ones are ignored
+bool isStartupStepDone(uint8_t step);
+bool isStartupComplete();             // Every step done
+const __FlashStringHelper* startupStepName(uint8_t step);
+void updateStartupLog();              // "console" task: one [BOOT] line when USB TX is empty
+
+#endif
@@ -0,0 +1,199 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                   Telemetry.cpp - Shadow-RC System                 ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Replaces the per-frame "DriveRaw: … | DomeOut: …" debug lines.    ║
+  ║ Those were ~80 characters every 5 ms tick: ~7 ms of wire time at  ║
+  ║ 115200 baud, so `Serial.print()` blocked once the TX buffer       ║
+  ║ filled and stretched every control tick.                          ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - `recordTelemetryTick()` runs at the end of each control tick and
+    keeps every `TELEMETRY_DECIMATION`th one as a 19-byte binary drive
+    frame: time, mapped + output drive / turn / dome, mode, combo and
+    kill / MP3 flags.
+  - With 2x32 feedback on (`MOTOR_FEEDBACK_POLL_MS`), every
+    `TELEMETRY_DRIVER_EVERY`th drive frame is followed by a 22-byte
+    driver frame: battery, motor currents, temperatures, the age of
+    the current reading and Carpet Mode's traction scale and ramp.
+  - `logTelemetryEvent()` adds a short event frame (mode change, kill
+    switch, MP3 triggers blocked) whenever something changes.
+  - Frames are copied into a `TELEMETRY_RING_BYTES` ring buffer. If it
+    is full the new frame is dropped and counted; nothing ever waits.
+  - The "telemetry" background task writes whole frames only while
+    `availableForWrite()` has room for them, so a frame is never split
+    by other console text and the UART never blocks the loop.
+
+  READING IT:
+  ─────────────────────────────────────────────────────────────────────
+  On a computer:  `python3 Tools/telemetry_decode.py /dev/ttyACM0`
+  Prints one line per frame; normal console text passes through.
+  The Arduino Serial Monitor shows the binary frames as noise. Set
+  `TELEMETRY_DECIMATION` to 0 if you only want text there.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `Telemetry.cpp`
+  Header:    `Telemetry.h`
+  Decoder:   `Tools/telemetry_decode.py`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "Telemetry.h"
+#include "DriveController.h"
+#include "MotorBus.h"
+#include "ComboHandler.h"
+#include "MP3Handler.h"
+#include "PWMInputHandler.h"
+#include <Arduino.h>
+
+#define RING_MASK  (TELEMETRY_RING_BYTES - 1)
+
+TelemetryStats telemetryStats;
+
+static uint8_t  ring[TELEMETRY_RING_BYTES];
+static uint16_t ringHead = 0;    // Next byte to fill
+static uint16_t ringTail = 0;    // Next byte to send
+static uint8_t  frameSeq = 0;
+static uint8_t  decimation = TELEMETRY_DECIMATION;
+static uint8_t  driverCount = 0;
+static uint8_t  tickCount = 0;
+
+// ==========================
+//        SETUP
+// ==========================
+void setupTelemetry() {
+  ringHead = ringTail = 0;
+  tickCount = 0;
+  memset(&telemetryStats, 0, sizeof(telemetryStats));
+}
+
+void setTelemetryDecimation(uint8_t everyNthTick) {
+  decimation = everyNthTick;
+  tickCount = 0;
+}
+
+// ==========================
+//       RING BUFFER
+// ==========================
+static uint16_t ringUsed() {
+  return (ringHead - ringTail) & RING_MASK;
+}
+
+static inline void ringPut(uint8_t b, uint8_t &sum) {
+  ring[ringHead] = b;
+  ringHead = (ringHead + 1) & RING_MASK;
+  sum += b;
+}
+
+bool pushTelemetryFrame(uint8_t type, const uint8_t* payload, uint8_t length) {
+  if (length > TELEMETRY_MAX_PAYLOAD) return false;   // Could never drain
+  // One slot stays empty so head == tail always means "empty"
+  if (ringUsed() + length + TELEMETRY_FRAME_BYTES > TELEMETRY_RING_BYTES - 1) {
+    telemetryStats.dropped++;
+    return false;
+  }
+
+  uint8_t sum = 0;
+  ringPut(TELEMETRY_SYNC1, sum);
+  ringPut(TELEMETRY_SYNC2, sum);
+  sum = 0;
+  ringPut(type, sum);
+  ringPut(length, sum);
+  ringPut(frameSeq++, sum);
+  for (uint8_t i = 0; i < length; i++) ringPut(payload[i], sum);
+  uint8_t ignored = 0;
+  ringPut(sum, ignored);
+  return true;
+}
+
+static inline void putU32(uint8_t* p, uint32_t v) {
+  p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static inline void putU16(uint8_t* p, uint16_t v) {
+  p[0] = v; p[1] = v >> 8;
+}
+
+// ==========================
+//        RECORDING
+// ==========================
+static void recordDriverFrame() {
+  unsigned long age = millis() - driveFeedback.currentMs;
+
+  uint8_t p[16];
+  putU32(p, millis());
+  putU16(p + 4, driveFeedback.batteryDv);
+  putU16(p + 6, driveFeedback.currentDa[0]);
+  putU16(p + 8, driveFeedback.currentDa[1]);
+  p[10] = driveFeedback.temperatureC[0];
+  p[11] = driveFeedback.temperatureC[1];
+  putU16(p + 12, isDriveCurrentFresh() ? (uint16_t)age : 0xFFFF);
+  p[14] = (uint8_t)(((long)driveGovernor.scale * 100 + Q8_8_ONE / 2) / Q8_8_ONE);
+  p[15] = driveGovernor.maxStep;
+  pushTelemetryFrame(TELEMETRY_DRIVER, p, sizeof(p));
+}
+
+void recordTelemetryTick() {
+  if (decimation == 0) return;
+  if (++tickCount < decimation) return;
+  tickCount = 0;
+
+  uint8_t flags = 0;
+  if (isDriveKillActive()) flags |= TELEMETRY_FLAG_KILL;
+  if (isMP3Suppressed())   flags |= TELEMETRY_FLAG_MP3_SUPPRESS;
+  if (isMP3Blocked())      flags |= TELEMETRY_FLAG_MP3_BLOCKED;
+  if (inputFrame.linkLost) flags |= TELEMETRY_FLAG_LINK_LOST;
+
+  uint8_t p[13];
+  putU32(p, millis());
+  p[4]  = (int8_t)driveInputs.drive;
+  p[5]  = (int8_t)getMotorPower(MOTOR_SLOT_DRIVE);
+  p[6]  = (int8_t)driveInputs.turn;
+  p[7]  = (int8_t)getMotorPower(MOTOR_SLOT_TURN);
+  p[8]  = (int8_t)driveInputs.dome;
+  p[9]  = (int8_t)getMotorPower(MOTOR_SLOT_DOME);
+  p[10] = (uint8_t)currentMode;
+  p[11] = (uint8_t)currentCombo;
+  p[12] = flags;
+  pushTelemetryFrame(TELEMETRY_DRIVE, p, sizeof(p));
+
+  if (MOTOR_FEEDBACK_POLL_MS > 0 && ++driverCount >= TELEMETRY_DRIVER_EVERY) {
+    driverCount = 0;
+    recordDriverFrame();
+  }
+}
+
+void logTelemetryEvent(uint8_t code, int16_t value) {
+  uint8_t p[7];
+  putU32(p, millis());
+  p[4] = code;
+  p[5] = value;
+  p[6] = (uint16_t)value >> 8;
+  pushTelemetryFrame(TELEMETRY_EVENT, p, sizeof(p));
+}
+
+// ==========================
+//          DRAIN
+// ==========================
+void updateTelemetry() {
+  while (ringUsed() > 0) {
+    uint8_t length = ring[(ringTail + 3) & RING_MASK];
+    int frameBytes = length + TELEMETRY_FRAME_BYTES;
+
+    if (TELEMETRY_PORT.availableForWrite() < frameBytes) {
+      telemetryStats.held++;
+      return;
+    }
+
+    for (int i = 0; i < frameBytes; i++) {
+      TELEMETRY_PORT.write(ring[ringTail]);
+      ringTail = (ringTail + 1) & RING_MASK;
+    }
+    telemetryStats.frames++;
+  }
+}
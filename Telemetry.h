@@ -0,0 +1,103 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                  Telemetry.h - Shadow-RC                   ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for the binary telemetry stream on USB serial.      ║
+  ║ Compact records go into a ring buffer and only drain when  ║
+  ║ the UART has room, so logging never stalls the loop.       ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you also update                         ║
+  ║ Tools/telemetry_decode.py to match.                        ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+// ---------- Stream Settings ----------
+#define TELEMETRY_PORT          Serial
+#define TELEMETRY_DECIMATION    4      // Record every Nth control tick (4 = 50 Hz, 0 = off)
+#define TELEMETRY_RING_BYTES    256    // Power of 2; ~13 drive frames
+#define TELEMETRY_TASK_US       2000   // Drain task period
+#define TELEMETRY_DRIVER_EVERY  5      // Driver frame every Nth drive frame (10 Hz); feedback on only
+
+// ---------- Frame Format ----------
+// 0xA5 0x5A | type | length | seq | payload[length] | checksum
+// checksum = 8-bit sum of type, length, seq and payload. Multi-byte
+// fields are little-endian. Anything between frames is console text.
+#define TELEMETRY_SYNC1         0xA5
+#define TELEMETRY_SYNC2         0x5A
+#define TELEMETRY_FRAME_BYTES   6      // Framing around the payload
+#define TELEMETRY_MAX_PAYLOAD   57     // Whole frame must fit the 63-byte UART TX buffer
+
+enum TelemetryType {
+  TELEMETRY_DRIVE = 0x01,   // TelemetryDriveRecord
+  TELEMETRY_EVENT = 0x02,   // TelemetryEventRecord
+  TELEMETRY_INPUT = 0x03,   // Input trace, see InputTrace.h
+  TELEMETRY_DRIVER = 0x04   // TelemetryDriverRecord (MOTOR_FEEDBACK_POLL_MS > 0)
+};
+
+enum TelemetryFlags {
+  TELEMETRY_FLAG_KILL          = 0x01,   // Drive kill switch engaged
+  TELEMETRY_FLAG_MP3_SUPPRESS  = 0x02,   // MarcDuino mode has MP3 triggers off
+  TELEMETRY_FLAG_MP3_BLOCKED   = 0x04,   // MP3 triggers held by an active combo
+  TELEMETRY_FLAG_LINK_LOST     = 0x08    // Receiver A silent, motors held at 0
+};
+
+enum TelemetryEvent {
+  TELEMETRY_EVENT_MP3_BLOCKED  = 1,      // value = 1 blocked, 0 released
+  TELEMETRY_EVENT_MODE         = 2,      // value = new mode
+  TELEMETRY_EVENT_KILL         = 3,      // value = 1 engaged, 0 released
+  TELEMETRY_EVENT_LINK         = 4       // value = 1 receiver A lost, 0 back
+};
+
+// 13-byte payload
+struct TelemetryDriveRecord {
+  uint32_t timeMs;
+  int8_t   driveRaw, driveOut;   // Mapped stick / power queued on the motor bus
+  int8_t   turnRaw,  turnOut;
+  int8_t   domeRaw,  domeOut;
+  uint8_t  mode;
+  uint8_t  combo;
+  uint8_t  flags;                // TelemetryFlags
+};
+
+// 16-byte payload: the 2x32's newest readings + Carpet traction control
+struct TelemetryDriverRecord {
+  uint32_t timeMs;
+  uint16_t batteryDv;            // 0.1 V (0 = no reply yet)
+  int16_t  currentDa[2];         // Motor 1 / 2, 0.1 A
+  int8_t   temperatureC[2];
+  uint16_t currentAgeMs;         // Since the newest current reply (0xFFFF = none / stale)
+  uint8_t  scalePercent;         // driveGovernor.scale, 100 = the profile's speed limit
+  uint8_t  rampStep;             // driveGovernor.maxStep (0 = no limit)
+};
+
+// 7-byte payload
+struct TelemetryEventRecord {
+  uint32_t timeMs;
+  uint8_t  code;                 // TelemetryEvent
+  int16_t  value;
+};
+
+struct TelemetryStats {
+  unsigned long frames;          // Frames written to the UART
+  unsigned long dropped;         // Frames lost because the ring was full
+  unsigned long held;            // Drain passes that waited for UART room
+};
+
+extern TelemetryStats telemetryStats;
+
+// ---------- Setup & Loop ----------
+void setupTelemetry();
+void recordTelemetryTick();                     // Control tick; keeps every Nth
+void logTelemetryEvent(uint8_t code, int16_t value);
+bool pushTelemetryFrame(uint8_t type, const uint8_t* payload, uint8_t length);  // false = ring full, dropped
+void updateTelemetry();                         // Background task: drain what fits
+
+// ---------- Settings ----------
+void setTelemetryDecimation(uint8_t everyNthTick);  // 0 = no drive records
+
+#endif
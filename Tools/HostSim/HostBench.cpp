@@ -0,0 +1,705 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                  HostBench.cpp - Shadow-RC HostSim                 ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Runs the real sketch on a desktop against simulated receivers and ║
+  ║ serial devices, once per drive mode, and reports loop timing,     ║
+  ║ tick overruns, bus usage and input → output latency. Catch a      ║
+  ║ regression here before it is flashed onto the droid.              ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - Each mode runs in its own forked process, so every run starts
+    from a clean power-on: `currentMode` is set, `setup()` runs,
+    `loop()` runs until every boot step is done (Startup.h: drivers
+    synced, MP3 board up, startup sound), then the script plays.
+    The boot table shows each step in ms after power-on.
+  - The same script plays in every mode: drive, dome and turn stick
+    steps, MP3 buttons on both controllers, then combo 5 (Awake+)
+    and combo 6 (Quiet) for the MarcDuino path. Then the sticks rest
+    long enough for the idle governor to park (IdleGovernor.cpp) and
+    a drive step wakes it: that one counts in the drive latency, and
+    the governor table shows each state's rates and the wake time.
+    Then receiver A goes silent with the drive stick pushed: "link
+    loss" is the last drive pulse → the drive stop packet.
+  - It ends with receiver A back, the drive stick pushed again and
+    `loop()` no longer called: "stall stop" is the last loop() pass →
+    the drive stop packet the watchdog reset boot sends (Failsafe.cpp).
+    Only that first part of setup() runs again, so the run ends there.
+  - Latency is measured end to end, outside the firmware: from the
+    falling edge of the first pulse carrying the new width to the
+    last stop bit of the first packet / command that answers it.
+  - Virtual time only passes in blocking calls (`delay()`, `write()`
+    into a full TX ring, `pulseIn()`) plus `--loop-cost` µs per
+    `loop()` pass. A new `delay()` or blocking print shows up as tick
+    overruns and "blocked" time; CPU cost shows up as host ns/tick.
+
+  REPLAY:
+  ─────────────────────────────────────────────────────────────────────
+  `--replay walk.trace` swaps the script for a recording from the
+  droid (`trace on`, see InputTrace.cpp): the receivers go silent and
+  the trace is fed through `storePWMChannel()` at its recorded edge
+  times. Same trace, same build → same outputs, so the output digest
+  shows at a glance whether a curve / combo / scheduler change altered
+  anything on the wire, and the timing table shows what it cost.
+  The dome is simulated (SimDome) and closes the encoder loop; add
+  `--trace-encoder` to feed the recorded encoder counts instead.
+  `--record FILE --mode N` writes the raw USB stream of a scripted run
+  with the trace on, for a round trip through telemetry_decode.py.
+
+  USAGE:
+  ─────────────────────────────────────────────────────────────────────
+    make            → builds ./host_bench
+    make bench      → all four modes
+    make check      → same, exit code 1 on overruns, missed
+                      deadlines, a blocked Serial1 / 2 / 3 write, a
+                      watchdog interrupt, slow p99, a slow boot or
+                      a dome decoder that lost count of the encoder
+    ./host_bench --mode 3 --verbose   (console text on stderr)
+    ./host_bench --replay walk.trace [--mode 1] [--check]
+
+  LIMITS:
+  ─────────────────────────────────────────────────────────────────────
+  `int` is 32 bits here (16 on the Mega), so 16-bit overflow bugs do
+  not show up. CPU time is host time, useful only to compare runs.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `Tools/HostSim/HostBench.cpp`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "SimDevices.h"
+#include <Sabertooth.h>
+#include "ComboHandler.h"
+#include "Scheduler.h"
+#include "MotorBus.h"
+#include "DomePosition.h"
+#include "Failsafe.h"
+#include "Startup.h"
+#include "IdleGovernor.h"
+
+void setup();
+void loop();
+
+// ==========================
+//         SETTINGS
+// ==========================
+#define BENCH_SCRIPT_MS            23000   // Script length after the boot steps are done
+#define BENCH_MAX_BOOT_MS          5000    // Give up waiting for the boot steps here
+// --check limit for power-on → first motor command: the driver wait + sync,
+// plus the driver restart and every verify try when the baud rate changes
+#define BENCH_BAUD_CHANGE_MS       (MOTOR_BUS_BAUD == MOTOR_BUS_START_BAUD ? 0 : \
+                                    (SABERTOOTH_BAUD_RESTART_MICROS + \
+                                     (MOTOR_BUS_VERIFY_ADDRESS ? SABERTOOTH_BAUD_VERIFY_MICROS * SABERTOOTH_BAUD_VERIFY_TRIES : 0)) / 1000)
+#define BENCH_MAX_FIRST_COMMAND_MS (MOTOR_BUS_DRIVER_BOOT_MS + 50 + BENCH_BAUD_CHANGE_MS)
+#define BENCH_DEFAULT_LOOP_COST_US 20      // Virtual µs charged per loop() pass
+#define BENCH_MAX_STICK_P99_US     60000   // --check limit for stick → motor p99
+#define BENCH_MAX_BUTTON_US        120000  // --check limit for button → output
+#define BENCH_MAX_DOME_DRIFT_COUNTS 1      // --check limit for decoded vs simulated dome position
+#define BENCH_REPLAY_TAIL_MS       1000    // Keep running this long after the last trace event
+#define BENCH_LINK_LOSS_MS         21000   // Receiver A goes silent here
+// --check limit for link loss → stop packet: declared + one tick + a packet slot
+#define BENCH_MAX_LINK_STOP_US     (PWM_SIGNAL_TIMEOUT_US + CONTROL_TICK_US + 10000)
+#define BENCH_ALL_CHANNELS         0xFF    // BenchStep.channel: every channel of the receiver
+#define BENCH_STALL_MS             22500   // loop() stops being called here
+// --check limit for stall → stop packet: the watchdog path in Failsafe.cpp
+#define BENCH_MAX_STALL_STOP_US    ((FAILSAFE_WATCHDOG_MS * 11 / 10 + 32) * 1000UL)
+
+enum BenchPath { PATH_DRIVE = 0, PATH_TURN, PATH_DOME, PATH_MP3, PATH_MARCDUINO, PATH_LINK, PATH_STALL, PATH_COUNT };
+static const char* const pathNames[PATH_COUNT] = {
+  "drive", "turn", "dome", "mp3", "marcduino", "link loss", "stall stop"
+};
+
+enum { RX_A = 0, RX_B };
+
+struct BenchStep {
+  unsigned long atMs;
+  uint8_t       receiver;
+  uint8_t       channel;
+  int           widthUs;
+  int8_t        path;         // -1 = no latency probe
+  uint8_t       trackMin, trackMax;   // MP3 bank the step should trigger
+};
+
+// ==========================
+//          SCRIPT
+// ==========================
+static std::vector<BenchStep> buildScript() {
+  std::vector<BenchStep> s;
+  static const int driveSteps[] = { 1750, 1900, 1500, 1250, 1100, 1500, 1650 };
+  static const int domeSteps[]  = { 1700, 1500, 1300, 1500 };
+  static const int turnSteps[]  = { 1700, 1500, 1300, 1500 };
+
+  for (int k = 0; k < 14; k++) s.push_back({ 500UL + k * 400, RX_A, 1, driveSteps[k % 7], PATH_DRIVE, 0, 0 });
+  for (int k = 0; k < 12; k++) s.push_back({ 700UL + k * 400, RX_B, 0, domeSteps[k % 4],  PATH_DOME,  0, 0 });
+  for (int k = 0; k < 8; k++)  s.push_back({ 6500UL + k * 300, RX_A, 0, turnSteps[k % 4], PATH_TURN,  0, 0 });
+
+  s.push_back({ 9000,  RX_A, 2, 2000, PATH_MP3, 1, 16 });      // CH3A → Happy
+  s.push_back({ 10000, RX_B, 4, 2000, PATH_MP3, 181, 186 });   // CH5B → Singing
+  s.push_back({ 11000, RX_A, 5, 2000, PATH_MP3, 91, 103 });    // CH6A press → Yelling
+  s.push_back({ 11300, RX_A, 5, 1000, -1, 0, 0 });
+
+  s.push_back({ 12000, RX_B, 1, 1900, -1, 0, 0 });             // Stick B up ...
+  s.push_back({ 12300, RX_A, 2, 1000, PATH_MARCDUINO, 0, 0 }); // ... + CH3A = combo 5 (Awake+)
+  s.push_back({ 12800, RX_B, 1, 1500, -1, 0, 0 });
+  s.push_back({ 14000, RX_B, 1, 1900, -1, 0, 0 });             // Stick B up ...
+  s.push_back({ 14300, RX_A, 3, 2000, PATH_MARCDUINO, 0, 0 }); // ... + CH4A = combo 6 (Quiet, MP3 back on)
+  s.push_back({ 14800, RX_B, 1, 1500, -1, 0, 0 });
+
+  s.push_back({ 16000, RX_A, 4, 2000, PATH_MP3, 61, 76 });     // CH5A → Talking
+
+  s.push_back({ 16500, RX_A, 1, 1500, PATH_DRIVE, 0, 0 });     // Sticks centred: the governor parks ...
+  s.push_back({ 20000, RX_A, 1, 1750, PATH_DRIVE, 0, 0 });     // ... and this wakes it
+
+  s.push_back({ BENCH_LINK_LOSS_MS, RX_A, BENCH_ALL_CHANNELS, 0, PATH_LINK, 0, 0 });   // Transmitter A off
+  s.push_back({ 21500, RX_A, BENCH_ALL_CHANNELS, 1000, -1, 0, 0 });   // ... and back on, sticks centred
+  s.push_back({ 21500, RX_A, 0, 1500, -1, 0, 0 });
+  s.push_back({ 21500, RX_A, 1, 1500, -1, 0, 0 });
+  s.push_back({ 22000, RX_A, 1, 1800, -1, 0, 0 });             // Driving when loop() stalls
+
+  std::stable_sort(s.begin(), s.end(),
+                   [](const BenchStep &a, const BenchStep &b) { return a.atMs < b.atMs; });
+  return s;
+}
+
+// ==========================
+//      LATENCY PROBES
+// ==========================
+struct Probe {
+  bool     armed;
+  bool     edgeSeen;
+  uint8_t  receiver, channel;
+  int      widthUs;
+  SimTime  edgeUs;
+  int      baseline;          // Motor power before the step
+  uint8_t  trackMin, trackMax;
+};
+
+struct Bench {
+  Probe                      probes[PATH_COUNT];
+  std::vector<unsigned long> samples[PATH_COUNT];
+  unsigned long              unanswered[PATH_COUNT];
+  int                        power[PATH_DOME + 1];   // Last power seen on the wire per axis
+  unsigned long long         digest;                 // FNV-1a over every output command
+  SimDome*                   dome;
+  SimTime                    lastFallUs[2][SIM_RECEIVER_CHANNELS];
+  SimTime                    resetUs;                // Watchdog reset, 0 = none yet
+  bool                       measureSticks;
+  bool                       measureDome;
+};
+
+static Bench bench;
+
+static void digestByte(uint8_t b) {
+  bench.digest = (bench.digest ^ b) * 0x100000001B3ULL;
+}
+
+static void finishProbe(uint8_t path, SimTime doneUs) {
+  Probe &p = bench.probes[path];
+  bench.samples[path].push_back((unsigned long)(doneUs - p.edgeUs));
+  p.armed = false;
+}
+
+static void onPulse(uint8_t receiver, uint8_t channel, int widthUs, SimTime fallUs, void*) {
+  bench.lastFallUs[receiver][channel] = fallUs;
+  for (uint8_t i = 0; i < PATH_COUNT; i++) {
+    Probe &p = bench.probes[i];
+    if (p.armed && !p.edgeSeen && p.receiver == receiver && p.channel == channel && p.widthUs == widthUs) {
+      p.edgeSeen = true;
+      p.edgeUs   = fallUs;
+    }
+  }
+}
+
+static void onMotorPacket(uint8_t address, uint8_t command, uint8_t value, SimTime doneUs, void*) {
+  int8_t path = -1;
+  if (address == DRIVE_ADDRESS && (command == 8 || command == 9))  path = PATH_DRIVE;
+  if (address == DRIVE_ADDRESS && (command == 10 || command == 11)) path = PATH_TURN;
+  if (address == DOME_ADDRESS  && (command == 0 || command == 1))   path = PATH_DOME;
+  digestByte(address);
+  digestByte(command);
+  digestByte(value);
+  if (path < 0) return;
+
+  int power = SimSabertoothBus::power(command, value);
+  if (path == PATH_DOME) bench.dome->setPower(power);
+  Probe &p = bench.probes[path];
+  if (p.armed && p.edgeSeen && power != p.baseline) finishProbe(path, doneUs);
+  bench.power[path] = power;
+
+  // Link loss: timed from the last pulse receiver A sent on the drive channel
+  Probe &link = bench.probes[PATH_LINK];
+  if (path == PATH_DRIVE && link.armed && power == 0) {
+    link.edgeUs = bench.lastFallUs[RX_A][1];
+    finishProbe(PATH_LINK, doneUs);
+  }
+  Probe &stall = bench.probes[PATH_STALL];
+  if (path == PATH_DRIVE && stall.armed && bench.resetUs && power == 0) finishProbe(PATH_STALL, doneUs);
+}
+
+static void onWatchdogReset(SimTime now) {
+  bench.resetUs = now;
+}
+
+static void onTrack(uint8_t track, SimTime doneUs, void*) {
+  digestByte('t');
+  digestByte(track);
+  Probe &p = bench.probes[PATH_MP3];
+  if (p.armed && p.edgeSeen && track >= p.trackMin && track <= p.trackMax) finishProbe(PATH_MP3, doneUs);
+}
+
+static void onMarcDuino(const char* line, SimTime doneUs, void*) {
+  while (*line) digestByte(*line++);
+  digestByte('\r');
+  Probe &p = bench.probes[PATH_MARCDUINO];
+  if (p.armed && p.edgeSeen) finishProbe(PATH_MARCDUINO, doneUs);
+}
+
+static void armProbe(const BenchStep &step) {
+  if (step.path < 0) return;
+  if ((step.path <= PATH_DOME || step.path >= PATH_LINK) && !bench.measureSticks) return;
+  if (step.path == PATH_DOME && !bench.measureDome) return;
+
+  Probe &p = bench.probes[step.path];
+  if (p.armed) bench.unanswered[step.path]++;    // Previous step never got an answer
+  p.armed    = true;
+  p.edgeSeen = false;
+  p.receiver = step.receiver;
+  p.channel  = step.channel;
+  p.widthUs  = step.widthUs;
+  p.baseline = step.path <= PATH_DOME ? bench.power[step.path] : 0;
+  p.trackMin = step.trackMin;
+  p.trackMax = step.trackMax;
+}
+
+// loop() is never called again. The watchdog resets the "Mega" and the
+// reset boot gets as far as setupFailsafe(), the part that stops the motors.
+static void runStall(SimTime end) {
+  if (bench.measureSticks) {
+    Probe &p = bench.probes[PATH_STALL];
+    p.armed    = true;
+    p.edgeSeen = true;
+    p.edgeUs   = simNow();                       // End of the last loop() pass
+  }
+  while (!bench.resetUs && simStep(end)) {}
+  if (bench.resetUs) setupFailsafe();
+  simAdvanceTo(end);
+}
+
+// ==========================
+//          RESULTS
+// ==========================
+struct PathResult {
+  unsigned long n, unanswered;
+  unsigned long p50, p90, p99, maxUs;
+};
+
+struct ModeResult {
+  int           mode;
+  unsigned long ticks, overruns, missed, skipped, tickWorstUs;
+  unsigned long passes, passMaxUs, passesOverTick;
+  double        passMeanUs, hostNsPerTick;
+  double        bus128Pct, bus129Pct;
+  unsigned long badChecksums;
+  unsigned long blockedUs[4];            // Serial, Serial1, Serial2, Serial3
+  unsigned long packets[2], tracks, marcCommands;
+  unsigned long long digest;
+  double        domeEndDeg;              // Simulated dome angle when the run ends
+  double        domeDriftCounts;         // Firmware decoder - simulated encoder, counts (NAN = not fed)
+  unsigned long encoderErrors;           // Illegal transitions the firmware decoder saw
+  unsigned long wdtGapUs, lateFeeds;     // Longest time between watchdog feeds, near-resets
+  unsigned long bootMs[STARTUP_STEP_COUNT];   // Startup steps, ms after power-on
+  uint8_t       bootMask;                     // Steps that finished within BENCH_MAX_BOOT_MS
+  PathResult    paths[PATH_COUNT];
+  GovernorStats governor;                // Script part only
+};
+
+static unsigned long percentile(const std::vector<unsigned long> &sorted, unsigned pct) {
+  if (sorted.empty()) return 0;
+  size_t rank = (sorted.size() * pct + 99) / 100;
+  return sorted[rank ? rank - 1 : 0];
+}
+
+struct BenchOptions {
+  int             onlyMode;
+  unsigned long   loopCostUs;
+  bool            verbose;
+  bool            check;
+  SimTracePlayer* replay;        // NULL = scripted run
+  const char*     recordPath;    // Raw USB capture with the input trace on
+};
+
+// ==========================
+//        ONE MODE RUN
+// ==========================
+static ModeResult runMode(int mode, const BenchOptions &opt) {
+  static SimReceiver receiverA(RX_A, simReceiverPinsA, 0);
+  static SimReceiver receiverB(RX_B, simReceiverPinsB, 7300);
+  static SimSabertoothBus motors;
+  static SimMp3Trigger    mp3Board;
+  static SimMarcDuino     marcDuino;
+  static SimUsbHost       usb;
+  static SimDome          dome(DOME_ENCODER_PIN_A, DOME_ENCODER_PIN_B, DOME_TICKS_PER_DEGREE / 65536.0);
+
+  receiverA.setListener(onPulse, NULL);
+  receiverB.setListener(onPulse, NULL);
+  motors.attach(Serial2);
+  motors.setListener(onMotorPacket, NULL);
+  simSetResetListener(onWatchdogReset);
+  mp3Board.attach(Serial1);
+  mp3Board.setListener(onTrack, NULL);
+  marcDuino.attach(Serial3);
+  marcDuino.setListener(onMarcDuino, NULL);
+  usb.attach(Serial);
+  usb.echo = opt.verbose;
+  bench.dome = &dome;
+  dome.connected = !(opt.replay && opt.replay->replayEncoder);
+  if (opt.recordPath) usb.capture = fopen(opt.recordPath, "wb");
+  if (opt.replay) {
+    for (uint8_t ch = 0; ch < SIM_RECEIVER_CHANNELS; ch++) {
+      receiverA.setWidth(ch, 0);
+      receiverB.setWidth(ch, 0);
+    }
+  }
+
+  bench.measureSticks = (mode != 2);                // Automated mode ignores the sticks
+  bench.measureDome   = (mode != 2);                // Hybrid: the dome stick overrides automation
+
+  currentMode = mode;
+  setup();
+
+  // The drivers and the MP3 board finish in the background: let them
+  while (!isStartupComplete() && simNow() < BENCH_MAX_BOOT_MS * 1000ULL) {
+    loop();
+    simAdvanceTo(simNow() + opt.loopCostUs);
+  }
+
+  HardwareSerial* ports[4] = { &Serial, &Serial1, &Serial2, &Serial3 };
+  unsigned long long blockedStart[4], blockedEnd[4];
+  for (int i = 0; i < 4; i++) blockedStart[i] = ports[i]->blockedUs;
+  unsigned long packetsStart[2] = { motors.packets[0], motors.packets[1] };
+  unsigned long tracksStart = mp3Board.triggers, marcStart = marcDuino.commands;
+  bench.digest = 0xCBF29CE484222325ULL;   // Boot outputs are the same in every run
+
+  std::vector<BenchStep> script;
+  if (!opt.replay) script = buildScript();
+  size_t nextStep = 0;
+  SimTime start = simNow();
+  SimTime end   = start + BENCH_SCRIPT_MS * 1000ULL;
+  if (opt.replay) {
+    opt.replay->start(start);
+    end = start + opt.replay->lengthUs() + BENCH_REPLAY_TAIL_MS * 1000ULL;
+  }
+  if (opt.recordPath) {
+    static const char command[] = "trace on\n";
+    Serial.injectRx((const uint8_t*)command, sizeof(command) - 1);
+  }
+
+  ModeResult r;
+  memset(&r, 0, sizeof(r));
+  r.mode = mode;
+  memcpy(r.bootMs, startupStats.doneMs, sizeof(r.bootMs));
+  r.bootMask = startupStats.doneMask;
+
+  unsigned long ticksBefore = controlTickStats.ticks;
+  GovernorStats governorBefore = governorStats;
+  double passTotalUs = 0, tickHostNs = 0;
+  unsigned long tickPasses = 0;
+
+  while (simNow() < end) {
+    if (!opt.replay && simNow() >= start + BENCH_STALL_MS * 1000ULL) break;
+    while (nextStep < script.size() && start + script[nextStep].atMs * 1000ULL <= simNow()) {
+      const BenchStep &step = script[nextStep++];
+      SimReceiver &rx = (step.receiver == RX_A) ? receiverA : receiverB;
+      if (step.channel == BENCH_ALL_CHANNELS) {
+        for (uint8_t ch = 0; ch < SIM_RECEIVER_CHANNELS; ch++) rx.setWidth(ch, step.widthUs);
+      } else {
+        rx.setWidth(step.channel, step.widthUs);
+      }
+      armProbe(step);
+    }
+
+    SimTime before = simNow();
+    unsigned long ticks = controlTickStats.ticks;
+    auto hostStart = std::chrono::steady_clock::now();
+    loop();
+    auto hostEnd = std::chrono::steady_clock::now();
+    if (controlTickStats.ticks != ticks) {
+      tickHostNs += std::chrono::duration<double, std::nano>(hostEnd - hostStart).count();
+      tickPasses++;
+    }
+
+    simAdvanceTo(simNow() + opt.loopCostUs);
+    unsigned long passUs = (unsigned long)(simNow() - before);
+    passTotalUs += passUs;
+    r.passes++;
+    if (passUs > r.passMaxUs) r.passMaxUs = passUs;
+    if (passUs > CONTROL_TICK_US) r.passesOverTick++;
+  }
+
+  // Counted before the stall: the reset boot clears them, and its flush may block
+  for (int i = 0; i < 4; i++) blockedEnd[i] = ports[i]->blockedUs;
+  r.wdtGapUs  = failsafeStats.worstFeedGapUs;
+  r.lateFeeds = failsafeStats.lateFeeds;
+  r.governor  = governorStats;
+  if (!opt.replay) runStall(end);
+
+  double elapsedUs = (double)(simNow() - start);
+  r.ticks          = controlTickStats.ticks - ticksBefore;
+  r.overruns       = controlTickStats.overruns;
+  r.missed         = controlTickStats.missedDeadlines;
+  r.skipped        = controlTickStats.skippedTicks;
+  r.tickWorstUs    = controlTickStats.worstUs;
+  r.passMeanUs     = r.passes ? passTotalUs / r.passes : 0;
+  r.hostNsPerTick  = tickPasses ? tickHostNs / tickPasses : 0;
+  double byteUs    = 10e6 / Serial2.baud();
+  r.bus128Pct      = (motors.packets[0] - packetsStart[0]) * MOTOR_PACKET_BYTES * byteUs * 100.0 / elapsedUs;
+  r.bus129Pct      = (motors.packets[1] - packetsStart[1]) * MOTOR_PACKET_BYTES * byteUs * 100.0 / elapsedUs;
+  r.badChecksums   = motors.badChecksums;
+  for (int i = 0; i < 4; i++) r.blockedUs[i] = (unsigned long)(blockedEnd[i] - blockedStart[i]);
+  r.packets[0]     = motors.packets[0] - packetsStart[0];
+  r.packets[1]     = motors.packets[1] - packetsStart[1];
+  r.tracks         = mp3Board.triggers - tracksStart;
+  r.marcCommands   = marcDuino.commands - marcStart;
+  r.digest         = bench.digest;
+  r.domeEndDeg     = dome.angle();
+  r.domeDriftCounts = dome.connected ? readDomeTicks() - dome.angle() * DOME_TICKS_PER_DEGREE / 65536.0 : NAN;
+  r.encoderErrors  = readDomeEncoderErrors();
+  for (uint8_t i = 0; i < GOVERNOR_STATE_COUNT; i++) {
+    r.governor.state[i].ms      -= governorBefore.state[i].ms;
+    r.governor.state[i].sleepMs -= governorBefore.state[i].sleepMs;
+    r.governor.state[i].ticks   -= governorBefore.state[i].ticks;
+    r.governor.state[i].packets -= governorBefore.state[i].packets;
+  }
+  r.governor.entries   -= governorBefore.entries;
+  r.governor.edgeWakes -= governorBefore.edgeWakes;
+  if (usb.capture) fclose(usb.capture);
+
+  for (uint8_t i = 0; i < PATH_COUNT; i++) {
+    std::vector<unsigned long> v = bench.samples[i];
+    std::sort(v.begin(), v.end());
+    PathResult &p = r.paths[i];
+    p.n          = v.size();
+    p.unanswered = bench.unanswered[i] + (bench.probes[i].armed ? 1 : 0);
+    p.p50        = percentile(v, 50);
+    p.p90        = percentile(v, 90);
+    p.p99        = percentile(v, 99);
+    p.maxUs      = v.empty() ? 0 : v.back();
+  }
+  return r;
+}
+
+// ==========================
+//          REPORT
+// ==========================
+static const char* modeName(int mode) {
+  switch (mode) {
+    case 1: return "Manual";
+    case 2: return "Automated";
+    case 3: return "Hybrid";
+    case 4: return "Carpet";
+  }
+  return "?";
+}
+
+static void printReport(const std::vector<ModeResult> &results, const BenchOptions &opt) {
+  if (opt.replay) {
+    printf("Shadow-RC host bench — replay of %lu trace events (%.1f s), %lu us per loop() pass, Serial2 @ %lu baud\n\n",
+           (unsigned long)opt.replay->eventCount(), opt.replay->lengthUs() / 1e6,
+           opt.loopCostUs, (unsigned long)MOTOR_BUS_START_BAUD);
+  } else {
+    printf("Shadow-RC host bench — %d ms script, %lu us per loop() pass, Serial2 @ %lu baud\n\n",
+           BENCH_SCRIPT_MS, opt.loopCostUs, (unsigned long)MOTOR_BUS_START_BAUD);
+  }
+
+  printf("%-10s %7s %6s %6s %6s %8s %8s %8s %9s %7s %7s %9s %9s %8s\n",
+         "mode", "ticks", "overr", "missed", "skip", "tickMax", "passAvg", "passMax",
+         "host ns", "bus128", "bus129", "S2 block", "USB block", "wdt gap");
+  for (const ModeResult &r : results) {
+    printf("%-10s %7lu %6lu %6lu %6lu %7luu %7.1fu %7luu %9.0f %6.1f%% %6.1f%% %8luu %8luu %7luu\n",
+           modeName(r.mode), r.ticks, r.overruns, r.missed, r.skipped, r.tickWorstUs,
+           r.passMeanUs, r.passMaxUs, r.hostNsPerTick, r.bus128Pct, r.bus129Pct,
+           r.blockedUs[2], r.blockedUs[0], r.wdtGapUs);
+  }
+
+  printf("\nInput edge → last stop bit of the answer (us)\n");
+  printf("%-10s %-10s %4s %4s %8s %8s %8s %8s\n", "mode", "path", "n", "lost", "p50", "p90", "p99", "max");
+  for (const ModeResult &r : results) {
+    for (uint8_t i = 0; i < PATH_COUNT; i++) {
+      const PathResult &p = r.paths[i];
+      if (p.n == 0 && p.unanswered == 0) continue;   // Path not exercised in this mode
+      printf("%-10s %-10s %4lu %4lu %8lu %8lu %8lu %8lu\n", modeName(r.mode), pathNames[i],
+             p.n, p.unanswered, p.p50, p.p90, p.p99, p.maxUs);
+    }
+  }
+
+  printf("\nBoot steps, ms after power-on (- = not done after %d ms)\n%-10s", BENCH_MAX_BOOT_MS, "mode");
+  for (uint8_t i = 0; i < STARTUP_STEP_COUNT; i++) printf(" %20s", (const char*)startupStepName(i));   // F() is a plain string here
+  printf("\n");
+  for (const ModeResult &r : results) {
+    printf("%-10s", modeName(r.mode));
+    for (uint8_t i = 0; i < STARTUP_STEP_COUNT; i++) {
+      if (r.bootMask & (1 << i)) printf(" %20lu", r.bootMs[i]);
+      else                       printf(" %20s", "-");
+    }
+    printf("\n");
+  }
+
+  printf("\nOutputs after boot (same digest = same commands on every UART)\n");
+  printf("%-10s %8s %8s %6s %9s %7s %7s  %-16s\n", "mode", "pkts128", "pkts129", "mp3", "marcduino", "dome", "enc err", "digest");
+  for (const ModeResult &r : results) {
+    printf("%-10s %8lu %8lu %6lu %9lu %6.1f° %7lu  %016llx\n", modeName(r.mode),
+           r.packets[0], r.packets[1], r.tracks, r.marcCommands, r.domeEndDeg, r.encoderErrors, r.digest);
+  }
+
+  printf("\nIdle governor (script only; rates per second spent in that state)\n");
+  printf("%-10s %8s %7s %7s %8s %8s %6s %6s %6s %8s\n", "mode", "parked s", "tick/s", "pkt/s",
+         "idle t/s", "idle p/s", "sleep", "parks", "wakes", "worst us");
+  for (const ModeResult &r : results) {
+    const GovernorStateStats &a = r.governor.state[GOVERNOR_ACTIVE];
+    const GovernorStateStats &i = r.governor.state[GOVERNOR_IDLE];
+    printf("%-10s %8.1f %7.0f %7.1f %8.0f %8.1f %5.0f%% %6lu %6lu %8lu\n", modeName(r.mode), i.ms / 1000.0,
+           a.ms ? a.ticks * 1000.0 / a.ms : 0.0, a.ms ? a.packets * 1000.0 / a.ms : 0.0,
+           i.ms ? i.ticks * 1000.0 / i.ms : 0.0, i.ms ? i.packets * 1000.0 / i.ms : 0.0,
+           i.ms ? i.sleepMs * 100.0 / i.ms : 0.0, r.governor.entries, r.governor.edgeWakes,
+           r.governor.worstWakeUs);
+  }
+}
+
+static bool checkResults(const std::vector<ModeResult> &results) {
+  bool ok = true;
+  for (const ModeResult &r : results) {
+    const char* name = modeName(r.mode);
+    if (r.overruns || r.missed || r.skipped) {
+      printf("FAIL %s: %lu overruns, %lu missed deadlines, %lu skipped ticks\n", name, r.overruns, r.missed, r.skipped);
+      ok = false;
+    }
+    for (int i = 1; i < 4; i++) {              // Motor bus, MP3 board, MarcDuino: never wait
+      if (r.blockedUs[i]) {
+        printf("FAIL %s: Serial%d write blocked for %lu us\n", name, i, r.blockedUs[i]);
+        ok = false;
+      }
+    }
+    if (r.lateFeeds) {
+      printf("FAIL %s: watchdog interrupt fired %lu times (worst feed gap %lu us)\n", name, r.lateFeeds, r.wdtGapUs);
+      ok = false;
+    }
+    if (r.bootMask != (1 << STARTUP_STEP_COUNT) - 1) {
+      printf("FAIL %s: boot steps not done after %d ms\n", name, BENCH_MAX_BOOT_MS);
+      ok = false;
+    } else if (r.bootMs[STARTUP_FIRST_COMMAND] > BENCH_MAX_FIRST_COMMAND_MS) {
+      printf("FAIL %s: first motor command %lu ms after power-on > %lu ms\n", name,
+             r.bootMs[STARTUP_FIRST_COMMAND], (unsigned long)BENCH_MAX_FIRST_COMMAND_MS);
+      ok = false;
+    }
+    if (fabs(r.domeDriftCounts) > BENCH_MAX_DOME_DRIFT_COUNTS) {
+      printf("FAIL %s: dome decoder is %.1f counts off the simulated encoder\n", name, r.domeDriftCounts);
+      ok = false;
+    }
+    if (r.badChecksums) {
+      printf("FAIL %s: %lu corrupt motor packets\n", name, r.badChecksums);
+      ok = false;
+    }
+    for (uint8_t i = 0; i < PATH_COUNT; i++) {
+      const PathResult &p = r.paths[i];
+      unsigned long limit = i <= PATH_DOME ? BENCH_MAX_STICK_P99_US :
+                            i == PATH_LINK ? BENCH_MAX_LINK_STOP_US :
+                            i == PATH_STALL ? BENCH_MAX_STALL_STOP_US : BENCH_MAX_BUTTON_US;
+      if (p.n && p.p99 > limit) {
+        printf("FAIL %s: %s p99 %lu us > %lu us\n", name, pathNames[i], p.p99, limit);
+        ok = false;
+      }
+      if (p.unanswered) {
+        printf("FAIL %s: %lu %s steps never answered\n", name, p.unanswered, pathNames[i]);
+        ok = false;
+      }
+    }
+  }
+  printf(ok ? "\nCHECK PASSED\n" : "\nCHECK FAILED\n");
+  return ok;
+}
+
+// ==========================
+//           MAIN
+// ==========================
+// Sketch globals never get destroyed on the Mega; MP3Trigger's destructor
+// would flush a port this process never set up
+static void benchExit(int status) {
+  fflush(stdout);
+  _exit(status);
+}
+
+int main(int argc, char** argv) {
+  BenchOptions opt = { 0, BENCH_DEFAULT_LOOP_COST_US, false, false, NULL, NULL };
+  const char* replayPath = NULL;
+  bool replayEncoder = false;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--mode") && i + 1 < argc)           opt.onlyMode = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--loop-cost") && i + 1 < argc) opt.loopCostUs = strtoul(argv[++i], NULL, 10);
+    else if (!strcmp(argv[i], "--verbose"))                   opt.verbose = true;
+    else if (!strcmp(argv[i], "--check"))                     opt.check = true;
+    else if (!strcmp(argv[i], "--replay") && i + 1 < argc)    replayPath = argv[++i];
+    else if (!strcmp(argv[i], "--record") && i + 1 < argc)    opt.recordPath = argv[++i];
+    else if (!strcmp(argv[i], "--trace-encoder"))             replayEncoder = true;
+    else {
+      fprintf(stderr, "usage: %s [--mode 1-4] [--loop-cost us] [--verbose] [--check]\n"
+                      "       [--replay trace [--trace-encoder]] [--record usb.bin --mode 1-4]\n", argv[0]);
+      benchExit(2);
+    }
+  }
+  if (opt.loopCostUs == 0) opt.loopCostUs = 1;
+  if (opt.recordPath && (!opt.onlyMode || replayPath)) {
+    fprintf(stderr, "--record needs --mode and a scripted run\n");
+    benchExit(2);
+  }
+
+  // Loaded once here; every forked mode run replays the same copy
+  static SimTracePlayer player;
+  if (replayPath) {
+    if (!player.load(replayPath)) benchExit(2);
+    player.replayEncoder = replayEncoder;
+    opt.replay = &player;
+  }
+
+  static const int modes[] = { 1, 4, 3, 2 };   // Manual, Carpet, Hybrid, Automated
+  std::vector<ModeResult> results;
+
+  for (int mode : modes) {
+    if (opt.onlyMode && mode != opt.onlyMode) continue;
+
+    int fds[2];
+    if (pipe(fds) != 0) benchExit(2);
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {                              // Child: one clean boot of the sketch
+      close(fds[0]);
+      ModeResult r = runMode(mode, opt);
+      ssize_t written = write(fds[1], &r, sizeof(r));
+      _exit(written == (ssize_t)sizeof(r) ? 0 : 1);
+    }
+    close(fds[1]);
+    ModeResult r;
+    ssize_t got = read(fds[0], &r, sizeof(r));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (got != (ssize_t)sizeof(r)) {
+      fprintf(stderr, "%s mode run crashed\n", modeName(mode));
+      benchExit(2);
+    }
+    results.push_back(r);
+  }
+
+  printReport(results, opt);
+  benchExit((opt.check && !checkResults(results)) ? 1 : 0);
+}
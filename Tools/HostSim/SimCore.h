@@ -0,0 +1,47 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                SimCore.h - Shadow-RC HostSim               ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Simulator side of the host mock: the virtual clock, pin    ║
+  ║ levels and the event sources that fire ISRs and move       ║
+  ║ serial bytes as time advances.                             ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are adding a simulated device.      ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef HOSTSIM_CORE_H
+#define HOSTSIM_CORE_H
+
+#include <Arduino.h>
+
+typedef unsigned long long SimTime;      // Virtual µs since power-up
+#define SIM_NEVER  (~0ULL)
+
+// Anything that has to happen at a point in virtual time
+class SimEventSource {
+public:
+  virtual ~SimEventSource() {}
+  virtual SimTime nextEventUs() = 0;     // SIM_NEVER = nothing pending
+  virtual void    fireEvent(SimTime now) = 0;
+};
+
+void    simAddSource(SimEventSource* source);
+
+// ---------- Clock ----------
+SimTime simNow();
+bool    simStep(SimTime limit);          // Fires the earliest event ≤ limit; false if none
+void    simAdvanceTo(SimTime t);         // Fires everything up to t, then sets the clock to t
+
+// ---------- Pins ----------
+void    simSetPin(uint8_t pin, uint8_t level);   // Drives an input; runs attached INTn ISRs
+uint8_t simGetPin(uint8_t pin);
+void    simSetAnalog(uint8_t pin, int value);
+
+// ---------- Watchdog ----------
+// Called when the watchdog resets the "Mega". RAM (and .noinit) stays as it
+// was; the listener decides what of the boot to run again.
+typedef void (*SimResetListener)(SimTime now);
+void    simSetResetListener(SimResetListener listener);
+
+#endif
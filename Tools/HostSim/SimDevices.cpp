@@ -0,0 +1,383 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                 SimDevices.cpp - Shadow-RC HostSim                 ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Simulated receivers and the devices on the far end of each UART.  ║
+  ║ Every device sees a byte when its last stop bit is done, so the   ║
+  ║ times they report are what the real hardware would see.           ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - `SimReceiver` drives six pins with 50 Hz pulses. Channel N rises
+    N × SIM_RC_SLOT_US after the frame start; a new width is latched
+    at the next rising edge, the way a receiver updates its outputs.
+    Pins on INTn run the sketch's attached ISRs; the button pins
+    (22–29, 31) are picked up by its Timer3 sampler.
+  - `SimSabertoothBus` checks each Packet Serial checksum and reports
+    every good packet to 128 (2x32) or 129 (SyRen).
+  - `SimMp3Trigger`, `SimMarcDuino` and `SimUsbHost` decode the MP3
+    Trigger commands, MarcDuino lines and USB text / telemetry.
+  - `SimDome` turns SyRen power into dome motion (with a lag for the
+    motor and dome inertia) and toggles the encoder pins 19 / 20
+    once per count, so `DomePosition.cpp` runs closed-loop here too.
+  - `SimTracePlayer` replaces the receivers with a recorded trace
+    (InputTrace.cpp): every width lands at its recorded edge time
+    through `storePWMChannel()`, then repeats every 20 ms.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `Tools/HostSim/SimDevices.cpp`
+  Header:    `Tools/HostSim/SimDevices.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include <algorithm>              // Before Arduino.h: its min / max macros break <algorithm>
+#include "SimDevices.h"
+#include <Sabertooth.h>
+#include "DomePosition.h"
+
+const uint8_t simReceiverPinsA[SIM_RECEIVER_CHANNELS] = { 2, 3, 22, 24, 26, 28 };
+const uint8_t simReceiverPinsB[SIM_RECEIVER_CHANNELS] = { CH1B_PIN, 23, 25, 27, 29, 31 };
+
+// ==========================
+//        RC RECEIVER
+// ==========================
+SimReceiver::SimReceiver(uint8_t id, const uint8_t* pins, SimTime phaseUs)
+  : _id(id), _pins(pins), _listener(NULL), _context(NULL) {
+  for (uint8_t ch = 0; ch < SIM_RECEIVER_CHANNELS; ch++) {
+    _target[ch]  = (ch < 2) ? 1500 : 1000;    // Sticks centred, switches low
+    _latched[ch] = _target[ch];
+    _high[ch]    = false;
+    _rise[ch]    = phaseUs + ch * SIM_RC_SLOT_US;
+  }
+  simAddSource(this);
+}
+
+void SimReceiver::setWidth(uint8_t channel, int widthUs) {
+  if (channel < SIM_RECEIVER_CHANNELS) _target[channel] = widthUs;
+}
+
+SimTime SimReceiver::edgeTime(uint8_t ch) const {
+  return _high[ch] ? _rise[ch] + _latched[ch] : _rise[ch];
+}
+
+SimTime SimReceiver::nextEventUs() {
+  SimTime best = SIM_NEVER;
+  for (uint8_t ch = 0; ch < SIM_RECEIVER_CHANNELS; ch++) {
+    SimTime t = edgeTime(ch);
+    if (t < best) best = t;
+  }
+  return best;
+}
+
+void SimReceiver::fireEvent(SimTime now) {
+  for (uint8_t ch = 0; ch < SIM_RECEIVER_CHANNELS; ch++) {
+    if (edgeTime(ch) > now) continue;
+
+    if (!_high[ch]) {
+      _latched[ch] = _target[ch];
+      if (_latched[ch] <= 0) {                 // Silent: skip this frame
+        _rise[ch] += SIM_RC_PERIOD_US;
+        continue;
+      }
+      _high[ch] = true;
+      simSetPin(_pins[ch], HIGH);
+    } else {
+      _high[ch] = false;
+      simSetPin(_pins[ch], LOW);
+      if (_listener) _listener(_id, ch, _latched[ch], now, _context);
+      _rise[ch] += SIM_RC_PERIOD_US;
+    }
+    return;                                     // One edge per event keeps ISR order exact
+  }
+}
+
+// ==========================
+//     SABERTOOTH / SYREN
+// ==========================
+SimSabertoothBus::SimSabertoothBus()
+  : badChecksums(0), syncBytes(0), replies(0), _length(0), _port(NULL), _drive(0), _turn(0),
+    _listener(NULL), _context(NULL) {
+  packets[0] = packets[1] = 0;
+}
+
+void SimSabertoothBus::attach(HardwareSerial &port) {
+  _port = &port;
+  port.setSink(onByte, this);
+}
+
+void SimSabertoothBus::reply(uint8_t address, uint8_t type, uint8_t targetType, uint8_t targetNumber) {
+  int m1 = abs(_drive + _turn), m2 = abs(_drive - _turn);
+  if (m1 > 127) m1 = 127;
+  if (m2 > 127) m2 = 127;
+  int value = 0;
+  switch (type) {
+    case SABERTOOTH_GET_CURRENT:     value = 2 * (targetNumber == '2' ? m2 : m1); break;
+    case SABERTOOTH_GET_BATTERY:     value = 252 - (m1 + m2) / 5;                 break;
+    case SABERTOOTH_GET_TEMPERATURE: value = 30 + (targetNumber == '2' ? m2 : m1) / 8; break;
+  }
+  uint8_t r[SABERTOOTH_REPLY_PACKET_SIZE];
+  r[0] = address;
+  r[1] = SABERTOOTH_COMMAND_REPLY;
+  r[2] = type;
+  r[3] = (r[0] + r[1] + r[2]) & 0x7F;
+  r[4] = value & 0x7F;
+  r[5] = (value >> 7) & 0x7F;
+  r[6] = targetType;
+  r[7] = targetNumber;
+  r[8] = (r[4] + r[5] + r[6] + r[7]) & 0x7F;
+  _port->injectRx(r, sizeof(r));
+  replies++;
+}
+
+int SimSabertoothBus::power(uint8_t command, uint8_t value) {
+  switch (command) {
+    case 0: case 4: case 8: case 10: return value;     // Forward / right
+    case 1: case 5: case 9: case 11: return -value;    // Backward / left
+  }
+  return 0;
+}
+
+void SimSabertoothBus::onByte(uint8_t b, SimTime doneUs, void* context) {
+  SimSabertoothBus &bus = *(SimSabertoothBus*)context;
+
+  if (bus._length == 0) {
+    if (b == 0xAA) { bus.syncBytes++; return; }
+    if (b < 128) return;                        // Not an address: resync
+  }
+  bus._packet[bus._length++] = b;
+
+  uint8_t needed = (bus._length >= 2 && bus._packet[1] == SABERTOOTH_COMMAND_GET) ? 7 : 4;
+  if (bus._length < needed) return;
+  bus._length = 0;
+
+  const uint8_t* p = bus._packet;
+  if (((p[0] + p[1] + p[2]) & 0x7F) != p[3]) {
+    bus.badChecksums++;
+    return;
+  }
+  if (p[0] == 128 || p[0] == 129) bus.packets[p[0] - 128]++;
+  if (needed == 7) {
+    if (((p[4] + p[5]) & 0x7F) == p[6] && bus._port) bus.reply(p[0], p[2], p[4], p[5]);
+    return;
+  }
+  int power = SimSabertoothBus::power(p[1], p[2]);
+  if (p[1] == 8 || p[1] == 9)   bus._drive = power;
+  if (p[1] == 10 || p[1] == 11) bus._turn = power;
+  if (bus._listener && needed == 4) bus._listener(p[0], p[1], p[2], doneUs, bus._context);
+}
+
+// ==========================
+//        MP3 TRIGGER
+// ==========================
+SimMp3Trigger::SimMp3Trigger() : triggers(0), _command(0), _listener(NULL), _context(NULL) {}
+
+void SimMp3Trigger::attach(HardwareSerial &port) {
+  port.setSink(onByte, this);
+}
+
+void SimMp3Trigger::onByte(uint8_t b, SimTime doneUs, void* context) {
+  SimMp3Trigger &mp3 = *(SimMp3Trigger*)context;
+
+  if (mp3._command == 0) {
+    if (b == 't' || b == 'p' || b == 'v') mp3._command = b;   // Two-byte commands
+    return;                                                    // 'O', 'F', 'R' need no argument
+  }
+
+  uint8_t command = mp3._command;
+  mp3._command = 0;
+  if (command == 't' || command == 'p') {
+    mp3.triggers++;
+    if (mp3._listener) mp3._listener(b, doneUs, mp3._context);
+  }
+}
+
+// ==========================
+//         MARCDUINO
+// ==========================
+SimMarcDuino::SimMarcDuino() : commands(0), _length(0), _listener(NULL), _context(NULL) {}
+
+void SimMarcDuino::attach(HardwareSerial &port) {
+  port.setSink(onByte, this);
+}
+
+void SimMarcDuino::onByte(uint8_t b, SimTime doneUs, void* context) {
+  SimMarcDuino &md = *(SimMarcDuino*)context;
+
+  if (b != '\r') {
+    if (md._length < sizeof(md._line) - 1) md._line[md._length++] = b;
+    return;
+  }
+  md._line[md._length] = '\0';
+  md._length = 0;
+  md.commands++;
+  if (md._listener) md._listener(md._line, doneUs, md._context);
+}
+
+// ==========================
+//         USB HOST
+// ==========================
+enum { USB_TEXT = 0, USB_SYNC2, USB_TYPE, USB_LENGTH, USB_FRAME };
+
+SimUsbHost::SimUsbHost()
+  : echo(false), capture(NULL), telemetryFrames(0), textBytes(0), _state(USB_TEXT), _remaining(0) {}
+
+void SimUsbHost::attach(HardwareSerial &port) {
+  port.setSink(onByte, this);
+}
+
+// Frame: 0xA5 0x5A | type | length | seq | payload | checksum (Telemetry.h)
+void SimUsbHost::onByte(uint8_t b, SimTime, void* context) {
+  SimUsbHost &usb = *(SimUsbHost*)context;
+  if (usb.capture) fputc(b, usb.capture);
+
+  switch (usb._state) {
+    case USB_TEXT:
+      if (b == 0xA5) { usb._state = USB_SYNC2; return; }
+      usb.textBytes++;
+      if (usb.echo && b != '\r') fputc(b, stderr);
+      return;
+    case USB_SYNC2:
+      usb._state = (b == 0x5A) ? USB_TYPE : USB_TEXT;
+      return;
+    case USB_TYPE:
+      usb._state = USB_LENGTH;
+      return;
+    case USB_LENGTH:
+      usb._remaining = b + 2;                   // seq + payload + checksum
+      usb._state = USB_FRAME;
+      return;
+    case USB_FRAME:
+      if (--usb._remaining == 0) {
+        usb.telemetryFrames++;
+        usb._state = USB_TEXT;
+      }
+      return;
+  }
+}
+
+// ==========================
+//      DOME + ENCODER
+// ==========================
+SimDome::SimDome(uint8_t pinA, uint8_t pinB, double countsPerDegree)
+  : connected(true), _pinA(pinA), _pinB(pinB), _countsPerDegree(countsPerDegree),
+    _power(0), _velocity(0), _position(0), _edges(0), _last(0) {
+  simAddSource(this);
+}
+
+void SimDome::setPower(int power) {
+  if (power == _power) return;
+  if (_power == 0 && _velocity == 0) _last = simNow();   // Waking up: no time has passed for the physics
+  _power = power;
+}
+
+SimTime SimDome::nextEventUs() {
+  if (_power == 0 && _velocity == 0) return SIM_NEVER;
+  return _last + SIM_DOME_STEP_US;
+}
+
+// Gray code A leads B for + counts: 00 → 10 → 11 → 01
+void SimDome::emitEdge(int direction) {
+  static const uint8_t phases[4] = { 0x0, 0x2, 0x3, 0x1 };
+  _edges += direction;
+  uint8_t phase = phases[_edges & 3];
+  if (!connected) return;
+  simSetPin(_pinA, (phase & 0x2) ? HIGH : LOW);
+  simSetPin(_pinB, (phase & 0x1) ? HIGH : LOW);
+}
+
+void SimDome::fireEvent(SimTime now) {
+  double dt = (double)(now - _last);
+  _last = now;
+
+  double target = 0;
+  if (abs(_power) >= SIM_DOME_STICTION_POWER) {
+    target = _power / 127.0 * SIM_DOME_FULL_SPEED_DEG_S * _countsPerDegree / 1e6;
+  }
+  _velocity += (target - _velocity) * (1.0 - exp(-dt / SIM_DOME_LAG_US));
+  if (target == 0 && fabs(_velocity) * 1e6 < 0.5) _velocity = 0;   // Under half a count per second: stopped
+  _position += _velocity * dt;
+
+  while (floor(_position) > _edges) emitEdge(1);
+  while (floor(_position) < _edges) emitEdge(-1);
+}
+
+// ==========================
+//       TRACE REPLAY
+// ==========================
+SimTracePlayer::SimTracePlayer() : replayEncoder(false), _next(0), _running(false), _start(0) {
+  for (uint8_t ch = 0; ch < PWM_CHANNEL_COUNT; ch++) {
+    _width[ch] = 0;
+    _pulse[ch] = SIM_NEVER;
+  }
+  simAddSource(this);
+}
+
+// One event per line: "<time_us> <channel 0-11 | E> <value>", '#' starts a comment
+bool SimTracePlayer::load(const char* path) {
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "cannot open trace %s\n", path);
+    return false;
+  }
+
+  char line[96];
+  unsigned long lineNo = 0;
+  while (fgets(line, sizeof(line), f)) {
+    lineNo++;
+    if (line[0] == '#' || line[0] == '\n') continue;
+
+    unsigned long long at;
+    char channel[4];
+    int value;
+    if (sscanf(line, "%llu %3s %d", &at, channel, &value) != 3) {
+      fprintf(stderr, "%s:%lu: bad trace line\n", path, lineNo);
+      fclose(f);
+      return false;
+    }
+    int ch = (channel[0] == 'E') ? SIM_TRACE_ENCODER : atoi(channel);
+    if (ch >= PWM_CHANNEL_COUNT) continue;
+    _events.push_back({ at, (int8_t)ch, value });
+  }
+  fclose(f);
+
+  std::stable_sort(_events.begin(), _events.end(),
+                   [](const SimTraceEvent &a, const SimTraceEvent &b) { return a.atUs < b.atUs; });
+  return true;
+}
+
+void SimTracePlayer::start(SimTime at) {
+  _start   = at;
+  _next    = 0;
+  _running = true;
+}
+
+SimTime SimTracePlayer::nextEventUs() {
+  if (!_running) return SIM_NEVER;
+  SimTime best = (_next < _events.size()) ? _start + _events[_next].atUs : SIM_NEVER;
+  for (uint8_t ch = 0; ch < PWM_CHANNEL_COUNT; ch++) {
+    if (_pulse[ch] < best) best = _pulse[ch];
+  }
+  return best;
+}
+
+void SimTracePlayer::fireEvent(SimTime now) {
+  while (_next < _events.size() && _start + _events[_next].atUs <= now) {
+    const SimTraceEvent &e = _events[_next++];
+    if (e.channel == SIM_TRACE_ENCODER) {
+      if (replayEncoder) encoderTicks += e.value;
+      continue;
+    }
+    _width[e.channel] = e.value;
+    _pulse[e.channel] = (e.value > 0) ? now : SIM_NEVER;   // New width: its edge is now
+  }
+
+  for (uint8_t ch = 0; ch < PWM_CHANNEL_COUNT; ch++) {
+    if (_pulse[ch] > now) continue;
+    storePWMChannel(ch, _width[ch], micros());
+    _pulse[ch] += SIM_RC_PERIOD_US;
+  }
+}
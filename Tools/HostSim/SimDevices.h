@@ -0,0 +1,216 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║              SimDevices.h - Shadow-RC HostSim              ║
+  ║────────────────────────────────────────────────────────────║
+  ║ The hardware around the Mega: two PWM receivers driving    ║
+  ║ pin edges, and the devices listening on each UART          ║
+  ║ (Sabertooth / SyRen, MP3 Trigger, MarcDuino, USB).         ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you are adding a simulated device.      ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef HOSTSIM_DEVICES_H
+#define HOSTSIM_DEVICES_H
+
+#include <stdio.h>
+#include <vector>
+#include "SimCore.h"
+#include "PWMInputHandler.h"
+
+// ==========================
+//        RC RECEIVER
+// ==========================
+#define SIM_RECEIVER_CHANNELS  6
+#define SIM_RC_PERIOD_US       20000   // 50 Hz frames
+#define SIM_RC_SLOT_US         2200    // Channel N rises N slots after the frame start
+
+// Receiver A on pins 2, 3, 22, 24, 26, 28; B on A8, 23, 25, 27, 29, 31
+extern const uint8_t simReceiverPinsA[SIM_RECEIVER_CHANNELS];
+extern const uint8_t simReceiverPinsB[SIM_RECEIVER_CHANNELS];
+
+// Called on every falling edge with the width of the pulse that just ended
+typedef void (*SimPulseListener)(uint8_t receiver, uint8_t channel, int widthUs, SimTime fallUs, void* context);
+
+class SimReceiver : public SimEventSource {
+public:
+  SimReceiver(uint8_t id, const uint8_t* pins, SimTime phaseUs);
+
+  void setWidth(uint8_t channel, int widthUs);   // Latched at that channel's next rising edge; 0 = silent
+  int  width(uint8_t channel) const { return _target[channel]; }
+  void setListener(SimPulseListener listener, void* context) { _listener = listener; _context = context; }
+
+  SimTime nextEventUs();
+  void    fireEvent(SimTime now);
+
+private:
+  uint8_t          _id;
+  const uint8_t*   _pins;
+  int              _target[SIM_RECEIVER_CHANNELS];
+  int              _latched[SIM_RECEIVER_CHANNELS];
+  bool             _high[SIM_RECEIVER_CHANNELS];
+  SimTime          _rise[SIM_RECEIVER_CHANNELS];     // Current / next rising edge
+  SimPulseListener _listener;
+  void*            _context;
+
+  SimTime edgeTime(uint8_t channel) const;
+};
+
+// ==========================
+//      SERIAL DEVICES
+// ==========================
+// Decodes Packet Serial on Serial2: address, command, value, 7-bit checksum.
+// Get requests are answered on the same port like a 2x32: current ~0.2 A per
+// unit of motor power, the battery sagging 0.1 V per amp from 25.2 V.
+typedef void (*SimMotorListener)(uint8_t address, uint8_t command, uint8_t value, SimTime doneUs, void* context);
+
+class SimSabertoothBus {
+public:
+  SimSabertoothBus();
+  void attach(HardwareSerial &port);
+  void setListener(SimMotorListener listener, void* context) { _listener = listener; _context = context; }
+
+  unsigned long packets[2];      // Good packets to 128 / 129
+  unsigned long badChecksums;
+  unsigned long syncBytes;       // 0xAA autobaud bytes
+  unsigned long replies;         // Get requests answered
+
+  static int power(uint8_t command, uint8_t value);   // Signed -127..127 for motor / drive / turn commands
+
+private:
+  uint8_t          _packet[7];
+  uint8_t          _length;
+  HardwareSerial*  _port;
+  int              _drive, _turn;   // Last mixed-mode commands, for the current model
+  SimMotorListener _listener;
+  void*            _context;
+
+  void reply(uint8_t address, uint8_t type, uint8_t targetType, uint8_t targetNumber);
+  static void onByte(uint8_t b, SimTime doneUs, void* context);
+};
+
+// SparkFun MP3 Trigger on Serial1: 't' / 'p' / 'v' + one byte, or one-byte commands
+typedef void (*SimTrackListener)(uint8_t track, SimTime doneUs, void* context);
+
+class SimMp3Trigger {
+public:
+  SimMp3Trigger();
+  void attach(HardwareSerial &port);
+  void setListener(SimTrackListener listener, void* context) { _listener = listener; _context = context; }
+
+  unsigned long triggers;
+
+private:
+  uint8_t          _command;
+  SimTrackListener _listener;
+  void*            _context;
+
+  static void onByte(uint8_t b, SimTime doneUs, void* context);
+};
+
+// MarcDuino on Serial3: one ":SExx\r" command per line
+typedef void (*SimLineListener)(const char* line, SimTime doneUs, void* context);
+
+class SimMarcDuino {
+public:
+  SimMarcDuino();
+  void attach(HardwareSerial &port);
+  void setListener(SimLineListener listener, void* context) { _listener = listener; _context = context; }
+
+  unsigned long commands;
+
+private:
+  char            _line[32];
+  uint8_t         _length;
+  SimLineListener _listener;
+  void*           _context;
+
+  static void onByte(uint8_t b, SimTime doneUs, void* context);
+};
+
+// USB: splits binary telemetry frames from console text
+class SimUsbHost {
+public:
+  SimUsbHost();
+  void attach(HardwareSerial &port);
+
+  bool          echo;             // Print console text to stderr
+  FILE*         capture;          // Raw copy of every byte (telemetry_decode.py input)
+  unsigned long telemetryFrames;
+  unsigned long textBytes;
+
+private:
+  uint8_t _state;
+  uint8_t _remaining;
+
+  static void onByte(uint8_t b, SimTime doneUs, void* context);
+};
+
+// ==========================
+//      DOME + ENCODER
+// ==========================
+// SyRen power → dome speed with a first-order lag, and the quadrature
+// edges that motion makes on the encoder pins
+#define SIM_DOME_FULL_SPEED_DEG_S  300     // Dome speed at power 127
+#define SIM_DOME_STICTION_POWER    8       // |power| below this does not turn the dome
+#define SIM_DOME_LAG_US            60000   // Motor + dome inertia time constant
+#define SIM_DOME_STEP_US           250     // Physics step while moving
+
+class SimDome : public SimEventSource {
+public:
+  SimDome(uint8_t pinA, uint8_t pinB, double countsPerDegree);
+
+  void   setPower(int power);     // From the SyRen packets on Serial2
+  double angle() const { return _position / _countsPerDegree; }
+  bool   connected;               // false = encoder pins stay still
+
+  SimTime nextEventUs();
+  void    fireEvent(SimTime now);
+
+private:
+  uint8_t _pinA, _pinB;
+  double  _countsPerDegree;
+  int     _power;
+  double  _velocity;              // Counts per µs
+  double  _position;              // Counts, fractional
+  long    _edges;                 // Whole counts put on the pins
+  SimTime _last;
+
+  void emitEdge(int direction);
+};
+
+// ==========================
+//       TRACE REPLAY
+// ==========================
+// Plays a `telemetry_decode.py --trace` file through storePWMChannel(),
+// repeating each width every SIM_RC_PERIOD_US like a receiver would
+#define SIM_TRACE_ENCODER  -1     // SimTraceEvent.channel for encoder deltas
+
+struct SimTraceEvent {
+  SimTime atUs;                   // Relative to the start of the trace
+  int8_t  channel;                // 0–11, or SIM_TRACE_ENCODER
+  int     value;                  // Width in µs (0 = signal lost) or tick delta
+};
+
+class SimTracePlayer : public SimEventSource {
+public:
+  SimTracePlayer();
+  bool    replayEncoder;                   // Apply recorded encoder deltas (else SimDome counts)
+  bool    load(const char* path);          // false (with a message on stderr) if unreadable
+  void    start(SimTime at);               // Trace time 0 plays at this virtual time
+  SimTime lengthUs() const { return _events.empty() ? 0 : _events.back().atUs; }
+  size_t  eventCount() const { return _events.size(); }
+
+  SimTime nextEventUs();
+  void    fireEvent(SimTime now);
+
+private:
+  std::vector<SimTraceEvent> _events;
+  size_t  _next;
+  bool    _running;
+  SimTime _start;
+  int     _width[PWM_CHANNEL_COUNT];
+  SimTime _pulse[PWM_CHANNEL_COUNT];                      // Next repeat of each channel, SIM_NEVER = silent
+};
+
+#endif
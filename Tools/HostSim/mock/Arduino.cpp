@@ -0,0 +1,478 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║              Arduino.cpp (host mock) - Shadow-RC HostSim           ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Virtual clock, pins, external interrupts, Timer3, the watchdog,   ║
+  ║ EEPROM and UARTs for running the sketch on a desktop.             ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  HOW IT WORKS:
+  ─────────────────────────────────────────────────────────────────────
+  - Time never moves on its own. `simAdvanceTo()` walks the event
+    sources in time order (receiver edges, Timer3 compares, UART
+    byte completions), sets the clock to each event and fires it.
+  - `delay()`, `pulseIn()` and a `write()` into a full TX ring all
+    advance the clock the same way, so ISRs keep running inside
+    them just as they would on the Mega. `sleep_cpu()` runs to the
+    next event, or the next Timer0 overflow (1024 µs) if none comes
+    before it.
+  - Pin numbering, ports and INTn numbers follow the Mega 2560.
+  - The watchdog counts virtual time from the last `wdt_reset()`: in
+    interrupt mode it calls WDT_vect, otherwise it sets WDRF and tells
+    the reset listener. EEPROM starts erased on every run.
+  - `random()` is a fixed LCG so every run is repeatable.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `Tools/HostSim/mock/Arduino.cpp`
+  Header:    `Tools/HostSim/mock/Arduino.h`, `Tools/HostSim/SimCore.h`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include <Arduino.h>
+#include <avr/wdt.h>
+#include <avr/sleep.h>
+#include <EEPROM.h>
+#include "../SimCore.h"
+
+// ==========================
+//        REGISTERS
+// ==========================
+volatile uint8_t simPinRegs[SIM_PORT_COUNT];
+volatile uint8_t simDdrRegs[SIM_PORT_COUNT];
+volatile uint8_t simPortRegs[SIM_PORT_COUNT];
+volatile uint8_t TCCR3A, TCCR3B, TIMSK3, TIFR3;
+volatile uint16_t TCNT3, OCR3A, OCR3B;
+volatile uint8_t SREG;
+volatile uint8_t PCICR, PCIFR, PCMSK0, PCMSK1, PCMSK2;
+volatile uint8_t MCUSR = _BV(PORF);           // Every run is a power-up
+volatile uint8_t WDTCSR;
+
+extern "C" void TIMER3_COMPA_vect(void) __attribute__((weak));
+extern "C" void PCINT0_vect(void) __attribute__((weak));
+extern "C" void PCINT1_vect(void) __attribute__((weak));
+extern "C" void PCINT2_vect(void) __attribute__((weak));
+extern "C" void WDT_vect(void) __attribute__((weak));
+
+// ==========================
+//       MEGA PIN MAP
+// ==========================
+#define SIM_PIN_COUNT 70
+
+#define P(port, bit) (uint8_t)(((port) << 3) | (bit))
+static const uint8_t pinMap[SIM_PIN_COUNT] = {
+  P(SIM_PORT_E,0), P(SIM_PORT_E,1), P(SIM_PORT_E,4), P(SIM_PORT_E,5), P(SIM_PORT_G,5),   // 0–4
+  P(SIM_PORT_E,3), P(SIM_PORT_H,3), P(SIM_PORT_H,4), P(SIM_PORT_H,5), P(SIM_PORT_H,6),   // 5–9
+  P(SIM_PORT_B,4), P(SIM_PORT_B,5), P(SIM_PORT_B,6), P(SIM_PORT_B,7), P(SIM_PORT_J,1),   // 10–14
+  P(SIM_PORT_J,0), P(SIM_PORT_H,1), P(SIM_PORT_H,0), P(SIM_PORT_D,3), P(SIM_PORT_D,2),   // 15–19
+  P(SIM_PORT_D,1), P(SIM_PORT_D,0), P(SIM_PORT_A,0), P(SIM_PORT_A,1), P(SIM_PORT_A,2),   // 20–24
+  P(SIM_PORT_A,3), P(SIM_PORT_A,4), P(SIM_PORT_A,5), P(SIM_PORT_A,6), P(SIM_PORT_A,7),   // 25–29
+  P(SIM_PORT_C,7), P(SIM_PORT_C,6), P(SIM_PORT_C,5), P(SIM_PORT_C,4), P(SIM_PORT_C,3),   // 30–34
+  P(SIM_PORT_C,2), P(SIM_PORT_C,1), P(SIM_PORT_C,0), P(SIM_PORT_D,7), P(SIM_PORT_G,2),   // 35–39
+  P(SIM_PORT_G,1), P(SIM_PORT_G,0), P(SIM_PORT_L,7), P(SIM_PORT_L,6), P(SIM_PORT_L,5),   // 40–44
+  P(SIM_PORT_L,4), P(SIM_PORT_L,3), P(SIM_PORT_L,2), P(SIM_PORT_L,1), P(SIM_PORT_L,0),   // 45–49
+  P(SIM_PORT_B,3), P(SIM_PORT_B,2), P(SIM_PORT_B,1), P(SIM_PORT_B,0),                    // 50–53
+  P(SIM_PORT_F,0), P(SIM_PORT_F,1), P(SIM_PORT_F,2), P(SIM_PORT_F,3),                    // A0–A3
+  P(SIM_PORT_F,4), P(SIM_PORT_F,5), P(SIM_PORT_F,6), P(SIM_PORT_F,7),                    // A4–A7
+  P(SIM_PORT_K,0), P(SIM_PORT_K,1), P(SIM_PORT_K,2), P(SIM_PORT_K,3),                    // A8–A11
+  P(SIM_PORT_K,4), P(SIM_PORT_K,5), P(SIM_PORT_K,6), P(SIM_PORT_K,7)                     // A12–A15
+};
+#undef P
+
+uint8_t digitalPinToPort(uint8_t pin)    { return pin < SIM_PIN_COUNT ? pinMap[pin] >> 3 : 0; }
+uint8_t digitalPinToBitMask(uint8_t pin) { return pin < SIM_PIN_COUNT ? 1 << (pinMap[pin] & 7) : 0; }
+
+// Pin-change bank per pin, -1 = none (as the Mega core's pins_arduino.h)
+static int pcintBank(uint8_t pin) {
+  uint8_t port = digitalPinToPort(pin);
+  if (port == SIM_PORT_B) return 0;
+  if (pin == 0 || pin == 14 || pin == 15) return 1;
+  if (port == SIM_PORT_K) return 2;
+  return -1;
+}
+
+volatile uint8_t* digitalPinToPCICR(uint8_t pin) { return pcintBank(pin) < 0 ? NULL : &PCICR; }
+uint8_t digitalPinToPCICRbit(uint8_t pin)       { return pcintBank(pin) < 0 ? 0 : pcintBank(pin); }
+
+volatile uint8_t* digitalPinToPCMSK(uint8_t pin) {
+  switch (pcintBank(pin)) {
+    case 0: return &PCMSK0;
+    case 1: return &PCMSK1;
+    case 2: return &PCMSK2;
+  }
+  return NULL;
+}
+
+uint8_t digitalPinToPCMSKbit(uint8_t pin) {
+  if (pin == 0)  return 0;                      // PE0  = PCINT8
+  if (pin == 15) return 1;                      // PJ0  = PCINT9
+  if (pin == 14) return 2;                      // PJ1  = PCINT10
+  return pinMap[pin] & 7;                       // Ports B and K: PCINT bit = port bit
+}
+
+static uint8_t pinLevel[SIM_PIN_COUNT];
+static int     analogValue[SIM_PIN_COUNT];
+
+// ==========================
+//      EVENT SOURCES
+// ==========================
+#define SIM_MAX_SOURCES 16
+
+static SimEventSource* sources[SIM_MAX_SOURCES];
+static uint8_t sourceCount = 0;
+static SimTime clockUs = 0;
+
+void simAddSource(SimEventSource* source) {
+  if (sourceCount < SIM_MAX_SOURCES) sources[sourceCount++] = source;
+}
+
+// Timer3 free-runs from power-up at the prescaler in TCCR3B
+static const unsigned long timer3Prescale[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+
+static SimTime timer3Ticks(SimTime t, unsigned long prescale) {
+  return t * (F_CPU / 1000000UL) / prescale;
+}
+
+static void setClock(SimTime t) {
+  clockUs = t;
+  unsigned long prescale = timer3Prescale[TCCR3B & 7];
+  if (prescale) TCNT3 = (uint16_t)timer3Ticks(t, prescale);
+}
+
+class Timer3Compare : public SimEventSource {
+public:
+  SimTime lastFireTick = SIM_NEVER;
+
+  SimTime nextEventUs() {
+    unsigned long prescale = timer3Prescale[TCCR3B & 7];
+    if (!prescale || !(TIMSK3 & _BV(OCIE3A)) || !TIMER3_COMPA_vect) return SIM_NEVER;
+
+    SimTime now   = timer3Ticks(clockUs, prescale);
+    SimTime match = now + (uint16_t)(OCR3A - (uint16_t)now);
+    if (match == lastFireTick) match += 65536;     // Just fired on this tick
+    SimTime ticksPerUsNum = F_CPU / 1000000UL;
+    nextTick = match;
+    return (match * prescale + ticksPerUsNum - 1) / ticksPerUsNum;   // First µs at or after the match
+  }
+
+  void fireEvent(SimTime now) {
+    lastFireTick = nextTick;
+    TIMER3_COMPA_vect();
+  }
+
+private:
+  SimTime nextTick = 0;
+};
+
+static Timer3Compare timer3Compare;
+
+// Interrupt mode (WDIE) calls WDT_vect; with WDE also set, hardware clears
+// WDIE first so the next timeout is a reset
+class WatchdogTimer : public SimEventSource {
+public:
+  SimTime          lastResetUs = 0;
+  SimResetListener listener = NULL;
+
+  SimTime nextEventUs() {
+    if (!(WDTCSR & (_BV(WDE) | _BV(WDIE)))) return SIM_NEVER;
+    uint8_t prescale = (WDTCSR & 7) | ((WDTCSR & _BV(WDP3)) ? 8 : 0);
+    return lastResetUs + (16000ULL << prescale);
+  }
+
+  void fireEvent(SimTime now) {
+    lastResetUs = now;
+    if ((WDTCSR & _BV(WDIE)) && WDT_vect) {
+      if (WDTCSR & _BV(WDE)) WDTCSR &= ~_BV(WDIE);
+      WDT_vect();
+      return;
+    }
+    MCUSR |= _BV(WDRF);
+    WDTCSR = _BV(WDE);                          // Restarts with the watchdog on at 16 ms
+    if (listener) listener(now);
+  }
+};
+
+static WatchdogTimer watchdog;
+
+class SerialSource : public SimEventSource {
+public:
+  explicit SerialSource(HardwareSerial* port) : port(port) {}
+  SimTime nextEventUs()         { return port->nextTxDoneUs(); }
+  void    fireEvent(SimTime now) { port->serviceTx(now); }
+private:
+  HardwareSerial* port;
+};
+
+static bool coreSourcesAdded = false;
+static void addCoreSources() {
+  if (coreSourcesAdded) return;
+  coreSourcesAdded = true;
+  static SerialSource s0(&Serial), s1(&Serial1), s2(&Serial2), s3(&Serial3);
+  simAddSource(&timer3Compare);
+  simAddSource(&watchdog);
+  simAddSource(&s0);
+  simAddSource(&s1);
+  simAddSource(&s2);
+  simAddSource(&s3);
+}
+
+// ==========================
+//          CLOCK
+// ==========================
+SimTime simNow() { return clockUs; }
+
+bool simStep(SimTime limit) {
+  addCoreSources();
+
+  SimEventSource* pick = NULL;
+  SimTime best = SIM_NEVER;
+  for (uint8_t i = 0; i < sourceCount; i++) {
+    SimTime t = sources[i]->nextEventUs();
+    if (t < best) { best = t; pick = sources[i]; }
+  }
+  if (!pick || best > limit) return false;
+
+  if (best > clockUs) setClock(best);
+  pick->fireEvent(clockUs);
+  return true;
+}
+
+void simAdvanceTo(SimTime t) {
+  while (simStep(t)) {}
+  if (t > clockUs) setClock(t);
+}
+
+unsigned long micros() { return (unsigned long)(clockUs & ~3ULL); }
+unsigned long millis() { return (unsigned long)(clockUs / 1000); }
+void delay(unsigned long ms)              { simAdvanceTo(clockUs + ms * 1000ULL); }
+void delayMicroseconds(unsigned int us)   { simAdvanceTo(clockUs + us); }
+
+// ==========================
+//           PINS
+// ==========================
+static void refreshPort(uint8_t port) {
+  uint8_t v = 0;
+  for (uint8_t p = 0; p < SIM_PIN_COUNT; p++) {
+    if ((pinMap[p] >> 3) == port && pinLevel[p]) v |= 1 << (pinMap[p] & 7);
+  }
+  simPinRegs[port] = v;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= SIM_PIN_COUNT) return;
+  if (mode == OUTPUT) simDdrRegs[digitalPinToPort(pin)] |= digitalPinToBitMask(pin);
+  else                simDdrRegs[digitalPinToPort(pin)] &= ~digitalPinToBitMask(pin);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin >= SIM_PIN_COUNT) return;
+  pinLevel[pin] = value ? HIGH : LOW;
+  refreshPort(digitalPinToPort(pin));
+}
+
+int digitalRead(uint8_t pin)        { return pin < SIM_PIN_COUNT ? pinLevel[pin] : LOW; }
+int analogRead(uint8_t pin)         { return pin < SIM_PIN_COUNT ? analogValue[pin] : 0; }
+void analogWrite(uint8_t, int)      {}
+void simSetAnalog(uint8_t pin, int value) { if (pin < SIM_PIN_COUNT) analogValue[pin] = value; }
+uint8_t simGetPin(uint8_t pin)      { return digitalRead(pin); }
+
+// ==========================
+//    EXTERNAL INTERRUPTS
+// ==========================
+#define SIM_EXT_INTERRUPTS 6
+
+struct ExtInterrupt { void (*isr)(void); int mode; };
+static ExtInterrupt extInterrupts[SIM_EXT_INTERRUPTS];
+
+int digitalPinToInterrupt(uint8_t pin) {
+  switch (pin) {
+    case 2:  return 0;
+    case 3:  return 1;
+    case 21: return 2;
+    case 20: return 3;
+    case 19: return 4;
+    case 18: return 5;
+  }
+  return NOT_AN_INTERRUPT;
+}
+
+void attachInterrupt(uint8_t num, void (*isr)(void), int mode) {
+  if (num < SIM_EXT_INTERRUPTS) { extInterrupts[num].isr = isr; extInterrupts[num].mode = mode; }
+}
+
+void detachInterrupt(uint8_t num) {
+  if (num < SIM_EXT_INTERRUPTS) extInterrupts[num].isr = NULL;
+}
+
+void simSetPin(uint8_t pin, uint8_t level) {
+  if (pin >= SIM_PIN_COUNT) return;
+  level = level ? HIGH : LOW;
+  if (pinLevel[pin] == level) return;
+  pinLevel[pin] = level;
+  refreshPort(digitalPinToPort(pin));
+
+  int bank = pcintBank(pin);
+  if (bank >= 0 && (PCICR & _BV(bank)) && (*digitalPinToPCMSK(pin) & _BV(digitalPinToPCMSKbit(pin)))) {
+    void (*vector)(void) = bank == 0 ? PCINT0_vect : bank == 1 ? PCINT1_vect : PCINT2_vect;
+    if (vector) vector();
+  }
+
+  int num = digitalPinToInterrupt(pin);
+  if (num < 0 || !extInterrupts[num].isr) return;
+  int mode = extInterrupts[num].mode;
+  if (mode == CHANGE || (mode == RISING && level) || (mode == FALLING && !level)) extInterrupts[num].isr();
+}
+
+// Blocking, like the real one: lets virtual time run until the pulse ends
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout) {
+  SimTime deadline = clockUs + timeout;
+  while (digitalRead(pin) == state) if (!simStep(deadline)) return 0;   // Finish the pulse in progress
+  while (digitalRead(pin) != state) if (!simStep(deadline)) return 0;
+  SimTime start = clockUs;
+  while (digitalRead(pin) == state) if (!simStep(deadline)) return 0;
+  return (unsigned long)(clockUs - start);
+}
+
+// ==========================
+//     WATCHDOG + EEPROM
+// ==========================
+void wdt_enable(uint8_t timeout) {
+  WDTCSR = _BV(WDE) | (timeout & 7) | ((timeout & 8) ? _BV(WDP3) : 0);
+  watchdog.lastResetUs = clockUs;
+}
+
+void wdt_disable() { WDTCSR = 0; }
+void wdt_reset()   { watchdog.lastResetUs = clockUs; }
+void simSetResetListener(SimResetListener listener) { watchdog.listener = listener; }
+
+// ==========================
+//          SLEEP
+// ==========================
+// Idle sleep: any interrupt wakes it. Timer0 is not simulated as an
+// event, so its overflow is the latest wake-up.
+void set_sleep_mode(uint8_t) {}
+void sleep_enable()  {}
+void sleep_disable() {}
+
+void sleep_cpu() {
+  SimTime overflow = (clockUs / 1024 + 1) * 1024;
+  if (!simStep(overflow)) setClock(overflow);
+}
+
+EEPROMClass EEPROM;
+
+EEPROMClass::EEPROMClass() : writes(0) { memset(_cells, 0xFF, sizeof(_cells)); }
+
+uint8_t EEPROMClass::read(int address) const {
+  return (address >= 0 && address < SIM_EEPROM_SIZE) ? _cells[address] : 0xFF;
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  if (address < 0 || address >= SIM_EEPROM_SIZE) return;
+  _cells[address] = value;
+  writes++;
+}
+
+// ==========================
+//          MISC
+// ==========================
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+static unsigned long randomState = 1;
+void randomSeed(unsigned long seed) { if (seed) randomState = seed; }
+long random(long howBig) {
+  if (howBig <= 0) return 0;
+  randomState = randomState * 1103515245UL + 12345UL;
+  return (long)((randomState >> 16) & 0x7FFF) % howBig;
+}
+long random(long howSmall, long howBig) {
+  return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+// ==========================
+//          UARTS
+// ==========================
+HardwareSerial Serial("Serial"), Serial1("Serial1"), Serial2("Serial2"), Serial3("Serial3");
+
+HardwareSerial::HardwareSerial(const char* name)
+  : bytesSent(0), busyUs(0), blockedUs(0), blockedWrites(0),
+    _name(name), _baud(9600), _byteUs(1042), _sink(NULL), _sinkContext(NULL),
+    _txHead(0), _txCount(0), _shifting(false), _shiftByte(0), _shiftDoneUs(0),
+    _rxHead(0), _rxCount(0) {}
+
+void HardwareSerial::begin(unsigned long baud, uint8_t config) {
+  unsigned long bits = (config == SERIAL_8E2) ? 12 : 10;
+  _baud   = baud ? baud : 9600;
+  _byteUs = (bits * 1000000UL + _baud / 2) / _baud;
+  if (_byteUs == 0) _byteUs = 1;
+}
+
+void HardwareSerial::startNextByte(SimTime at) {
+  if (_txCount == 0) { _shifting = false; return; }
+  _shiftByte   = _tx[_txHead];
+  _txHead      = (_txHead + 1) % SERIAL_TX_BUFFER_SIZE;
+  _txCount--;
+  _shifting    = true;
+  _shiftDoneUs = at + _byteUs;
+}
+
+SimTime HardwareSerial::nextTxDoneUs() const {
+  return _shifting ? _shiftDoneUs : SIM_NEVER;
+}
+
+void HardwareSerial::serviceTx(SimTime now) {
+  while (_shifting && _shiftDoneUs <= now) {
+    SimTime done = _shiftDoneUs;
+    bytesSent++;
+    busyUs += _byteUs;
+    if (_sink) _sink(_shiftByte, done, _sinkContext);
+    startNextByte(done);
+  }
+}
+
+size_t HardwareSerial::write(uint8_t b) {
+  if (_txCount >= SERIAL_TX_BUFFER_SIZE - 1) {     // Ring full: the AVR core spins here
+    SimTime start = simNow();
+    blockedWrites++;
+    while (_txCount >= SERIAL_TX_BUFFER_SIZE - 1) simAdvanceTo(_shiftDoneUs);
+    blockedUs += simNow() - start;
+  }
+  _tx[(_txHead + _txCount) % SERIAL_TX_BUFFER_SIZE] = b;
+  _txCount++;
+  if (!_shifting) startNextByte(simNow());
+  return 1;
+}
+
+int HardwareSerial::availableForWrite() {
+  return (SERIAL_TX_BUFFER_SIZE - 1) - _txCount;
+}
+
+void HardwareSerial::flush() {
+  SimTime start = simNow();
+  while (_shifting) simAdvanceTo(_shiftDoneUs);
+  blockedUs += simNow() - start;
+}
+
+void HardwareSerial::injectRx(const uint8_t* data, size_t size) {
+  while (size--) {
+    if (_rxCount >= sizeof(_rx)) return;             // Overrun: drop, like the real ring
+    _rx[(_rxHead + _rxCount) % sizeof(_rx)] = *data++;
+    _rxCount++;
+  }
+}
+
+int HardwareSerial::available() { return _rxCount; }
+
+int HardwareSerial::peek() { return _rxCount ? _rx[_rxHead] : -1; }
+
+int HardwareSerial::read() {
+  if (!_rxCount) return -1;
+  uint8_t b = _rx[_rxHead];
+  _rxHead = (_rxHead + 1) % sizeof(_rx);
+  _rxCount--;
+  return b;
+}
@@ -0,0 +1,270 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║           Arduino.h (host mock) - Shadow-RC HostSim        ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Just enough of the Arduino / AVR API to build the sketch   ║
+  ║ on a desktop. Time is virtual: it only moves when the      ║
+  ║ simulator advances it (see SimCore.h).                     ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless the firmware starts using a new API.    ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef HOSTSIM_ARDUINO_H
+#define HOSTSIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <avr/pgmspace.h>    // Pulled in by the real Arduino.h too
+
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+#define F_CPU 16000000UL
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+// ---------- Constants ----------
+#define HIGH          1
+#define LOW           0
+#define INPUT         0
+#define OUTPUT        1
+#define INPUT_PULLUP  2
+#define CHANGE        1
+#define FALLING       2
+#define RISING        3
+#define LED_BUILTIN   13
+#define DEC           10
+#define HEX           16
+#define B01111111     127
+#define NOT_AN_INTERRUPT  -1
+
+// Analog pins A0–A15 are digital 54–69 on the Mega
+static const uint8_t A0 = 54, A1 = 55, A2 = 56, A3 = 57, A4 = 58, A5 = 59, A6 = 60, A7 = 61;
+static const uint8_t A8 = 62, A9 = 63, A10 = 64, A11 = 65, A12 = 66, A13 = 67, A14 = 68, A15 = 69;
+
+#define SERIAL_8N1    0x06
+#define SERIAL_8E2    0x2E
+#define SERIAL_TX_BUFFER_SIZE  64
+#define SERIAL_RX_BUFFER_SIZE  64
+
+// ---------- Helpers ----------
+#define min(a, b)            ((a) < (b) ? (a) : (b))
+#define max(a, b)            ((a) > (b) ? (a) : (b))
+#define abs(x)               ((x) > 0 ? (x) : -(x))
+#define constrain(x, lo, hi) ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+#define _BV(b)               (1u << (b))
+#define bit(b)               (1ul << (b))
+#define bitRead(v, b)        (((v) >> (b)) & 1)
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+// ---------- Time (virtual) ----------
+unsigned long millis();
+unsigned long micros();                  // 4 µs steps, like a 16 MHz Mega
+void delay(unsigned long ms);            // Advances virtual time; ISRs keep firing
+void delayMicroseconds(unsigned int us);
+
+// ---------- Pins ----------
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int  digitalRead(uint8_t pin);
+int  analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout = 1000000UL);
+
+// ---------- Interrupts ----------
+// Single-threaded: ISRs only run while the simulator advances time
+// (between loop() passes, inside delay(), blocking writes and pulseIn()).
+inline void cli() {}
+inline void sei() {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+#define ISR(vector) extern "C" void vector(void)
+
+int  digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t interruptNum, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+
+// ---------- AVR Registers ----------
+// Ports A..L (no I). PINx reflects the simulated pin levels.
+enum { SIM_PORT_A = 0, SIM_PORT_B, SIM_PORT_C, SIM_PORT_D, SIM_PORT_E, SIM_PORT_F,
+       SIM_PORT_G, SIM_PORT_H, SIM_PORT_J, SIM_PORT_K, SIM_PORT_L, SIM_PORT_COUNT };
+
+extern volatile uint8_t simPinRegs[SIM_PORT_COUNT];
+extern volatile uint8_t simDdrRegs[SIM_PORT_COUNT];
+extern volatile uint8_t simPortRegs[SIM_PORT_COUNT];
+
+#define PINA  simPinRegs[SIM_PORT_A]
+#define PINB  simPinRegs[SIM_PORT_B]
+#define PINC  simPinRegs[SIM_PORT_C]
+#define PIND  simPinRegs[SIM_PORT_D]
+#define PINE  simPinRegs[SIM_PORT_E]
+#define PINF  simPinRegs[SIM_PORT_F]
+#define PING  simPinRegs[SIM_PORT_G]
+#define PINH  simPinRegs[SIM_PORT_H]
+#define PINJ  simPinRegs[SIM_PORT_J]
+#define PINK  simPinRegs[SIM_PORT_K]
+#define PINL  simPinRegs[SIM_PORT_L]
+#define PORTA simPortRegs[SIM_PORT_A]
+#define PORTC simPortRegs[SIM_PORT_C]
+#define PORTK simPortRegs[SIM_PORT_K]
+#define DDRK  simDdrRegs[SIM_PORT_K]
+
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+#define portInputRegister(port)   (&simPinRegs[(port)])
+#define portOutputRegister(port)  (&simPortRegs[(port)])
+
+// Timer3: TCNT3 follows virtual time at the prescaler set in TCCR3B;
+// the OCR3A compare fires TIMER3_COMPA_vect when OCIE3A is set.
+extern volatile uint8_t  TCCR3A, TCCR3B, TIMSK3, TIFR3;
+extern volatile uint16_t TCNT3, OCR3A, OCR3B;
+#define CS30    0
+#define CS31    1
+#define CS32    2
+#define TOIE3   0
+#define OCIE3A  1
+#define OCIE3B  2
+#define OCF3A   1
+#define OCF3B   2
+
+// Pin-change banks: PCINT0 = port B, PCINT1 = PE0 + PJ0/PJ1, PCINT2 = port K.
+// A level change on an unmasked pin of an enabled bank calls PCINTn_vect.
+extern volatile uint8_t PCICR, PCIFR, PCMSK0, PCMSK1, PCMSK2;
+#define PCIE0   0
+#define PCIE1   1
+#define PCIE2   2
+volatile uint8_t* digitalPinToPCICR(uint8_t pin);    // NULL = no pin-change interrupt
+uint8_t           digitalPinToPCICRbit(uint8_t pin);
+volatile uint8_t* digitalPinToPCMSK(uint8_t pin);
+uint8_t           digitalPinToPCMSKbit(uint8_t pin);
+
+// Reset flags and watchdog control. MCUSR reads PORF at the start of a
+// run; the simulated watchdog (Arduino.cpp) sets WDRF when it resets.
+extern volatile uint8_t MCUSR, WDTCSR;
+#define PORF    0
+#define EXTRF   1
+#define BORF    2
+#define WDRF    3
+#define WDP0    0
+#define WDE     3
+#define WDCE    4
+#define WDP3    5
+#define WDIE    6
+#define WDIF    7
+
+extern volatile uint8_t SREG;
+
+// ---------- Serial ----------
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper*)(s))
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t b) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char* s)                { return write((const uint8_t*)s, strlen(s)); }
+  size_t write(const char* s, size_t size)   { return write((const uint8_t*)s, size); }
+  virtual int availableForWrite()             { return 0; }
+  virtual void flush()                        {}
+
+  size_t print(const char* s)                 { return write(s); }
+  size_t print(const __FlashStringHelper* s)  { return write((const char*)s); }
+  size_t print(char c)                        { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(int v, int base = DEC)         { return print((long)v, base); }
+  size_t print(unsigned int v, int base = DEC){ return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC) {
+    char t[24];
+    snprintf(t, sizeof(t), base == HEX ? "%lX" : "%ld", v);
+    return write(t);
+  }
+  size_t print(unsigned long v, int base = DEC) {
+    char t[24];
+    snprintf(t, sizeof(t), base == HEX ? "%lX" : "%lu", v);
+    return write(t);
+  }
+  size_t print(double v, int digits = 2) {
+    char t[40];
+    snprintf(t, sizeof(t), "%.*f", digits, v);
+    return write(t);
+  }
+  size_t println()                            { return write("\r\n"); }
+  template <class T> size_t println(T v)      { size_t n = print(v); return n + println(); }
+  template <class T> size_t println(T v, int f) { size_t n = print(v, f); return n + println(); }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
+
+typedef void (*SimSerialSink)(uint8_t b, unsigned long long doneUs, void* context);
+
+// UART with a 63-byte TX ring. Bytes leave at 10 bits each (12 for 8E2)
+// in virtual time; write() into a full ring blocks and lets time run,
+// exactly the stall the firmware avoids with availableForWrite().
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(const char* name);
+
+  void   begin(unsigned long baud, uint8_t config = SERIAL_8N1);
+  void   end() {}
+  int    available();
+  int    read();
+  int    peek();
+  size_t write(uint8_t b);
+  using Print::write;
+  int    availableForWrite();
+  void   flush();
+  operator bool() { return true; }
+
+  // ----- Simulator side -----
+  const char* name() const { return _name; }
+  unsigned long baud() const { return _baud; }
+  void setSink(SimSerialSink sink, void* context) { _sink = sink; _sinkContext = context; }
+  void injectRx(const uint8_t* data, size_t size);   // Bytes appear in the RX buffer now
+  unsigned long long nextTxDoneUs() const;           // ~0 when idle
+  void serviceTx(unsigned long long now);            // Delivers every byte done by now
+
+  unsigned long      bytesSent;
+  unsigned long long busyUs;                         // Wire time of the bytes sent
+  unsigned long long blockedUs;                      // Time write()/flush() stalled the caller
+  unsigned long      blockedWrites;
+
+private:
+  const char*        _name;
+  unsigned long      _baud;
+  unsigned long      _byteUs;
+  SimSerialSink      _sink;
+  void*              _sinkContext;
+  uint8_t            _tx[SERIAL_TX_BUFFER_SIZE];
+  uint8_t            _txHead, _txCount;
+  bool               _shifting;
+  uint8_t            _shiftByte;
+  unsigned long long _shiftDoneUs;
+  uint8_t            _rx[256];
+  uint8_t            _rxHead, _rxCount;
+
+  void startNextByte(unsigned long long at);
+};
+
+extern HardwareSerial Serial, Serial1, Serial2, Serial3;
+
+#endif
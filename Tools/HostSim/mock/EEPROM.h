@@ -0,0 +1,49 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║           EEPROM.h (host mock) - Shadow-RC HostSim         ║
+  ║────────────────────────────────────────────────────────────║
+  ║ The Mega's 4 KB EEPROM, erased (0xFF) at the start of      ║
+  ║ every run. Same get / put / update calls as the core       ║
+  ║ library; put() only writes cells that change.              ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless the firmware starts using a new API.    ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef HOSTSIM_EEPROM_H
+#define HOSTSIM_EEPROM_H
+
+#include <Arduino.h>
+
+#define SIM_EEPROM_SIZE  4096
+
+class EEPROMClass {
+public:
+  EEPROMClass();
+
+  uint8_t  read(int address) const;
+  void     write(int address, uint8_t value);
+  void     update(int address, uint8_t value) { if (read(address) != value) write(address, value); }
+  uint16_t length() const { return SIM_EEPROM_SIZE; }
+
+  template <class T> T& get(int address, T &t) const {
+    uint8_t* p = (uint8_t*)&t;
+    for (size_t i = 0; i < sizeof(T); i++) p[i] = read(address + i);
+    return t;
+  }
+  template <class T> const T& put(int address, const T &t) {
+    const uint8_t* p = (const uint8_t*)&t;
+    for (size_t i = 0; i < sizeof(T); i++) update(address + i, p[i]);
+    return t;
+  }
+
+  // ----- Simulator side -----
+  unsigned long writes;           // Cells actually written (wear)
+
+private:
+  uint8_t _cells[SIM_EEPROM_SIZE];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
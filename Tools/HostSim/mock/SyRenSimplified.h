@@ -0,0 +1 @@
+// Host stub: the sketch only needs the Sabertooth library itself.
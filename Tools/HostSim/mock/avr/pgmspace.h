@@ -0,0 +1,34 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║        avr/pgmspace.h (host mock) - Shadow-RC HostSim      ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Flash tables on the Mega, plain constants here: PROGMEM    ║
+  ║ is empty and every _P / pgm_read_* call is a RAM read.     ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless the firmware starts using a new API.    ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef HOSTSIM_AVR_PGMSPACE_H
+#define HOSTSIM_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P               const char*
+#define PSTR(s)             (s)
+
+#define pgm_read_byte(p)    (*(const uint8_t*)(p))
+#define pgm_read_word(p)    (*(const uint16_t*)(p))
+#define pgm_read_dword(p)   (*(const uint32_t*)(p))
+#define pgm_read_ptr(p)     (*(const void* const*)(p))
+
+#define memcpy_P            memcpy
+#define strcpy_P            strcpy
+#define strncpy_P           strncpy
+#define strlen_P            strlen
+#define strcmp_P            strcmp
+#define strncmp_P           strncmp
+
+#endif
@@ -0,0 +1,26 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║         avr/sleep.h (host mock) - Shadow-RC HostSim        ║
+  ║────────────────────────────────────────────────────────────║
+  ║ The avr-libc sleep calls. `sleep_cpu()` moves virtual time ║
+  ║ to the next interrupt: the next simulated event, or the    ║
+  ║ next Timer0 overflow (every 1024 µs) if that comes first.  ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless the firmware starts using a new API.    ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef HOSTSIM_AVR_SLEEP_H
+#define HOSTSIM_AVR_SLEEP_H
+
+#include <Arduino.h>
+
+#define SLEEP_MODE_IDLE         0
+#define SLEEP_MODE_PWR_DOWN     2
+
+void set_sleep_mode(uint8_t mode);
+void sleep_enable();
+void sleep_disable();
+void sleep_cpu();
+
+#endif
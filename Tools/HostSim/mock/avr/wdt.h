@@ -0,0 +1,34 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║          avr/wdt.h (host mock) - Shadow-RC HostSim         ║
+  ║────────────────────────────────────────────────────────────║
+  ║ The avr-libc watchdog calls. The simulated watchdog runs   ║
+  ║ on virtual time: WDT_vect in interrupt mode, then a reset  ║
+  ║ the bench is told about (see simSetResetListener()).       ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless the firmware starts using a new API.    ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef HOSTSIM_AVR_WDT_H
+#define HOSTSIM_AVR_WDT_H
+
+#include <Arduino.h>
+
+// Timeout = 16 ms << value, as on the Mega's 128 kHz watchdog oscillator
+#define WDTO_15MS    0
+#define WDTO_30MS    1
+#define WDTO_60MS    2
+#define WDTO_120MS   3
+#define WDTO_250MS   4
+#define WDTO_500MS   5
+#define WDTO_1S      6
+#define WDTO_2S      7
+#define WDTO_4S      8
+#define WDTO_8S      9
+
+void wdt_enable(uint8_t timeout);   // System reset mode; WDIE is cleared
+void wdt_disable();
+void wdt_reset();
+
+#endif
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+"""
+Shadow-RC telemetry decoder.
+
+Reads the USB serial stream from the Mega (or a captured file), prints
+one line per binary telemetry frame and passes normal console text
+through untouched. Frame layout is documented in Telemetry.h.
+
+  python3 Tools/telemetry_decode.py /dev/ttyACM0          # live (needs pyserial)
+  python3 Tools/telemetry_decode.py capture.bin           # from a file
+  python3 Tools/telemetry_decode.py /dev/ttyACM0 --csv    # drive frames as CSV
+  python3 Tools/telemetry_decode.py /dev/ttyACM0 --trace walk.trace
+                                     # `trace on` input frames → replay file
+                                     # for Tools/HostSim/host_bench --replay
+
+May the Force be with you, Builder.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+FRAME_BYTES = 6          # sync(2) + type + length + seq + checksum
+
+TYPE_DRIVE = 0x01
+TYPE_EVENT = 0x02
+TYPE_INPUT = 0x03
+TYPE_DRIVER = 0x04
+
+FLAG_NAMES = ((0x01, "KILL"), (0x02, "MP3-OFF"), (0x04, "MP3-HELD"), (0x08, "LINK-LOST"))
+EVENT_NAMES = {1: "MP3 blocked", 2: "Mode", 3: "Kill switch", 4: "Link lost"}
+MODE_NAMES = {1: "MANUAL", 2: "AUTOMATED", 3: "HYBRID", 4: "CARPET"}
+CHANNEL_NAMES = ["CH%d%s" % (n, rx) for rx in "AB" for n in range(1, 7)]
+
+TRACE_HEADER = ("# Shadow-RC input trace v1\n"
+                "# time_us channel value  (channel 0-11 = CH1A..CH6B pulse width in us,\n"
+                "#                         0 = signal lost; E = encoder tick delta)\n")
+
+
+def open_source(path, baud):
+    if os.path.exists(path) and not path.startswith("/dev/") and not path.upper().startswith("COM"):
+        return open(path, "rb")
+    import serial  # pyserial
+    return serial.Serial(path, baud, timeout=0.1)
+
+
+def flags_text(flags):
+    names = [name for bit, name in FLAG_NAMES if flags & bit]
+    return ",".join(names) if names else "-"
+
+
+def format_drive(seq, payload, csv):
+    t, dr, do, tr, to, mr, mo, mode, combo, flags = struct.unpack("<IbbbbbbBBB", payload)
+    if csv:
+        return "%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d" % (t, seq, dr, do, tr, to, mr, mo, mode, combo, flags)
+    return ("%10d ms #%03d  Drive %4d→%4d | Turn %4d→%4d | Dome %4d→%4d | %-9s combo %2d | %s"
+            % (t, seq, dr, do, tr, to, mr, mo, MODE_NAMES.get(mode, mode), combo, flags_text(flags)))
+
+
+def format_event(seq, payload):
+    t, code, value = struct.unpack("<IBh", payload)
+    name = EVENT_NAMES.get(code, "Event %d" % code)
+    if code == 2:
+        value = MODE_NAMES.get(value, value)
+    return "%10d ms #%03d  ** %s: %s" % (t, seq, name, value)
+
+
+def format_driver(seq, payload):
+    t, batt, m1, m2, t1, t2, age, scale, ramp = struct.unpack("<IHhhbbHBB", payload)
+    age_text = "stale" if age == 0xFFFF else "%d ms" % age
+    return ("%10d ms #%03d  2x32 %5.1f V | M1 %5.1f A | M2 %5.1f A | %d/%d C | age %s | traction %d%% ramp %s"
+            % (t, seq, batt / 10.0, m1 / 10.0, m2 / 10.0, t1, t2, age_text, scale, ramp or "-"))
+
+
+def parse_input(payload):
+    t, encoder, count = struct.unpack_from("<IhB", payload)
+    entries = [struct.unpack_from("<BHH", payload, 7 + 5 * i) for i in range(count)]
+    return t, encoder, entries
+
+
+def format_input(seq, payload):
+    t, encoder, entries = parse_input(payload)
+    parts = ["%s %s" % (CHANNEL_NAMES[ch] if ch < len(CHANNEL_NAMES) else ch, width or "lost")
+             for ch, width, _ in entries]
+    if encoder:
+        parts.append("enc %+d" % encoder)
+    return "%10d us #%03d  in  %s" % (t, seq, " | ".join(parts))
+
+
+class TraceWriter:
+    """Writes input frames as a replay file with times relative to the first frame."""
+
+    def __init__(self, out):
+        self.out = out
+        self.out.write(TRACE_HEADER)
+        self.base = None
+        self.last = 0
+        self.wraps = 0
+        self.lines = 0
+
+    def add(self, payload):
+        t, encoder, entries = parse_input(payload)
+        if self.base is None:
+            self.base = t
+        elif t < self.last:
+            self.wraps += 1            # micros() rolls over every ~71 minutes
+        self.last = t
+        now = t + (self.wraps << 32) - self.base
+        for ch, width, age in entries:
+            self.out.write("%d %d %d\n" % (max(now - age, 0), ch, width))
+        if encoder:
+            self.out.write("%d E %d\n" % (now, encoder))
+        self.lines += len(entries) + (1 if encoder else 0)
+
+
+class Decoder:
+    def __init__(self, csv=False, out=sys.stdout, trace=None):
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.csv = csv
+        self.out = out
+        self.errors = 0
+        self.lost = 0
+        self.last_seq = None
+        self.trace = trace
+
+    def flush_text(self):
+        if self.text and not self.csv:
+            self.out.write(self.text.decode("utf-8", "replace"))
+        self.text.clear()
+
+    def feed(self, data):
+        self.buf.extend(data)
+        while True:
+            start = self.buf.find(SYNC)
+            if start < 0:
+                keep = 1 if self.buf.endswith(SYNC[:1]) else 0
+                self.text.extend(self.buf[:len(self.buf) - keep])
+                del self.buf[:len(self.buf) - keep]
+                break
+            self.text.extend(self.buf[:start])
+            del self.buf[:start]
+            if len(self.buf) < 4:
+                break
+            ftype, length = self.buf[2], self.buf[3]
+            total = length + FRAME_BYTES
+            if len(self.buf) < total:
+                break
+            frame = self.buf[:total]
+            body = frame[2:total - 1]
+            if sum(body) & 0xFF != frame[-1]:
+                # Not a frame (or corrupted): treat the sync byte as text and move on
+                self.errors += 1
+                self.text.extend(self.buf[:1])
+                del self.buf[:1]
+                continue
+            self.flush_text()
+            seq, payload = frame[4], bytes(frame[5:total - 1])
+            if self.last_seq is not None:
+                self.lost += (seq - self.last_seq - 1) & 0xFF
+            self.last_seq = seq
+            if ftype == TYPE_DRIVE and length == 13:
+                self.out.write(format_drive(seq, payload, self.csv) + "\n")
+            elif ftype == TYPE_EVENT and length == 7 and not self.csv:
+                self.out.write(format_event(seq, payload) + "\n")
+            elif ftype == TYPE_DRIVER and length == 16 and not self.csv:
+                self.out.write(format_driver(seq, payload) + "\n")
+            elif ftype == TYPE_INPUT and length >= 7 and (length - 7) % 5 == 0:
+                if self.trace:
+                    self.trace.add(payload)
+                if not self.csv:
+                    self.out.write(format_input(seq, payload) + "\n")
+            del self.buf[:total]
+        if b"\n" in self.text:
+            cut = self.text.rindex(b"\n") + 1
+            pending = self.text[cut:]
+            self.text = self.text[:cut]
+            self.flush_text()
+            self.text = pending
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decode Shadow-RC binary telemetry")
+    ap.add_argument("source", help="serial port (e.g. /dev/ttyACM0, COM5) or capture file")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--csv", action="store_true", help="drive frames only, as CSV")
+    ap.add_argument("--trace", metavar="FILE", help="write input frames as a HostSim replay file")
+    args = ap.parse_args()
+
+    trace_file = open(args.trace, "w") if args.trace else None
+    decoder = Decoder(csv=args.csv, trace=TraceWriter(trace_file) if trace_file else None)
+    if args.csv:
+        print("time_ms,seq,drive_raw,drive_out,turn_raw,turn_out,dome_raw,dome_out,mode,combo,flags")
+
+    src = open_source(args.source, args.baud)
+    is_file = not hasattr(src, "baudrate")
+    try:
+        while True:
+            data = src.read(256)
+            if not data:
+                if is_file:
+                    break
+                continue
+            decoder.feed(data)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        decoder.flush_text()
+        sys.stderr.write("[decoder] checksum errors: %d | frames lost (seq gaps): %d\n"
+                         % (decoder.errors, decoder.lost))
+        if trace_file:
+            trace_file.close()
+            sys.stderr.write("[decoder] %d trace lines → %s\n" % (decoder.trace.lines, args.trace))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,515 @@
+/*
+  ╔════════════════════════════════════════════════════════════════════╗
+  ║                  TuningStore.cpp - Shadow-RC System                ║
+  ║────────────────────────────────────────────────────────────────────║
+  ║ Stick calibration and live tuning, kept in EEPROM. Every mode     ║
+  ║ used to assume a perfect 1000–2000 µs stick centred on 1500, and  ║
+  ║ every tunable (`speedLimit`, `expoCurve`, ...) meant a reflash.   ║
+  ║────────────────────────────────────────────────────────────────────║
+
+  CALIBRATION (`cal`):
+  ─────────────────────────────────────────────────────────────────────
+  - `cal start` holds every motor at 0 (`setDriveHold()`; Hybrid
+    Mode treats it like the kill switch) and records the lowest and
+    highest pulse seen on CH1A (turn), CH2A (drive) and CH1B (dome).
+  - Sweep each stick to both ends, let go, then `cal save`: the
+    sticks' resting pulses become the centres. An axis that moved
+    less than `TUNING_CAL_MIN_THROW_US` either side is refused and the
+    sweep goes on. `cal abort` keeps the old calibration.
+  - Saved axes go to `setStickCalibration()`, which builds the integer
+    slopes once. The tick does one compare, one multiply and one shift
+    per stick: less than the old constrain() + map(), and the per-file
+    dome left / right gains are folded into the dome slopes.
+  - `cal` prints the calibration, `cal reset` goes back to 1000 /
+    1500 / 2000. Either way each stick must be centred before it
+    drives again.
+
+  LIVE TUNING (`tune`):
+  ─────────────────────────────────────────────────────────────────────
+  - `tune` lists the active profile's settings, `tune speed 30` (or
+    expo, deadzone, taper, domespeed, domedead, domeleft, domeright)
+    changes one. Out-of-range values are refused.
+  - Dead zones, taper and gains take effect on the next tick. A new
+    `expo` or speed limit rebuilds the response table into a spare,
+    `TUNING_CURVE_ROWS_PER_PASS` rows per console pass, then swaps the
+    profile's table pointer: the tick never sees a half-built table
+    and never waits on 128 pow() calls.
+  - `tune save` stores every profile; `tune defaults` erases the
+    record, so the next boot runs the settings compiled into the mode
+    files.
+
+  EEPROM:
+  ─────────────────────────────────────────────────────────────────────
+  - One record at `TUNING_EEPROM_ADDRESS`: calibration for 3 sticks and
+    a `ProfileTuning` per drive profile, with a layout number and a
+    checksum. A blank, old or torn record is ignored at boot.
+  - A byte write takes ~3.3 ms. Saving writes at most one changed byte
+    per console pass and lets the EEPROM finish it in the background,
+    so the control tick (and the watchdog) never waits on it.
+
+  FILE LOCATION:
+  ─────────────────────────────────────────────────────────────────────
+  This file: `TuningStore.cpp`
+  Header:    `TuningStore.h`
+  Profiles:  `ManualMode.cpp`, `CarpetMode.cpp`, `HybridMode.cpp`
+
+  May the Force be with you, Builder.
+  ╚════════════════════════════════════════════════════════════════════╝
+*/
+
+#include "TuningStore.h"
+#include "PWMInputHandler.h"
+#include "ManualMode.h"
+#include "CarpetMode.h"
+#include "HybridMode.h"
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stddef.h>
+
+#define TUNING_MAGIC  0x5455      // "TU"
+
+struct TuningRecord {
+  uint16_t         magic;
+  uint8_t          layout;
+  uint8_t          checksum;      // Sum of every byte after the header
+  StickCalibration stick[STICK_AXIS_COUNT];
+  ProfileTuning    profile[TUNING_PROFILE_COUNT];
+};
+
+// Record order; the name is what `tune` prints
+static DriveProfile* const profiles[TUNING_PROFILE_COUNT] = {
+  &manualProfile, &carpetProfile, &hybridProfile
+};
+
+// What is live (or being built) and what `save` writes
+static TuningRecord record;
+
+// ==========================
+//       TUNE PARAMETERS
+// ==========================
+enum TuneKind { TUNE_INT, TUNE_FLOAT, TUNE_GAIN };
+
+#define CURVE_DRIVE  0x01
+#define CURVE_DOME   0x02
+
+struct TuneParam {
+  PGM_P       name;
+  uint8_t     kind;
+  uint8_t     offset;        // Into ProfileTuning
+  uint8_t     curves;        // Response tables a change rebuilds
+  bool        domeOnly;      // Profiles with a dome table only
+  float       minValue;
+  float       maxValue;
+};
+
+static const char nameExpo[]      PROGMEM = "expo";
+static const char nameSpeed[]     PROGMEM = "speed";
+static const char nameDeadZone[]  PROGMEM = "deadzone";
+static const char nameTaper[]     PROGMEM = "taper";
+static const char nameDomeSpeed[] PROGMEM = "domespeed";
+static const char nameDomeDead[]  PROGMEM = "domedead";
+static const char nameDomeLeft[]  PROGMEM = "domeleft";
+static const char nameDomeRight[] PROGMEM = "domeright";
+
+static const TuneParam params[] PROGMEM = {
+  { nameExpo,      TUNE_FLOAT, offsetof(ProfileTuning, expoCurve),      CURVE_DRIVE | CURVE_DOME, false, 0.2,  5.0 },
+  { nameSpeed,     TUNE_INT,   offsetof(ProfileTuning, speedLimit),     CURVE_DRIVE,              false, 0,    127 },
+  { nameDeadZone,  TUNE_INT,   offsetof(ProfileTuning, deadZone),       0,                        false, 0,    50 },
+  { nameTaper,     TUNE_INT,   offsetof(ProfileTuning, taperFallRate),  0,                        false, 1,    127 },
+  { nameDomeSpeed, TUNE_INT,   offsetof(ProfileTuning, domeSpeedLimit), CURVE_DOME,               true,  0,    100 },
+  { nameDomeDead,  TUNE_INT,   offsetof(ProfileTuning, domeDeadZone),   0,                        true,  0,    50 },
+  { nameDomeLeft,  TUNE_GAIN,  offsetof(ProfileTuning, domeLeftGain),   0,                        true,  0.25, 4.0 },
+  { nameDomeRight, TUNE_GAIN,  offsetof(ProfileTuning, domeRightGain),  0,                        true,  0.25, 4.0 },
+};
+
+#define TUNE_PARAM_COUNT  (sizeof(params) / sizeof(params[0]))
+
+// Rows live in flash: copy one out before using it
+static void readParam(uint8_t i, TuneParam &p) {
+  memcpy_P(&p, &params[i], sizeof(p));
+}
+
+static float getParam(const ProfileTuning &t, const TuneParam &p) {
+  const uint8_t* field = (const uint8_t*)&t + p.offset;
+  if (p.kind == TUNE_FLOAT) return *(const float*)field;
+  if (p.kind == TUNE_GAIN)  return *(const q8_8_t*)field / (float)Q8_8_ONE;
+  return *(const int16_t*)field;
+}
+
+static void setParam(ProfileTuning &t, const TuneParam &p, float value) {
+  uint8_t* field = (uint8_t*)&t + p.offset;
+  if (p.kind == TUNE_FLOAT)     *(float*)field   = value;
+  else if (p.kind == TUNE_GAIN) *(q8_8_t*)field  = (q8_8_t)(value * Q8_8_ONE + 0.5);
+  else                          *(int16_t*)field = (int16_t)(value + 0.5);
+}
+
+static bool inRange(const TuneParam &p, float value) {
+  return value >= p.minValue && value <= p.maxValue;   // Also false for NaN
+}
+
+static bool validTuning(const ProfileTuning &t) {
+  TuneParam p;
+  for (uint8_t i = 0; i < TUNE_PARAM_COUNT; i++) {
+    readParam(i, p);
+    if (!inRange(p, getParam(t, p))) return false;
+  }
+  return true;
+}
+
+static bool validCalibration(const StickCalibration &c) {
+  return c.minUs >= PWM_PULSE_MIN_US && c.maxUs <= PWM_PULSE_MAX_US &&
+         c.centerUs - c.minUs >= TUNING_CAL_MIN_THROW_US &&
+         c.maxUs - c.centerUs >= TUNING_CAL_MIN_THROW_US;
+}
+
+// ==========================
+//     RESPONSE TABLES
+// ==========================
+// One spare table; a finished build swaps places with the profile's
+static ResponseCurve  spareStorage(1.0, 0);
+static ResponseCurve* spare = &spareStorage;
+
+static uint8_t curveDirty = 0;            // Bit (profile * 2 + dome) = table needs a rebuild
+static int8_t  buildSlot = -1;            // Table being built into the spare, -1 = none
+static uint8_t buildRow = 0;
+
+static void markCurves(uint8_t profile, uint8_t curves) {
+  if (curves & CURVE_DRIVE) curveDirty |= 1 << (profile * 2);
+  if ((curves & CURVE_DOME) && profiles[profile]->domeCurve) curveDirty |= 1 << (profile * 2 + 1);
+
+  // A build for a table that just changed again starts over
+  if (buildSlot >= 0 && (curveDirty & (1 << buildSlot))) buildSlot = -1;
+}
+
+static void updateCurveBuild() {
+  if (buildSlot < 0) {
+    if (!curveDirty) return;
+    for (buildSlot = 0; !(curveDirty & (1 << buildSlot)); buildSlot++) {}
+    curveDirty &= ~(1 << buildSlot);
+    buildRow = 0;
+
+    const ProfileTuning &t = record.profile[buildSlot / 2];
+    spare->curve = t.expoCurve;
+    spare->limit = constrain(buildSlot & 1 ? t.domeSpeedLimit : t.speedLimit, 0, 255);
+  }
+
+  uint8_t end = min(buildRow + TUNING_CURVE_ROWS_PER_PASS, RESPONSE_CURVE_SIZE);
+  for (; buildRow < end; buildRow++) {
+    spare->table[buildRow] = responseCurveEntry(spare->curve, spare->limit, buildRow);
+  }
+  if (buildRow < RESPONSE_CURVE_SIZE) return;
+
+  // Whole table done: one pointer swap, between two ticks
+  DriveProfile* p = profiles[buildSlot / 2];
+  ResponseCurve* &slot = (buildSlot & 1) ? p->domeCurve : p->driveCurve;
+  ResponseCurve* old = slot;
+  slot = spare;
+  spare = old;
+  buildSlot = -1;
+}
+
+// ==========================
+//          EEPROM
+// ==========================
+static int saveCursor = -1;               // Next record byte to compare / write, -1 = idle
+
+static uint8_t recordChecksum(const TuningRecord &r) {
+  const uint8_t* bytes = (const uint8_t*)&r;
+  uint8_t sum = 0;
+  for (size_t i = offsetof(TuningRecord, stick); i < sizeof(r); i++) sum += bytes[i];
+  return sum;
+}
+
+static void saveRecord() {
+  record.magic    = TUNING_MAGIC;
+  record.layout   = TUNING_LAYOUT;
+  record.checksum = recordChecksum(record);
+  saveCursor = 0;                         // Restarts a save still in progress
+}
+
+// At most one changed byte per pass: the EEPROM finishes it before the next
+static void updateSave() {
+  if (saveCursor < 0) return;
+  const uint8_t* bytes = (const uint8_t*)&record;
+
+  while (saveCursor < (int)sizeof(record)) {
+    int i = saveCursor++;
+    if (EEPROM.read(TUNING_EEPROM_ADDRESS + i) != bytes[i]) {
+      EEPROM.write(TUNING_EEPROM_ADDRESS + i, bytes[i]);
+      return;
+    }
+  }
+  saveCursor = -1;
+  Serial.println(F("[TUNING] Saved to EEPROM."));
+}
+
+// ==========================
+//           SETUP
+// ==========================
+void setupTuningStore() {
+  for (uint8_t a = 0; a < STICK_AXIS_COUNT; a++) record.stick[a] = getStickCalibration(a);
+  for (uint8_t i = 0; i < TUNING_PROFILE_COUNT; i++) readProfileTuning(*profiles[i], record.profile[i]);
+
+  TuningRecord stored;
+  EEPROM.get(TUNING_EEPROM_ADDRESS, stored);
+  if (stored.magic != TUNING_MAGIC || stored.layout != TUNING_LAYOUT ||
+      stored.checksum != recordChecksum(stored)) {
+    return;                               // Nothing saved: the compiled settings
+  }
+
+  for (uint8_t a = 0; a < STICK_AXIS_COUNT; a++) {
+    if (!validCalibration(stored.stick[a])) continue;
+    record.stick[a] = stored.stick[a];
+    setStickCalibration(a, stored.stick[a]);
+  }
+
+  // Before the control tick starts: the tables are rebuilt in place
+  for (uint8_t i = 0; i < TUNING_PROFILE_COUNT; i++) {
+    if (!validTuning(stored.profile[i])) continue;
+    DriveProfile &p = *profiles[i];
+    const ProfileTuning &t = stored.profile[i];
+    record.profile[i] = t;
+    writeProfileTuning(p, t);
+    setResponseCurve(*p.driveCurve, t.expoCurve, t.speedLimit);
+    if (p.domeCurve) setResponseCurve(*p.domeCurve, t.expoCurve, t.domeSpeedLimit);
+  }
+  Serial.println(F("[TUNING] Calibration + tuning loaded from EEPROM."));
+}
+
+// ==========================
+//        CALIBRATION
+// ==========================
+static const PWMChannel axisChannel[STICK_AXIS_COUNT] = { PWM_CH1A, PWM_CH2A, PWM_CH1B };
+static const char axisTurn[]  PROGMEM = "turn";
+static const char axisDrive[] PROGMEM = "drive";
+static const char axisDome[]  PROGMEM = "dome";
+
+static const char* const axisNames[STICK_AXIS_COUNT] PROGMEM = { axisTurn, axisDrive, axisDome };
+
+static const __FlashStringHelper* axisName(uint8_t axis) {
+  return (const __FlashStringHelper*)pgm_read_ptr(&axisNames[axis]);
+}
+
+static bool sweeping = false;
+static StickCalibration sweep[STICK_AXIS_COUNT];   // min / max seen so far
+
+static void updateSweep() {
+  if (!sweeping) return;
+  for (uint8_t a = 0; a < STICK_AXIS_COUNT; a++) {
+    if (!inputFrame.valid[axisChannel[a]]) continue;
+    int width = inputFrame.width[axisChannel[a]];
+    if (width < sweep[a].minUs) sweep[a].minUs = width;
+    if (width > sweep[a].maxUs) sweep[a].maxUs = width;
+  }
+}
+
+static void startSweep() {
+  for (uint8_t a = 0; a < STICK_AXIS_COUNT; a++) {
+    sweep[a].minUs = sweep[a].maxUs = STICK_DEFAULT_CENTER_US;
+  }
+  sweeping = true;
+  setDriveHold(true);
+  Serial.println(F("[CAL] Motors held. Move each stick to both ends,"));
+  Serial.println(F("[CAL] let go, then `cal save` (`cal abort` to quit)."));
+}
+
+static void finishSweep() {
+  updateSweep();
+  bool ok = true;
+  for (uint8_t a = 0; a < STICK_AXIS_COUNT; a++) {
+    sweep[a].centerUs = inputFrame.valid[axisChannel[a]] ? inputFrame.width[axisChannel[a]] : 0;
+    if (!validCalibration(sweep[a])) {
+      Serial.print(F("[CAL] Not enough travel on "));
+      Serial.println(axisName(a));
+      ok = false;
+    }
+  }
+  if (!ok) return;                        // Still sweeping: move it further and save again
+
+  for (uint8_t a = 0; a < STICK_AXIS_COUNT; a++) {
+    record.stick[a] = sweep[a];
+    setStickCalibration(a, sweep[a]);
+  }
+  sweeping = false;
+  setDriveHold(false);
+  saveRecord();
+}
+
+static void stopSweep() {
+  sweeping = false;
+  setDriveHold(false);
+  Serial.println(F("[CAL] Aborted, calibration unchanged."));
+}
+
+// ==========================
+//   REPLIES (row at a time)
+// ==========================
+#define REPLY_IDLE  0xFF
+
+enum ReplyKind { REPLY_CAL, REPLY_TUNE };
+
+static uint8_t replyKind = REPLY_CAL;
+static uint8_t replyRow = REPLY_IDLE;
+
+static void startReply(uint8_t kind) {
+  replyKind = kind;
+  replyRow = 0;
+}
+
+// "turn: 1004 / 1498 / 1996 us"
+static bool printCalRow(uint8_t row) {
+  if (row == 0) {
+    Serial.println(sweeping ? F("=== Stick Calibration (sweeping) ===") : F("=== Stick Calibration ==="));
+    return true;
+  }
+  if (row > STICK_AXIS_COUNT) return false;
+  const StickCalibration &c = getStickCalibration(row - 1);
+  Serial.print(axisName(row - 1));
+  Serial.print(F(": "));
+  Serial.print(c.minUs);
+  Serial.print(F(" / "));
+  Serial.print(c.centerUs);
+  Serial.print(F(" / "));
+  Serial.print(c.maxUs);
+  Serial.println(F(" us"));
+  return true;
+}
+
+static int8_t activeProfileIndex() {
+  for (uint8_t i = 0; i < TUNING_PROFILE_COUNT; i++) {
+    if (profiles[i] == activeDriveProfile()) return i;
+  }
+  return -1;
+}
+
+// "speed: 25"
+static bool printTuneRow(uint8_t row) {
+  int8_t index = activeProfileIndex();
+  if (index < 0) return false;
+  if (row == 0) {
+    Serial.print(F("=== Tune: "));
+    Serial.print(profiles[index]->name);
+    Serial.println(F(" ==="));
+    return true;
+  }
+
+  // Skip the dome rows on a profile without a dome table
+  TuneParam p;
+  uint8_t i = row - 1;
+  for (; i < TUNE_PARAM_COUNT; i++) {
+    readParam(i, p);
+    if (!p.domeOnly || profiles[index]->domeCurve) break;
+  }
+  if (i >= TUNE_PARAM_COUNT) return false;
+  replyRow = i + 1;
+
+  Serial.print((const __FlashStringHelper*)p.name);
+  Serial.print(F(": "));
+  Serial.println(getParam(record.profile[index], p), p.kind == TUNE_INT ? 0 : 2);
+  return true;
+}
+
+static void updateReply() {
+  if (replyRow == REPLY_IDLE) return;
+  if (Serial.availableForWrite() < SERIAL_TX_BUFFER_SIZE - 1) return;   // Wait for an empty buffer
+
+  bool more = replyKind == REPLY_CAL ? printCalRow(replyRow) : printTuneRow(replyRow);
+  replyRow = more ? replyRow + 1 : REPLY_IDLE;
+}
+
+// ==========================
+//       CONSOLE TASK
+// ==========================
+void updateTuningStore() {
+  updateSweep();
+  updateCurveBuild();
+  updateSave();
+  updateReply();
+}
+
+// ==========================
+//     CONSOLE COMMANDS
+// ==========================
+void calCommand(const char* args) {
+  if (!strcmp(args, "start")) {
+    startSweep();
+  } else if (!strcmp(args, "save")) {
+    if (sweeping) finishSweep();
+    else Serial.println(F("[CAL] `cal start` first."));
+  } else if (!strcmp(args, "abort")) {
+    if (sweeping) stopSweep();
+  } else if (!strcmp(args, "reset")) {
+    if (sweeping) stopSweep();
+    for (uint8_t a = 0; a < STICK_AXIS_COUNT; a++) {
+      StickCalibration c = { STICK_DEFAULT_MIN_US, STICK_DEFAULT_CENTER_US, STICK_DEFAULT_MAX_US };
+      record.stick[a] = c;
+      setStickCalibration(a, c);
+    }
+    setDriveHold(false);                  // Re-centre the sticks on the new ranges
+    saveRecord();
+  } else {
+    startReply(REPLY_CAL);
+  }
+}
+
+void tuneCommand(const char* args) {
+  if (!strcmp(args, "save")) {
+    saveRecord();
+    return;
+  }
+  if (!strcmp(args, "defaults")) {
+    saveCursor = -1;
+    EEPROM.update(TUNING_EEPROM_ADDRESS, 0xFF);   // Breaks the magic: one byte, no wait
+    Serial.println(F("[TUNING] Cleared. Compiled settings + calibration after a reset."));
+    return;
+  }
+
+  int8_t index = activeProfileIndex();
+  if (index < 0) {
+    Serial.println(F("[TUNING] No drive profile in this mode."));
+    return;
+  }
+  if (*args == '\0') {
+    startReply(REPLY_TUNE);
+    return;
+  }
+
+  const char* value = strchr(args, ' ');
+  size_t nameLength = value ? (size_t)(value - args) : strlen(args);
+  TuneParam p;
+  bool found = false;
+  for (uint8_t i = 0; i < TUNE_PARAM_COUNT && !found; i++) {
+    readParam(i, p);
+    found = strlen_P(p.name) == nameLength && !strncmp_P(args, p.name, nameLength);
+  }
+  if (!found) {
+    Serial.print(F("[TUNING] Unknown setting: "));
+    Serial.println(args);
+    return;
+  }
+
+  DriveProfile &profile = *profiles[index];
+  float v = value ? atof(value + 1) : NAN;
+  if (p.domeOnly && !profile.domeCurve) {
+    Serial.println(F("[TUNING] This profile has no dome stick."));
+    return;
+  }
+  if (!inRange(p, v)) {
+    Serial.print(F("[TUNING] Range: "));
+    Serial.print(p.minValue, p.kind == TUNE_INT ? 0 : 2);
+    Serial.print(F(" - "));
+    Serial.println(p.maxValue, p.kind == TUNE_INT ? 0 : 2);
+    return;
+  }
+
+  ProfileTuning &t = record.profile[index];
+  setParam(t, p, v);
+  writeProfileTuning(profile, t);         // Everything but the tables, from the next tick
+  markCurves(index, p.curves);
+
+  Serial.print(F("[TUNING] "));
+  Serial.print((const __FlashStringHelper*)p.name);
+  Serial.print(F(" = "));
+  Serial.print(getParam(t, p), p.kind == TUNE_INT ? 0 : 2);
+  Serial.println(p.curves ? F(" (table rebuilding, `tune save` to keep)") : F(" (`tune save` to keep)"));
+}
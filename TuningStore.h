@@ -0,0 +1,40 @@
+/*
+  ╔════════════════════════════════════════════════════════════╗
+  ║                 TuningStore.h - Shadow-RC                  ║
+  ║────────────────────────────────────────────────────────────║
+  ║ Header for stick calibration and live profile tuning.      ║
+  ║ `cal` measures each stick's real min / centre / max,       ║
+  ║ `tune` changes a profile without a reflash; both are kept  ║
+  ║ in EEPROM and loaded at boot.                              ║
+  ║                                                            ║
+  ║ DO NOT EDIT unless you also bump TUNING_LAYOUT.            ║
+  ╚════════════════════════════════════════════════════════════╝
+*/
+
+#ifndef TUNING_STORE_H
+#define TUNING_STORE_H
+
+#include <Arduino.h>
+#include "DriveController.h"
+
+// ---------- EEPROM Record ----------
+// After the reset counters (Failsafe.h, bytes 0–9); ~80 bytes
+#define TUNING_EEPROM_ADDRESS      16
+#define TUNING_LAYOUT              1     // Bump when StickCalibration / ProfileTuning change
+#define TUNING_PROFILE_COUNT       3     // Manual, Carpet, Hybrid (record order)
+
+// ---------- Calibration ----------
+#define TUNING_CAL_MIN_THROW_US    200   // Each side of centre must travel at least this far
+
+// ---------- Background Work (console task) ----------
+#define TUNING_CURVE_ROWS_PER_PASS 8     // Response table rows per pass (~1.5 ms of pow())
+
+// ---------- Setup & Loop ----------
+void setupTuningStore();         // setup(), before the mode's setup: loads EEPROM
+void updateTuningStore();        // Console task: sweep, table rebuilds, EEPROM writes, replies
+
+// ---------- Console Commands ----------
+void calCommand(const char* args);    // cal [start | save | abort | reset]
+void tuneCommand(const char* args);   // tune [<name> <value> | save | defaults]
+
+#endif